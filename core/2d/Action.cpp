@@ -38,7 +38,15 @@ NS_AX_BEGIN
 // Action Base Class
 //
 
-Action::Action() : _originalTarget(nullptr), _target(nullptr), _tag(Action::INVALID_TAG), _flags(0) {}
+Action::Action()
+    : _originalTarget(nullptr)
+    , _target(nullptr)
+    , _tag(Action::INVALID_TAG)
+    , _flags(0)
+    , _tweenBatch(nullptr)
+    , _tweenLane(-1)
+    , _tweenIndex(-1)
+{}
 
 Action::~Action()
 {
@@ -36,6 +36,7 @@ THE SOFTWARE.
 NS_AX_BEGIN
 
 class Node;
+class TweenBatch;
 
 enum
 {
@@ -178,6 +179,12 @@ protected:
     int _tag;
     /** The action flag field. To categorize action into certain groups.*/
     unsigned int _flags;
+    /** The TweenBatch stepping the action, and the slot of the action in it. */
+    TweenBatch* _tweenBatch;
+    int _tweenLane;
+    int _tweenIndex;
+
+    friend class TweenBatch;
 
 private:
     AX_DISALLOW_COPY_AND_ASSIGN(Action);
@@ -135,52 +135,62 @@ bool EaseRateAction::initWithAction(ActionInterval* action, float rate)
 // NOTE: Converting these macros into Templates is desirable, but please see
 // issue #16159 [https://github.com/cocos2d/cocos2d-x/pull/16159] for further info
 //
-#define EASE_TEMPLATE_IMPL(CLASSNAME, TWEEN_FUNC, REVERSE_CLASSNAME)         \
-    CLASSNAME* CLASSNAME::create(ax::ActionInterval* action)            \
-    {                                                                        \
-        CLASSNAME* ease = new CLASSNAME();                                   \
-        if (ease->initWithAction(action))                                    \
-            ease->autorelease();                                             \
-        else                                                                 \
-            AX_SAFE_DELETE(ease);                                            \
-        return ease;                                                         \
-    }                                                                        \
-    CLASSNAME* CLASSNAME::clone() const                                      \
-    {                                                                        \
-        if (_inner)                                                          \
-            return CLASSNAME::create(_inner->clone());                       \
-        return nullptr;                                                      \
-    }                                                                        \
-    void CLASSNAME::update(float time) { _inner->update(TWEEN_FUNC(time)); } \
-    ActionEase* CLASSNAME::reverse() const { return REVERSE_CLASSNAME::create(_inner->reverse()); }
-
-EASE_TEMPLATE_IMPL(EaseExponentialIn, tweenfunc::expoEaseIn, EaseExponentialOut);
-EASE_TEMPLATE_IMPL(EaseExponentialOut, tweenfunc::expoEaseOut, EaseExponentialIn);
-EASE_TEMPLATE_IMPL(EaseExponentialInOut, tweenfunc::expoEaseInOut, EaseExponentialInOut);
-EASE_TEMPLATE_IMPL(EaseSineIn, tweenfunc::sineEaseIn, EaseSineOut);
-EASE_TEMPLATE_IMPL(EaseSineOut, tweenfunc::sineEaseOut, EaseSineIn);
-EASE_TEMPLATE_IMPL(EaseSineInOut, tweenfunc::sineEaseInOut, EaseSineInOut);
-EASE_TEMPLATE_IMPL(EaseBounceIn, tweenfunc::bounceEaseIn, EaseBounceOut);
-EASE_TEMPLATE_IMPL(EaseBounceOut, tweenfunc::bounceEaseOut, EaseBounceIn);
-EASE_TEMPLATE_IMPL(EaseBounceInOut, tweenfunc::bounceEaseInOut, EaseBounceInOut);
-EASE_TEMPLATE_IMPL(EaseBackIn, tweenfunc::backEaseIn, EaseBackOut);
-EASE_TEMPLATE_IMPL(EaseBackOut, tweenfunc::backEaseOut, EaseBackIn);
-EASE_TEMPLATE_IMPL(EaseBackInOut, tweenfunc::backEaseInOut, EaseBackInOut);
-EASE_TEMPLATE_IMPL(EaseQuadraticActionIn, tweenfunc::quadraticIn, EaseQuadraticActionIn);
-EASE_TEMPLATE_IMPL(EaseQuadraticActionOut, tweenfunc::quadraticOut, EaseQuadraticActionOut);
-EASE_TEMPLATE_IMPL(EaseQuadraticActionInOut, tweenfunc::quadraticInOut, EaseQuadraticActionInOut);
-EASE_TEMPLATE_IMPL(EaseQuarticActionIn, tweenfunc::quartEaseIn, EaseQuarticActionIn);
-EASE_TEMPLATE_IMPL(EaseQuarticActionOut, tweenfunc::quartEaseOut, EaseQuarticActionOut);
-EASE_TEMPLATE_IMPL(EaseQuarticActionInOut, tweenfunc::quartEaseInOut, EaseQuarticActionInOut);
-EASE_TEMPLATE_IMPL(EaseQuinticActionIn, tweenfunc::quintEaseIn, EaseQuinticActionIn);
-EASE_TEMPLATE_IMPL(EaseQuinticActionOut, tweenfunc::quintEaseOut, EaseQuinticActionOut);
-EASE_TEMPLATE_IMPL(EaseQuinticActionInOut, tweenfunc::quintEaseInOut, EaseQuinticActionInOut);
-EASE_TEMPLATE_IMPL(EaseCircleActionIn, tweenfunc::circEaseIn, EaseCircleActionIn);
-EASE_TEMPLATE_IMPL(EaseCircleActionOut, tweenfunc::circEaseOut, EaseCircleActionOut);
-EASE_TEMPLATE_IMPL(EaseCircleActionInOut, tweenfunc::circEaseInOut, EaseCircleActionInOut);
-EASE_TEMPLATE_IMPL(EaseCubicActionIn, tweenfunc::cubicEaseIn, EaseCubicActionIn);
-EASE_TEMPLATE_IMPL(EaseCubicActionOut, tweenfunc::cubicEaseOut, EaseCubicActionOut);
-EASE_TEMPLATE_IMPL(EaseCubicActionInOut, tweenfunc::cubicEaseInOut, EaseCubicActionInOut);
+#define EASE_TEMPLATE_IMPL(CLASSNAME, TWEEN_FUNC, REVERSE_CLASSNAME, TWEEN_TYPE)                    \
+    CLASSNAME* CLASSNAME::create(ax::ActionInterval* action)                                        \
+    {                                                                                               \
+        CLASSNAME* ease = new CLASSNAME();                                                          \
+        if (ease->initWithAction(action))                                                           \
+            ease->autorelease();                                                                    \
+        else                                                                                        \
+            AX_SAFE_DELETE(ease);                                                                   \
+        return ease;                                                                                \
+    }                                                                                               \
+    CLASSNAME* CLASSNAME::clone() const                                                             \
+    {                                                                                               \
+        if (_inner)                                                                                 \
+            return CLASSNAME::create(_inner->clone());                                              \
+        return nullptr;                                                                             \
+    }                                                                                               \
+    void CLASSNAME::update(float time) { _inner->update(TWEEN_FUNC(time)); }                        \
+    ActionEase* CLASSNAME::reverse() const { return REVERSE_CLASSNAME::create(_inner->reverse()); } \
+    tweenfunc::TweenType CLASSNAME::getTweenType() const { return TWEEN_TYPE; }
+
+EASE_TEMPLATE_IMPL(EaseExponentialIn, tweenfunc::expoEaseIn, EaseExponentialOut, tweenfunc::Expo_EaseIn);
+EASE_TEMPLATE_IMPL(EaseExponentialOut, tweenfunc::expoEaseOut, EaseExponentialIn, tweenfunc::Expo_EaseOut);
+EASE_TEMPLATE_IMPL(EaseExponentialInOut, tweenfunc::expoEaseInOut, EaseExponentialInOut, tweenfunc::Expo_EaseInOut);
+EASE_TEMPLATE_IMPL(EaseSineIn, tweenfunc::sineEaseIn, EaseSineOut, tweenfunc::Sine_EaseIn);
+EASE_TEMPLATE_IMPL(EaseSineOut, tweenfunc::sineEaseOut, EaseSineIn, tweenfunc::Sine_EaseOut);
+EASE_TEMPLATE_IMPL(EaseSineInOut, tweenfunc::sineEaseInOut, EaseSineInOut, tweenfunc::Sine_EaseInOut);
+EASE_TEMPLATE_IMPL(EaseBounceIn, tweenfunc::bounceEaseIn, EaseBounceOut, tweenfunc::Bounce_EaseIn);
+EASE_TEMPLATE_IMPL(EaseBounceOut, tweenfunc::bounceEaseOut, EaseBounceIn, tweenfunc::Bounce_EaseOut);
+EASE_TEMPLATE_IMPL(EaseBounceInOut, tweenfunc::bounceEaseInOut, EaseBounceInOut, tweenfunc::Bounce_EaseInOut);
+EASE_TEMPLATE_IMPL(EaseBackIn, tweenfunc::backEaseIn, EaseBackOut, tweenfunc::Back_EaseIn);
+EASE_TEMPLATE_IMPL(EaseBackOut, tweenfunc::backEaseOut, EaseBackIn, tweenfunc::Back_EaseOut);
+EASE_TEMPLATE_IMPL(EaseBackInOut, tweenfunc::backEaseInOut, EaseBackInOut, tweenfunc::Back_EaseInOut);
+EASE_TEMPLATE_IMPL(EaseQuadraticActionIn, tweenfunc::quadraticIn, EaseQuadraticActionIn, tweenfunc::Quad_EaseIn);
+EASE_TEMPLATE_IMPL(EaseQuadraticActionOut, tweenfunc::quadraticOut, EaseQuadraticActionOut, tweenfunc::Quad_EaseOut);
+EASE_TEMPLATE_IMPL(EaseQuadraticActionInOut,
+                   tweenfunc::quadraticInOut,
+                   EaseQuadraticActionInOut,
+                   tweenfunc::Quad_EaseInOut);
+EASE_TEMPLATE_IMPL(EaseQuarticActionIn, tweenfunc::quartEaseIn, EaseQuarticActionIn, tweenfunc::Quart_EaseIn);
+EASE_TEMPLATE_IMPL(EaseQuarticActionOut, tweenfunc::quartEaseOut, EaseQuarticActionOut, tweenfunc::Quart_EaseOut);
+EASE_TEMPLATE_IMPL(EaseQuarticActionInOut,
+                   tweenfunc::quartEaseInOut,
+                   EaseQuarticActionInOut,
+                   tweenfunc::Quart_EaseInOut);
+EASE_TEMPLATE_IMPL(EaseQuinticActionIn, tweenfunc::quintEaseIn, EaseQuinticActionIn, tweenfunc::Quint_EaseIn);
+EASE_TEMPLATE_IMPL(EaseQuinticActionOut, tweenfunc::quintEaseOut, EaseQuinticActionOut, tweenfunc::Quint_EaseOut);
+EASE_TEMPLATE_IMPL(EaseQuinticActionInOut,
+                   tweenfunc::quintEaseInOut,
+                   EaseQuinticActionInOut,
+                   tweenfunc::Quint_EaseInOut);
+EASE_TEMPLATE_IMPL(EaseCircleActionIn, tweenfunc::circEaseIn, EaseCircleActionIn, tweenfunc::Circ_EaseIn);
+EASE_TEMPLATE_IMPL(EaseCircleActionOut, tweenfunc::circEaseOut, EaseCircleActionOut, tweenfunc::Circ_EaseOut);
+EASE_TEMPLATE_IMPL(EaseCircleActionInOut, tweenfunc::circEaseInOut, EaseCircleActionInOut, tweenfunc::Circ_EaseInOut);
+EASE_TEMPLATE_IMPL(EaseCubicActionIn, tweenfunc::cubicEaseIn, EaseCubicActionIn, tweenfunc::Cubic_EaseIn);
+EASE_TEMPLATE_IMPL(EaseCubicActionOut, tweenfunc::cubicEaseOut, EaseCubicActionOut, tweenfunc::Cubic_EaseOut);
+EASE_TEMPLATE_IMPL(EaseCubicActionInOut, tweenfunc::cubicEaseInOut, EaseCubicActionInOut, tweenfunc::Cubic_EaseInOut);
 
 //
 // NOTE: Converting these macros into Templates is desirable, but please see
@@ -54,6 +54,12 @@ public:
     */
     virtual ActionInterval* getInnerAction();
 
+    /**
+     @brief Get the tween function this ease applies to the timeline of the inner action.
+     @return The TweenType, or tweenfunc::CUSTOM_EASING when the easing needs extra state such as a rate.
+    */
+    virtual tweenfunc::TweenType getTweenType() const { return tweenfunc::CUSTOM_EASING; }
+
     //
     // Overrides
     //
@@ -120,21 +126,22 @@ private:
 // NOTE: Converting these macros into Templates is desirable, but please see
 // issue #16159 [https://github.com/cocos2d/cocos2d-x/pull/16159] for further info
 //
-#define EASE_TEMPLATE_DECL_CLASS(CLASSNAME)               \
-    class AX_DLL CLASSNAME : public ActionEase            \
-    {                                                     \
-    public:                                               \
-        virtual ~CLASSNAME() {}                           \
-        CLASSNAME() {}                                    \
-                                                          \
-    public:                                               \
-        static CLASSNAME* create(ActionInterval* action); \
-        virtual CLASSNAME* clone() const override;        \
-        virtual void update(float time) override;         \
-        virtual ActionEase* reverse() const override;     \
-                                                          \
-    private:                                              \
-        AX_DISALLOW_COPY_AND_ASSIGN(CLASSNAME);           \
+#define EASE_TEMPLATE_DECL_CLASS(CLASSNAME)                         \
+    class AX_DLL CLASSNAME : public ActionEase                      \
+    {                                                               \
+    public:                                                         \
+        virtual ~CLASSNAME() {}                                     \
+        CLASSNAME() {}                                              \
+                                                                    \
+    public:                                                         \
+        static CLASSNAME* create(ActionInterval* action);           \
+        virtual CLASSNAME* clone() const override;                  \
+        virtual void update(float time) override;                   \
+        virtual ActionEase* reverse() const override;               \
+        virtual tweenfunc::TweenType getTweenType() const override; \
+                                                                    \
+    private:                                                        \
+        AX_DISALLOW_COPY_AND_ASSIGN(CLASSNAME);                     \
     };
 
 /**
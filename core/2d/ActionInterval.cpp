@@ -35,6 +35,7 @@ THE SOFTWARE.
 #include "2d/Node.h"
 #include "2d/SpriteFrame.h"
 #include "2d/ActionInstant.h"
+#include "2d/TweenBatch.h"
 #include "base/Director.h"
 #include "base/EventCustom.h"
 #include "base/EventDispatcher.h"
@@ -96,6 +97,12 @@ bool ActionInterval::sendUpdateEventToScript(float dt, Action* actionObject)
     return false;
 }
 
+float ActionInterval::getElapsed()
+{
+    // a batched tween only writes its clock back when it finishes or is removed
+    return _tweenBatch ? _tweenBatch->getElapsed(this) : _elapsed;
+}
+
 bool ActionInterval::isDone() const
 {
     return _done;
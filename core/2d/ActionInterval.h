@@ -75,7 +75,7 @@ public:
      *
      * @return The seconds had elapsed since the actions started to run.
      */
-    float getElapsed() { return _elapsed; }
+    float getElapsed();
 
     /** Sets the amplitude rate, extension in GridAction
      *
@@ -117,6 +117,7 @@ protected:
     float _elapsed;
     bool _firstTick;
     bool _done;
+    friend class TweenBatch;
 
 protected:
     bool sendUpdateEventToScript(float dt, Action* actionObject);
@@ -460,6 +461,7 @@ protected:
     Vec3 _dstAngle;
     Vec3 _startAngle;
     Vec3 _diffAngle;
+    friend class TweenBatch;
 
 private:
     AX_DISALLOW_COPY_AND_ASSIGN(RotateTo);
@@ -580,6 +582,7 @@ protected:
     Vec3 _positionDelta;
     Vec3 _startPosition;
     Vec3 _previousPosition;
+    friend class TweenBatch;
 
 private:
     AX_DISALLOW_COPY_AND_ASSIGN(MoveBy);
@@ -1066,6 +1069,7 @@ protected:
     float _deltaX;
     float _deltaY;
     float _deltaZ;
+    friend class TweenBatch;
 
 private:
     AX_DISALLOW_COPY_AND_ASSIGN(ScaleTo);
@@ -1203,6 +1207,7 @@ protected:
     uint8_t _fromOpacity;
     friend class FadeOut;
     friend class FadeIn;
+    friend class TweenBatch;
 
 private:
     AX_DISALLOW_COPY_AND_ASSIGN(FadeTo);
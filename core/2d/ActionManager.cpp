@@ -38,7 +38,9 @@ NS_AX_BEGIN
 // singleton stuff
 //
 
-ActionManager::ActionManager() : _currentTarget(nullptr), _currentTargetSalvaged(false) {}
+ActionManager::ActionManager()
+    : _currentTarget(nullptr), _currentTargetSalvaged(false), _tweenBatchingEnabled(false)
+{}
 
 ActionManager::~ActionManager()
 {
@@ -65,6 +67,11 @@ void ActionManager::removeActionAtIndex(ssize_t index,
                                         std::unordered_map<Node*, ActionHandle>::iterator actionIt)
 {
     Action* action = static_cast<Action*>(element.actions[index]);
+    if (TweenBatch::isBatched(action))
+    {
+        _tweenBatch.remove(action);
+        --element.tweenCount;
+    }
 
     if (action == element.currentAction && (!element.currentActionSalvaged))
     {
@@ -100,6 +107,7 @@ void ActionManager::pauseTarget(Node* target)
     if (it != _targets.end())
     {
         it->second.paused = true;
+        pauseTweens(it->second, true);
     }
 }
 
@@ -109,6 +117,7 @@ void ActionManager::resumeTarget(Node* target)
     if (it != _targets.end())
     {
         it->second.paused = false;
+        pauseTweens(it->second, false);
     }
 }
 
@@ -119,6 +128,7 @@ Vector<Node*> ActionManager::pauseAllRunningActions()
     for (auto& [target, element] : _targets)
     {
         element.paused = true;
+        pauseTweens(element, true);
         idsWithActions.pushBack(const_cast<Node*>(target));
     }
 
@@ -157,6 +167,9 @@ void ActionManager::addAction(Action* action, Node* target, bool paused)
     actionHandle.actions.pushBack(action);
 
     action->startWithTarget(target);
+
+    if (_tweenBatchingEnabled && _tweenBatch.add(action, target, actionHandle.paused))
+        ++actionHandle.tweenCount;
 }
 
 // remove
@@ -189,6 +202,7 @@ void ActionManager::removeTargetActionHandle(std::unordered_map<Node*, ActionHan
         element.currentActionSalvaged = true;
     }
 
+    removeTweens(element);
     element.actions.clear();
     if (_currentTarget == &element)
     {
@@ -203,6 +217,7 @@ void ActionManager::removeTargetActionHandle(std::unordered_map<Node*, ActionHan
 
 void ActionManager::eraseTargetActionHandle(std::unordered_map<Node*, ActionHandle>::iterator& actionIt)
 {
+    removeTweens(actionIt->second);
     actionIt->first->release();
     actionIt = _targets.erase(actionIt);
 }
@@ -387,15 +402,86 @@ ssize_t ActionManager::getNumberOfRunningActions() const
     return count;
 }
 
+// tweens
+
+void ActionManager::setTweenBatchingEnabled(bool enabled)
+{
+    if (_tweenBatchingEnabled == enabled)
+        return;
+
+    _tweenBatchingEnabled = enabled;
+    if (!enabled)
+    {
+        _tweenBatch.clear();
+        for (auto& [_, element] : _targets)
+            element.tweenCount = 0;
+    }
+}
+
+void ActionManager::removeTweens(ActionHandle& element)
+{
+    if (element.tweenCount == 0)
+        return;
+
+    for (auto action : element.actions)
+        _tweenBatch.remove(action);
+    element.tweenCount = 0;
+}
+
+void ActionManager::pauseTweens(ActionHandle& element, bool paused)
+{
+    if (element.tweenCount == 0)
+        return;
+
+    for (auto action : element.actions)
+        _tweenBatch.setPaused(action, paused);
+}
+
+void ActionManager::updateTweens(float dt)
+{
+    _tweenBatch.update(dt, _finishedTweens, _orphanedTweenTargets);
+
+    for (auto action : _finishedTweens)
+    {
+        // the nodes written by the batch may have removed the action already
+        if (TweenBatch::isBatched(action))
+        {
+            action->stop();
+            removeAction(action);
+        }
+        action->release();
+    }
+    _finishedTweens.clear();
+
+    // the main loop skips the targets only running batched tweens, so it can't release them
+    for (auto target : _orphanedTweenTargets)
+    {
+        auto actionIt = _targets.find(target);
+        if (actionIt != _targets.end() && actionIt->first->getReferenceCount() == 1)
+            eraseTargetActionHandle(actionIt);
+    }
+    _orphanedTweenTargets.clear();
+}
+
 // main loop
 void ActionManager::update(float dt)
 {
+    if (!_tweenBatch.empty())
+        updateTweens(dt);
+
     for (auto actionIt = _targets.begin(); actionIt != _targets.end();)
     {
         auto elt               = &actionIt->second;
         _currentTarget         = elt;
         _currentTargetSalvaged = false;
 
+        // the batched tweens are written by updateTweens, which also releases the targets only running those
+        if (_currentTarget->tweenCount > 0 && _currentTarget->tweenCount == _currentTarget->actions.size())
+        {
+            ++actionIt;
+            continue;
+        }
+
         if (!_currentTarget->paused)
         {
             // The 'actions' MutableArray may change while inside this loop.
@@ -404,8 +490,9 @@ void ActionManager::update(float dt)
             {
                 _currentTarget->currentAction =
                     static_cast<Action*>(_currentTarget->actions[_currentTarget->actionIndex]);
-                if (_currentTarget->currentAction == nullptr)
+                if (_currentTarget->currentAction == nullptr || TweenBatch::isBatched(_currentTarget->currentAction))
                 {
+                    _currentTarget->currentAction = nullptr;
                     continue;
                 }
 
@@ -31,6 +31,7 @@ THE SOFTWARE.
 #define __ACTION_CCACTION_MANAGER_H__
 
 #include "2d/Action.h"
+#include "2d/TweenBatch.h"
 #include "base/Vector.h"
 #include "base/Object.h"
 
@@ -39,6 +40,7 @@ NS_AX_BEGIN
 struct ActionHandle
 {
     Vector<Action*> actions;
+    ssize_t tweenCount;  // the actions stepped by the TweenBatch
     int actionIndex;
     Action* currentAction;
     bool currentActionSalvaged;
@@ -198,6 +200,19 @@ public:
      */
     virtual void update(float dt);
 
+    /** Steps the common tweens added from now on in bulk with a TweenBatch, instead of calling Action::step on each
+     * of them. Batched tweens are written before the other actions of each frame and don't send script update events.
+     * Disabling hands the batched tweens back to Action::step. Disabled by default.
+     *
+     * @param enabled   Whether tweens are batched.
+     */
+    void setTweenBatchingEnabled(bool enabled);
+
+    /** Returns whether tweens are batched.
+     * @see setTweenBatchingEnabled
+     */
+    bool isTweenBatchingEnabled() const { return _tweenBatchingEnabled; }
+
 protected:
     // declared in ActionManager.m
     void removeTargetActionHandle(std::unordered_map<Node*, ActionHandle>::iterator& actionIt);
@@ -210,10 +225,19 @@ protected:
 
     void eraseTargetActionHandle(std::unordered_map<Node*, ActionHandle>::iterator& actionIt);
 
+    void removeTweens(ActionHandle& element);
+    void pauseTweens(ActionHandle& element, bool paused);
+    void updateTweens(float dt);
+
 protected:
     std::unordered_map<Node*, ActionHandle> _targets;
     ActionHandle* _currentTarget;
     bool _currentTargetSalvaged;
+
+    TweenBatch _tweenBatch;
+    std::vector<Action*> _finishedTweens;
+    std::vector<Node*> _orphanedTweenTargets;
+    bool _tweenBatchingEnabled;
 };
 
 // end of actions group
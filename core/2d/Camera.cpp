@@ -381,6 +381,16 @@ bool Camera::isVisibleInFrustum(const AABB* aabb) const
     }
     return !_frustum.isOutOfFrustum(*aabb);
 }
+
+void Camera::isOutOfFrustum(const Vec3* centers, const Vec3* extents, size_t count, bool* outside) const
+{
+    if (_frustumDirty)
+    {
+        _frustum.initFrustum(this);
+        _frustumDirty = false;
+    }
+    _frustum.isOutOfFrustum(centers, extents, count, outside);
+}
 #endif
 
 float Camera::getDepthInView(const Mat4& transform) const
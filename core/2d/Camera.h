@@ -40,6 +40,7 @@ NS_AX_BEGIN
 
 class Scene;
 class CameraBackgroundBrush;
+class MeshRenderer;
 
 /**
  * Note:
@@ -71,6 +72,7 @@ class AX_DLL Camera : public Node
     friend class Scene;
     friend class Director;
     friend class EventDispatcher;
+    friend class MeshRenderer;
 
 public:
     /**
@@ -198,6 +200,16 @@ public:
      * Is this aabb visible in frustum
      */
     bool isVisibleInFrustum(const AABB* aabb) const;
+
+    /**
+     * Tests a batch of aabbs, given by their centers and half extents, against the frustum
+     * outside[i] is set to true if the i-th aabb is out of frustum.
+     */
+    void isOutOfFrustum(const Vec3* centers, const Vec3* extents, size_t count, bool* outside) const;
+
+    /** Returns the number of meshes culled by the frustum of this camera in the last frame. */
+    unsigned int getCulledMeshes() const { return _culledMeshes; }
+    void addCulledMeshes(unsigned int number) const { _culledMeshes += number; }
 #endif
 
     /**
@@ -365,6 +377,14 @@ protected:
 #if defined(AX_ENABLE_3D)
     mutable Frustum _frustum;                           // camera frustum
     mutable bool _frustumDirty = true;
+    mutable unsigned int _culledMeshes = 0;
+
+    // scratch buffers of MeshRenderer::cullMeshRenderers
+    mutable std::vector<Vec3> _cullCenters;
+    mutable std::vector<Vec3> _cullExtents;
+    mutable std::vector<MeshRenderer*> _cullTested;
+    mutable std::unique_ptr<bool[]> _cullOutside;
+    mutable size_t _cullOutsideCapacity = 0;
 #endif
     int8_t _depth = -1;  // camera depth, the depth of camera with CameraFlag::DEFAULT flag is 0 by default, a camera
                          // with larger depth is drawn on top of camera with smaller depth
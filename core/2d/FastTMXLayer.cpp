@@ -115,6 +115,7 @@ FastTMXLayer::FastTMXLayer() {}
 
 FastTMXLayer::~FastTMXLayer()
 {
+    releaseChunks();
     AX_SAFE_RELEASE(_tileSet);
     AX_SAFE_RELEASE(_texture);
     AX_SAFE_FREE(_tiles);
@@ -130,6 +131,12 @@ FastTMXLayer::~FastTMXLayer()
 
 void FastTMXLayer::draw(Renderer* renderer, const Mat4& transform, uint32_t flags)
 {
+    if (_chunkSize > 0)
+    {
+        drawChunks(renderer, transform);
+        return;
+    }
+
     updateTotalQuads();
 
     auto cam = Camera::getVisitingCamera();
@@ -137,23 +144,9 @@ void FastTMXLayer::draw(Renderer* renderer, const Mat4& transform, uint32_t flag
         _cameraZoomDirty != cam->getZoom())
     {
         _cameraPositionDirty = cam->getPosition();
-        auto zoom            = _cameraZoomDirty = cam->getZoom();
-        Vec2 s               = _director->getVisibleSize();
-        const Vec2& anchor   = getAnchorPoint();
-        auto rect            = Rect(cam->getPositionX() - s.width * zoom * (anchor.x == 0.0f ? 0.5f : anchor.x),
-                                    cam->getPositionY() - s.height * zoom * (anchor.y == 0.0f ? 0.5f : anchor.y),
-                                    s.width * zoom, s.height * zoom);
-
-        rect.origin.x -= _tileSet->_tileSize.x;
-        rect.origin.y -= _tileSet->_tileSize.y;
-        rect.size.x += s.x * zoom / 2 + _tileSet->_tileSize.x * zoom;
-        rect.size.y += s.y * zoom / 2 + _tileSet->_tileSize.y * zoom;
-
-        Mat4 inv = transform;
-        inv.inverse();
-        rect = RectApplyTransform(rect, inv);
-
-        updateTiles(rect);
+        _cameraZoomDirty     = cam->getZoom();
+
+        updateTiles(getCulledRect(transform));
         updateIndexBuffer();
         updatePrimitives();
         _dirty = false;
@@ -173,7 +166,27 @@ void FastTMXLayer::draw(Renderer* renderer, const Mat4& transform, uint32_t flag
     }
 }
 
-void FastTMXLayer::updateTiles(const Rect& culledRect)
+Rect FastTMXLayer::getCulledRect(const Mat4& transform)
+{
+    auto cam           = Camera::getVisitingCamera();
+    auto zoom          = cam->getZoom();
+    Vec2 s             = _director->getVisibleSize();
+    const Vec2& anchor = getAnchorPoint();
+    auto rect          = Rect(cam->getPositionX() - s.width * zoom * (anchor.x == 0.0f ? 0.5f : anchor.x),
+                              cam->getPositionY() - s.height * zoom * (anchor.y == 0.0f ? 0.5f : anchor.y),
+                              s.width * zoom, s.height * zoom);
+
+    rect.origin.x -= _tileSet->_tileSize.x;
+    rect.origin.y -= _tileSet->_tileSize.y;
+    rect.size.x += s.x * zoom / 2 + _tileSet->_tileSize.x * zoom;
+    rect.size.y += s.y * zoom / 2 + _tileSet->_tileSize.y * zoom;
+
+    Mat4 inv = transform;
+    inv.inverse();
+    return RectApplyTransform(rect, inv);
+}
+
+void FastTMXLayer::getTileRangeForRect(const Rect& culledRect, int& xBegin, int& xEnd, int& yBegin, int& yEnd)
 {
     Rect visibleTiles        = Rect(culledRect.origin, culledRect.size * _director->getContentScaleFactor());
     Vec2 mapTileSize         = AX_SIZE_PIXELS_TO_POINTS(_mapTileSize);
@@ -223,6 +236,18 @@ void FastTMXLayer::updateTiles(const Rect& culledRect)
         // AXASSERT(0, "TMX invalid value");
     }
 
+    yBegin = static_cast<int>(std::max(0.f, visibleTiles.origin.y - tilesOverY));
+    yEnd   = static_cast<int>(
+        std::min(_layerSize.height, visibleTiles.origin.y + visibleTiles.size.height + tilesOverY));
+    xBegin = static_cast<int>(std::max(0.f, visibleTiles.origin.x - tilesOverX));
+    xEnd   = static_cast<int>(std::min(_layerSize.width, visibleTiles.origin.x + visibleTiles.size.width + tilesOverX));
+}
+
+void FastTMXLayer::updateTiles(const Rect& culledRect)
+{
+    int xBegin, xEnd, yBegin, yEnd;
+    getTileRangeForRect(culledRect, xBegin, xEnd, yBegin, yEnd);
+
     _indicesVertexZNumber.clear();
 
     for (const auto& iter : _indicesVertexZOffsets)
@@ -230,13 +255,6 @@ void FastTMXLayer::updateTiles(const Rect& culledRect)
         _indicesVertexZNumber[iter.first] = iter.second;
     }
 
-    int yBegin = static_cast<int>(std::max(0.f, visibleTiles.origin.y - tilesOverY));
-    int yEnd =
-        static_cast<int>(std::min(_layerSize.height, visibleTiles.origin.y + visibleTiles.size.height + tilesOverY));
-    int xBegin = static_cast<int>(std::max(0.f, visibleTiles.origin.x - tilesOverX));
-    int xEnd =
-        static_cast<int>(std::min(_layerSize.width, visibleTiles.origin.x + visibleTiles.size.width + tilesOverX));
-
     for (int y = yBegin; y < yEnd; ++y)
     {
         for (int x = xBegin; x < xEnd; ++x)
@@ -493,24 +511,13 @@ void FastTMXLayer::updateTotalQuads()
 {
     if (_quadsDirty)
     {
-        Vec2 tileSize = AX_SIZE_PIXELS_TO_POINTS(_tileSet->_tileSize);
-        Vec2 texSize  = _tileSet->_imageSize;
         _tileToQuadIndex.clear();
         _totalQuads.resize(int(_layerSize.width * _layerSize.height));
         _indices.resize(6 * int(_layerSize.width * _layerSize.height));
         _tileToQuadIndex.resize(int(_layerSize.width * _layerSize.height), -1);
         _indicesVertexZOffsets.clear();
 
-        auto color = Color4B::WHITE;
-        color.a    = getDisplayedOpacity();
-
-        if (_texture->hasPremultipliedAlpha())
-        {
-            auto alpha = color.a / 255.0f;
-            color.r    = static_cast<uint8_t>(color.r * alpha);
-            color.g    = static_cast<uint8_t>(color.g * alpha);
-            color.b    = static_cast<uint8_t>(color.b * alpha);
-        }
+        auto color = getTileColor();
 
         int quadIndex = 0;
         for (int y = 0; y < _layerSize.height; ++y)
@@ -525,15 +532,7 @@ void FastTMXLayer::updateTotalQuads()
 
                 _tileToQuadIndex[tileIndex] = quadIndex;
 
-                auto& quad = _totalQuads[quadIndex];
-
-                Vec3 nodePos(float(x), float(y), 0);
-                _tileToNodeTransform.transformPoint(&nodePos);
-
-                float left, right, top, bottom, z;
-
                 int zPos  = getVertexZForPos(Vec2((float)x, (float)y));
-                z         = (float)zPos;
                 auto iter = _indicesVertexZOffsets.find(zPos);
                 if (iter == _indicesVertexZOffsets.end())
                 {
@@ -543,83 +542,8 @@ void FastTMXLayer::updateTotalQuads()
                 {
                     iter->second++;
                 }
-                // vertices
-                if (tileGID & kTMXTileDiagonalFlag)
-                {
-                    left   = nodePos.x;
-                    right  = nodePos.x + tileSize.height;
-                    bottom = nodePos.y + tileSize.width;
-                    top    = nodePos.y;
-                }
-                else
-                {
-                    left   = nodePos.x;
-                    right  = nodePos.x + tileSize.width;
-                    bottom = nodePos.y + tileSize.height;
-                    top    = nodePos.y;
-                }
-
-                if (tileGID & kTMXTileVerticalFlag)
-                    std::swap(top, bottom);
-                if (tileGID & kTMXTileHorizontalFlag)
-                    std::swap(left, right);
-
-                if (tileGID & kTMXTileDiagonalFlag)
-                {
-                    // FIXME: not working correctly
-                    quad.bl.vertices.x = left;
-                    quad.bl.vertices.y = bottom;
-                    quad.bl.vertices.z = z;
-                    quad.br.vertices.x = left;
-                    quad.br.vertices.y = top;
-                    quad.br.vertices.z = z;
-                    quad.tl.vertices.x = right;
-                    quad.tl.vertices.y = bottom;
-                    quad.tl.vertices.z = z;
-                    quad.tr.vertices.x = right;
-                    quad.tr.vertices.y = top;
-                    quad.tr.vertices.z = z;
-                }
-                else
-                {
-                    quad.bl.vertices.x = left;
-                    quad.bl.vertices.y = bottom;
-                    quad.bl.vertices.z = z;
-                    quad.br.vertices.x = right;
-                    quad.br.vertices.y = bottom;
-                    quad.br.vertices.z = z;
-                    quad.tl.vertices.x = left;
-                    quad.tl.vertices.y = top;
-                    quad.tl.vertices.z = z;
-                    quad.tr.vertices.x = right;
-                    quad.tr.vertices.y = top;
-                    quad.tr.vertices.z = z;
-                }
 
-                // texcoords
-                Rect tileTexture = _tileSet->getRectForGID(tileGID);
-                left             = (tileTexture.origin.x / texSize.width);
-                right            = left + (tileTexture.size.width / texSize.width);
-                bottom           = (tileTexture.origin.y / texSize.height);
-                top              = bottom + (tileTexture.size.height / texSize.height);
-
-                // issue#1085 OpenGL sub-pixel horizontal-vertical lines pixel-tolerance fix.
-                float ptx = 1.0 / (_tileSet->_imageSize.x * tileSize.x);
-                float pty = 1.0 / (_tileSet->_imageSize.y * tileSize.y);
-
-                quad.bl.texCoords.u = left + ptx;
-                quad.bl.texCoords.v = bottom + pty;
-                quad.br.texCoords.u = right - ptx;
-                quad.br.texCoords.v = bottom + pty;
-                quad.tl.texCoords.u = left + ptx;
-                quad.tl.texCoords.v = top - pty;
-                quad.tr.texCoords.u = right - ptx;
-                quad.tr.texCoords.v = top - pty;
-
-                quad.bl.colors = color;
-                quad.br.colors = color;
-                quad.tl.colors = color;
-                quad.tr.colors = color;
+                setupTileQuad(_totalQuads[quadIndex], x, y, tileGID, (float)zPos, color);
 
                 ++quadIndex;
             }
@@ -637,6 +561,439 @@ void FastTMXLayer::updateTotalQuads()
     }
 }
 
+Color4B FastTMXLayer::getTileColor() const
+{
+    auto color = Color4B::WHITE;
+    color.a    = getDisplayedOpacity();
+
+    if (_texture->hasPremultipliedAlpha())
+    {
+        auto alpha = color.a / 255.0f;
+        color.r    = static_cast<uint8_t>(color.r * alpha);
+        color.g    = static_cast<uint8_t>(color.g * alpha);
+        color.b    = static_cast<uint8_t>(color.b * alpha);
+    }
+    return color;
+}
+
+void FastTMXLayer::setupTileQuad(V3F_C4B_T2F_Quad& quad,
+                                 int x,
+                                 int y,
+                                 uint32_t tileGID,
+                                 float z,
+                                 const Color4B& color) const
+{
+    Vec2 tileSize = AX_SIZE_PIXELS_TO_POINTS(_tileSet->_tileSize);
+    Vec2 texSize  = _tileSet->_imageSize;
+
+    Vec3 nodePos(float(x), float(y), 0);
+    _tileToNodeTransform.transformPoint(&nodePos);
+
+    float left, right, top, bottom;
+
+    // vertices
+    if (tileGID & kTMXTileDiagonalFlag)
+    {
+        left   = nodePos.x;
+        right  = nodePos.x + tileSize.height;
+        bottom = nodePos.y + tileSize.width;
+        top    = nodePos.y;
+    }
+    else
+    {
+        left   = nodePos.x;
+        right  = nodePos.x + tileSize.width;
+        bottom = nodePos.y + tileSize.height;
+        top    = nodePos.y;
+    }
+
+    if (tileGID & kTMXTileVerticalFlag)
+        std::swap(top, bottom);
+    if (tileGID & kTMXTileHorizontalFlag)
+        std::swap(left, right);
+
+    if (tileGID & kTMXTileDiagonalFlag)
+    {
+        // FIXME: not working correctly
+        quad.bl.vertices.x = left;
+        quad.bl.vertices.y = bottom;
+        quad.bl.vertices.z = z;
+        quad.br.vertices.x = left;
+        quad.br.vertices.y = top;
+        quad.br.vertices.z = z;
+        quad.tl.vertices.x = right;
+        quad.tl.vertices.y = bottom;
+        quad.tl.vertices.z = z;
+        quad.tr.vertices.x = right;
+        quad.tr.vertices.y = top;
+        quad.tr.vertices.z = z;
+    }
+    else
+    {
+        quad.bl.vertices.x = left;
+        quad.bl.vertices.y = bottom;
+        quad.bl.vertices.z = z;
+        quad.br.vertices.x = right;
+        quad.br.vertices.y = bottom;
+        quad.br.vertices.z = z;
+        quad.tl.vertices.x = left;
+        quad.tl.vertices.y = top;
+        quad.tl.vertices.z = z;
+        quad.tr.vertices.x = right;
+        quad.tr.vertices.y = top;
+        quad.tr.vertices.z = z;
+    }
+
+    // texcoords
+    Rect tileTexture = _tileSet->getRectForGID(tileGID);
+    left             = (tileTexture.origin.x / texSize.width);
+    right            = left + (tileTexture.size.width / texSize.width);
+    bottom           = (tileTexture.origin.y / texSize.height);
+    top              = bottom + (tileTexture.size.height / texSize.height);
+
+    // issue#1085 OpenGL sub-pixel horizontal-vertical lines pixel-tolerance fix.
+    float ptx = 1.0 / (_tileSet->_imageSize.x * tileSize.x);
+    float pty = 1.0 / (_tileSet->_imageSize.y * tileSize.y);
+
+    quad.bl.texCoords.u = left + ptx;
+    quad.bl.texCoords.v = bottom + pty;
+    quad.br.texCoords.u = right - ptx;
+    quad.br.texCoords.v = bottom + pty;
+    quad.tl.texCoords.u = left + ptx;
+    quad.tl.texCoords.v = top - pty;
+    quad.tr.texCoords.u = right - ptx;
+    quad.tr.texCoords.v = top - pty;
+
+    quad.bl.colors = color;
+    quad.br.colors = color;
+    quad.tl.colors = color;
+    quad.tr.colors = color;
+}
+
+// FastTMXLayer - chunked mode
+void FastTMXLayer::setChunkSize(int chunkSize)
+{
+    chunkSize = std::max(chunkSize, 0);
+    if (chunkSize == _chunkSize)
+        return;
+
+#ifndef AX_FAST_TILEMAP_32_BIT_INDICES
+    AXASSERT(chunkSize * chunkSize * 4 <= 65536, "FastTMXLayer: chunk size too big for 16 bit indices");
+#endif
+
+    releaseChunks();
+    _chunkSize  = chunkSize;
+    _quadsDirty = true;
+    _dirty      = true;
+    if (_chunkSize == 0)
+        return;
+
+    // the quads of the whole layer are not needed anymore
+    _tileToQuadIndex = {};
+    _totalQuads      = {};
+    _indices         = {};
+    _indicesVertexZOffsets.clear();
+    _indicesVertexZNumber.clear();
+    for (auto&& e : _customCommands)
+    {
+        AX_SAFE_RELEASE(e.second->getPipelineDescriptor().programState);
+        delete e.second;
+    }
+    _customCommands.clear();
+    AX_SAFE_RELEASE_NULL(_vertexBuffer);
+    AX_SAFE_RELEASE_NULL(_indexBuffer);
+
+    _chunkCountX    = static_cast<int>(std::ceil(_layerSize.width / _chunkSize));
+    int chunkCountY = static_cast<int>(std::ceil(_layerSize.height / _chunkSize));
+    _chunks.resize(_chunkCountX * chunkCountY);
+    for (int i = 0; i < static_cast<int>(_chunks.size()); ++i)
+    {
+        _chunks[i].x = i % _chunkCountX;
+        _chunks[i].y = i / _chunkCountX;
+    }
+}
+
+void FastTMXLayer::drawChunks(Renderer* renderer, const Mat4& transform)
+{
+    if (_quadsDirty)
+    {
+        // the opacity or the tiles changed, all the chunks have to be rebuilt
+        for (auto&& chunk : _chunks)
+            ++chunk.version;
+        _quadsDirty = false;
+    }
+    _dirty = false;
+
+    setupChunkPrimitives();
+
+    int xBegin, xEnd, yBegin, yEnd;
+    getTileRangeForRect(getCulledRect(transform), xBegin, xEnd, yBegin, yEnd);
+    if (xBegin >= xEnd || yBegin >= yEnd)
+        return;
+
+    const int chunkCountY = static_cast<int>(_chunks.size()) / _chunkCountX;
+    const int cxBegin     = xBegin / _chunkSize;
+    const int cxEnd       = (xEnd - 1) / _chunkSize + 1;
+    const int cyBegin     = yBegin / _chunkSize;
+    const int cyEnd       = (yEnd - 1) / _chunkSize + 1;
+    const auto frame      = _director->getTotalFrames();
+
+    const auto& projectionMat = _director->getMatrix(MATRIX_STACK_TYPE::MATRIX_STACK_PROJECTION);
+    Mat4 finalMat             = projectionMat * _modelViewTransform;
+    _chunkProgramState->setUniform(_mvpMatrixLocaiton, finalMat.m, sizeof(finalMat.m));
+
+    // the visible chunks are drawn in row order, those which were not prefetched in time are built right away
+    for (int cy = cyBegin; cy < cyEnd; ++cy)
+    {
+        for (int cx = cxBegin; cx < cxEnd; ++cx)
+        {
+            int index   = cx + cy * _chunkCountX;
+            auto& chunk = _chunks[index];
+            updateChunk(index, true);
+
+            chunk.lastVisibleFrame = frame;
+            if (chunk.resident)
+            {
+                _residentChunks.splice(_residentChunks.begin(), _residentChunks, chunk.residentIter);
+                renderer->addCommand(chunk.command);
+            }
+        }
+    }
+
+    // the chunks around are built on the workers, before the camera gets to them
+    const int pyBegin = std::max(0, cyBegin - _chunkPrefetchDistance);
+    const int pyEnd   = std::min(chunkCountY, cyEnd + _chunkPrefetchDistance);
+    const int pxBegin = std::max(0, cxBegin - _chunkPrefetchDistance);
+    const int pxEnd   = std::min(_chunkCountX, cxEnd + _chunkPrefetchDistance);
+    for (int cy = pyBegin; cy < pyEnd; ++cy)
+    {
+        for (int cx = pxBegin; cx < pxEnd; ++cx)
+        {
+            if (cy >= cyBegin && cy < cyEnd && cx >= cxBegin && cx < cxEnd)
+                continue;
+            updateChunk(cx + cy * _chunkCountX, false);
+        }
+    }
+
+    // evict the least recently visible chunks, except the ones visible in this frame
+    auto iter = _residentChunks.end();
+    while (static_cast<int>(_residentChunks.size()) > _maxResidentChunks && iter != _residentChunks.begin())
+    {
+        auto& chunk = _chunks[*--iter];
+        if (chunk.lastVisibleFrame != frame)
+        {
+            iter           = _residentChunks.erase(iter);
+            chunk.resident = false;
+            releaseChunk(chunk);
+        }
+    }
+}
+
+void FastTMXLayer::updateChunk(int chunkIndex, bool buildNow)
+{
+    auto& chunk = _chunks[chunkIndex];
+    if (chunk.pendingQuads && chunk.pendingJob.isDone())
+    {
+        if (chunk.pendingVersion == chunk.version)
+            uploadChunk(chunkIndex, *chunk.pendingQuads);
+        chunk.pendingQuads = nullptr;
+    }
+
+    // the chunk is up to date, or is being built from its current tiles already
+    if (chunk.builtVersion == chunk.version || (!buildNow && !chunk.pendingJob.isDone()))
+        return;
+
+    int width  = 0;
+    auto tiles = copyChunkTiles(chunk, width);
+    if (buildNow)
+    {
+        // a pending build is left to finish, its quads are dropped
+        chunk.pendingQuads = nullptr;
+
+        ChunkQuads chunkQuads;
+        buildChunkQuads(chunkQuads, chunk.x * _chunkSize, chunk.y * _chunkSize, width, tiles, getTileColor());
+        uploadChunk(chunkIndex, chunkQuads);
+    }
+    else
+    {
+        auto chunkQuads      = std::make_shared<ChunkQuads>();
+        chunk.pendingQuads   = chunkQuads;
+        chunk.pendingVersion = chunk.version;
+        chunk.pendingJob     = _director->getJobSystem()->schedule(
+            [this, chunkQuads, x0 = chunk.x * _chunkSize, y0 = chunk.y * _chunkSize, width, tiles = std::move(tiles),
+             color = getTileColor()]() { buildChunkQuads(*chunkQuads, x0, y0, width, tiles, color); },
+            JobPriority::Background);
+    }
+}
+
+std::vector<uint32_t> FastTMXLayer::copyChunkTiles(const TileChunk& chunk, int& width) const
+{
+    // the workers build the quads from a copy, the tiles may change meanwhile
+    int x0     = chunk.x * _chunkSize;
+    int y0     = chunk.y * _chunkSize;
+    width      = std::min(_chunkSize, static_cast<int>(_layerSize.width) - x0);
+    int height = std::min(_chunkSize, static_cast<int>(_layerSize.height) - y0);
+
+    std::vector<uint32_t> tiles(width * height);
+    for (int y = 0; y < height; ++y)
+        memcpy(tiles.data() + y * width, _tiles + getTileIndexByPos(x0, y0 + y), width * sizeof(uint32_t));
+    return tiles;
+}
+
+void FastTMXLayer::buildChunkQuads(ChunkQuads& chunkQuads,
+                                   int x0,
+                                   int y0,
+                                   int width,
+                                   const std::vector<uint32_t>& tiles,
+                                   const Color4B& color) const
+{
+    // (vertex z, tile), the quads are sorted by vertex z as in the index buffer of the whole layer
+    std::vector<std::pair<int, int>> order;
+    order.reserve(tiles.size());
+    for (int i = 0; i < static_cast<int>(tiles.size()); ++i)
+    {
+        if (tiles[i] != 0)
+            order.emplace_back(getVertexZForPos(Vec2(float(x0 + i % width), float(y0 + i / width))), i);
+    }
+    if (_useAutomaticVertexZ)
+    {
+        std::stable_sort(order.begin(), order.end(),
+                         [](const std::pair<int, int>& a, const std::pair<int, int>& b) { return a.first < b.first; });
+    }
+
+    chunkQuads.quads.resize(order.size());
+    for (size_t q = 0; q < order.size(); ++q)
+    {
+        int i = order[q].second;
+        setupTileQuad(chunkQuads.quads[q], x0 + i % width, y0 + i / width, tiles[i], float(order[q].first), color);
+    }
+}
+
+void FastTMXLayer::uploadChunk(int chunkIndex, const ChunkQuads& chunkQuads)
+{
+    auto& chunk   = _chunks[chunkIndex];
+    int quadCount = static_cast<int>(chunkQuads.quads.size());
+    if (quadCount == 0)
+    {
+        // nothing to draw, no vertex buffer needed
+        releaseChunk(chunk);
+        chunk.builtVersion = chunk.version;
+        return;
+    }
+
+    auto vertexBufferSize = sizeof(V3F_C4B_T2F_Quad) * quadCount;
+    if (quadCount > chunk.quadCapacity)
+    {
+        AX_SAFE_RELEASE(chunk.vertexBuffer);
+        chunk.vertexBuffer = backend::DriverBase::getInstance()->newBuffer(
+            vertexBufferSize, backend::BufferType::VERTEX, backend::BufferUsage::STATIC);
+        chunk.quadCapacity = quadCount;
+    }
+    chunk.vertexBuffer->updateData(chunkQuads.quads.data(), vertexBufferSize);
+
+    if (!chunk.command)
+    {
+#ifdef AX_FAST_TILEMAP_32_BIT_INDICES
+        CustomCommand::IndexFormat indexFormat = CustomCommand::IndexFormat::U_INT;
+#else
+        CustomCommand::IndexFormat indexFormat = CustomCommand::IndexFormat::U_SHORT;
+#endif
+        auto blendfunc =
+            _texture->hasPremultipliedAlpha() ? BlendFunc::ALPHA_PREMULTIPLIED : BlendFunc::ALPHA_NON_PREMULTIPLIED;
+
+        // the chunks share the program state, it is released by the layer
+        chunk.command = new CustomCommand();
+        chunk.command->setIndexBuffer(_chunkIndexBuffer, indexFormat);
+        chunk.command->getPipelineDescriptor().programState = _chunkProgramState;
+        chunk.command->init(_globalZOrder, blendfunc);
+    }
+    chunk.command->setVertexBuffer(chunk.vertexBuffer);
+    chunk.command->setIndexDrawInfo(0, quadCount * 6);
+
+    chunk.quadCount    = quadCount;
+    chunk.builtVersion = chunk.version;
+    if (!chunk.resident)
+    {
+        _residentChunks.push_front(chunkIndex);
+        chunk.residentIter = _residentChunks.begin();
+        chunk.resident     = true;
+    }
+}
+
+void FastTMXLayer::releaseChunk(TileChunk& chunk)
+{
+    if (chunk.resident)
+    {
+        _residentChunks.erase(chunk.residentIter);
+        chunk.resident = false;
+    }
+    AX_SAFE_DELETE(chunk.command);
+    AX_SAFE_RELEASE_NULL(chunk.vertexBuffer);
+    chunk.quadCount    = 0;
+    chunk.quadCapacity = 0;
+    chunk.builtVersion = ~0u;
+    chunk.pendingQuads = nullptr;
+}
+
+void FastTMXLayer::releaseChunks()
+{
+    for (auto&& chunk : _chunks)
+    {
+        // the pending builds use the layer
+        chunk.pendingJob.wait();
+        releaseChunk(chunk);
+    }
+    _chunks.clear();
+    _residentChunks.clear();
+    AX_SAFE_RELEASE_NULL(_chunkIndexBuffer);
+    AX_SAFE_RELEASE_NULL(_chunkProgramState);
+}
+
+void FastTMXLayer::setupChunkPrimitives()
+{
+    if (_chunkProgramState)
+        return;
+
+    // the quads of every chunk start at 0, so one index buffer fits all of them
+    int quadCount = _chunkSize * _chunkSize;
+    std::vector<decltype(_indices)::value_type> indices(6 * quadCount);
+    for (int i = 0; i < quadCount; ++i)
+    {
+        auto quadIndex     = static_cast<decltype(_indices)::value_type>(i);
+        indices[6 * i + 0] = quadIndex * 4 + 0;
+        indices[6 * i + 1] = quadIndex * 4 + 1;
+        indices[6 * i + 2] = quadIndex * 4 + 2;
+        indices[6 * i + 3] = quadIndex * 4 + 3;
+        indices[6 * i + 4] = quadIndex * 4 + 2;
+        indices[6 * i + 5] = quadIndex * 4 + 1;
+    }
+    auto indexBufferSize = sizeof(decltype(_indices)::value_type) * indices.size();
+    _chunkIndexBuffer    = backend::DriverBase::getInstance()->newBuffer(indexBufferSize, backend::BufferType::INDEX,
+                                                                         backend::BufferUsage::STATIC);
+    _chunkIndexBuffer->updateData(indices.data(), indexBufferSize);
+
+    auto* program      = backend::Program::getBuiltinProgram(_useAutomaticVertexZ
+                                                                 ? backend::ProgramType::POSITION_TEXTURE_COLOR_ALPHA_TEST
+                                                                 : backend::ProgramType::POSITION_TEXTURE_COLOR);
+    _chunkProgramState = new backend::ProgramState(program);
+    if (_useAutomaticVertexZ)
+    {
+        _alphaValueLocation = _chunkProgramState->getUniformLocation("u_alpha_value");
+        _chunkProgramState->setUniform(_alphaValueLocation, &_alphaFuncValue, sizeof(_alphaFuncValue));
+    }
+    _mvpMatrixLocaiton = _chunkProgramState->getUniformLocation("u_MVPMatrix");
+    _textureLocation   = _chunkProgramState->getUniformLocation("u_tex0");
+    _chunkProgramState->setTexture(_textureLocation, 0, _texture->getBackendTexture());
+}
+
+void FastTMXLayer::invalidateChunkAt(int tileIndex)
+{
+    int width = static_cast<int>(_layerSize.width);
+    int x     = tileIndex % width;
+    int y     = tileIndex / width;
+    ++_chunks[x / _chunkSize + (y / _chunkSize) * _chunkCountX].version;
+}
+
 // removing / getting tiles
 Sprite* FastTMXLayer::getTileAt(const Vec2& tileCoordinate)
 {
@@ -714,7 +1071,7 @@ Vec2 FastTMXLayer::getPositionAt(const Vec2& pos)
     return PointApplyTransform(pos, _tileToNodeTransform);
 }
 
-int FastTMXLayer::getVertexZForPos(const Vec2& pos)
+int FastTMXLayer::getVertexZForPos(const Vec2& pos) const
 {
     int ret    = 0;
     int maxVal = 0;
@@ -776,8 +1133,14 @@ void FastTMXLayer::setFlaggedTileGIDByIndex(int index, uint32_t gid)
     if (gid == _tiles[index])
         return;
     _tiles[index] = gid;
-    _quadsDirty   = true;
-    _dirty        = true;
+    if (_chunkSize > 0)
+    {
+        // only the chunk of the tile is rebuilt
+        invalidateChunkAt(index);
+        return;
+    }
+    _quadsDirty = true;
+    _dirty      = true;
 }
 
 void FastTMXLayer::removeChild(Node* node, bool cleanup)
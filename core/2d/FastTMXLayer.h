@@ -29,8 +29,11 @@ THE SOFTWARE.
 #pragma once
 
 #include <unordered_map>
+#include <list>
+#include <memory>
 #include "2d/Node.h"
 #include "2d/TMXXMLParser.h"
+#include "base/JobSystem.h"
 #include "renderer/CustomCommand.h"
 
 NS_AX_BEGIN
@@ -280,6 +283,31 @@ public:
      */
     void setupTileSprite(Sprite* sprite, const Vec2& pos, uint32_t gid);
 
+    /** Enables the chunked mode when chunkSize is greater than 0, it is disabled by default.
+     * In chunked mode the layer is split into chunks of chunkSize x chunkSize tiles, and the quads of a chunk are only
+     * built when the camera gets close to it, on the JobSystem workers, instead of building the quads of the whole
+     * layer. Only the vertex buffers of the most recently visible chunks stay resident, see setMaxResidentChunks.
+     * It suits layers much larger than the screen.
+     *
+     * @param chunkSize The width and height of the chunks in tiles, 0 to disable the chunked mode.
+     */
+    void setChunkSize(int chunkSize);
+    int getChunkSize() const { return _chunkSize; }
+
+    /** Sets how many chunks keep their vertex buffer, 64 by default.
+     * Beyond it the least recently visible chunks are evicted, the chunks visible in the current frame never are.
+     */
+    void setMaxResidentChunks(int count) { _maxResidentChunks = count; }
+    int getMaxResidentChunks() const { return _maxResidentChunks; }
+
+    /** Sets the distance in chunks around the visible ones within which chunks are built ahead of time, 1 by default.
+     */
+    void setChunkPrefetchDistance(int distance) { _chunkPrefetchDistance = distance; }
+    int getChunkPrefetchDistance() const { return _chunkPrefetchDistance; }
+
+    /** The number of chunks whose vertex buffer is resident. */
+    size_t getResidentChunkCount() const { return _residentChunks.size(); }
+
     //
     // Override
     //
@@ -304,6 +332,8 @@ public:
 protected:
     virtual void setOpacity(uint8_t opacity) override;
 
+    Rect getCulledRect(const Mat4& transform);
+    void getTileRangeForRect(const Rect& culledRect, int& xBegin, int& xEnd, int& yBegin, int& yEnd);
     void updateTiles(const Rect& culledRect);
     Vec2 calculateLayerOffset(const Vec2& offset);
 
@@ -313,13 +343,15 @@ protected:
     Mat4 tileToNodeTransform();
     Rect tileBoundsForClipTransform(const Mat4& tileToClip);
 
-    int getVertexZForPos(const Vec2& pos);
+    int getVertexZForPos(const Vec2& pos) const;
 
     // Flip flags is packed into gid
     void setFlaggedTileGIDByIndex(int index, uint32_t gid);
 
     //
     void updateTotalQuads();
+    Color4B getTileColor() const;
+    void setupTileQuad(V3F_C4B_T2F_Quad& quad, int x, int y, uint32_t tileGID, float z, const Color4B& color) const;
 
     int getTileIndexByPos(int x, int y) const { return x + y * (int)_layerSize.width; }
 
@@ -327,6 +359,46 @@ protected:
     void updateIndexBuffer();
     void updatePrimitives();
 
+    struct ChunkQuads
+    {
+        std::vector<V3F_C4B_T2F_Quad> quads;
+    };
+
+    struct TileChunk
+    {
+        int x = 0;
+        int y = 0;
+        /** bumped when a tile of the chunk changes, the chunk is rebuilt when it no longer matches builtVersion */
+        unsigned int version          = 0;
+        unsigned int builtVersion     = ~0u;
+        int quadCount                 = 0;
+        int quadCapacity              = 0;
+        unsigned int lastVisibleFrame = 0;
+        backend::Buffer* vertexBuffer = nullptr;
+        CustomCommand* command        = nullptr;
+        /** the quads being built on a worker, and the version they are built from */
+        std::shared_ptr<ChunkQuads> pendingQuads;
+        unsigned int pendingVersion = 0;
+        JobHandle pendingJob;
+        bool resident = false;
+        std::list<int>::iterator residentIter;
+    };
+
+    void drawChunks(Renderer* renderer, const Mat4& transform);
+    void updateChunk(int chunkIndex, bool buildNow);
+    std::vector<uint32_t> copyChunkTiles(const TileChunk& chunk, int& width) const;
+    void buildChunkQuads(ChunkQuads& chunkQuads,
+                         int x0,
+                         int y0,
+                         int width,
+                         const std::vector<uint32_t>& tiles,
+                         const Color4B& color) const;
+    void uploadChunk(int chunkIndex, const ChunkQuads& chunkQuads);
+    void releaseChunk(TileChunk& chunk);
+    void releaseChunks();
+    void setupChunkPrimitives();
+    void invalidateChunkAt(int tileIndex);
+
     //! name of the layer
     std::string _layerName;
 
@@ -389,6 +461,17 @@ protected:
     backend::UniformLocation _mvpMatrixLocaiton;
     backend::UniformLocation _textureLocation;
     backend::UniformLocation _alphaValueLocation;
+
+    /** chunked mode */
+    int _chunkSize             = 0;
+    int _chunkCountX           = 0;
+    int _maxResidentChunks     = 64;
+    int _chunkPrefetchDistance = 1;
+    std::vector<TileChunk> _chunks;
+    /** the indices of the chunks with a vertex buffer, the most recently visible first */
+    std::list<int> _residentChunks;
+    backend::Buffer* _chunkIndexBuffer        = nullptr;
+    backend::ProgramState* _chunkProgramState = nullptr;
 };
 
 /** @brief TMXTileAnimTask represents the frame-tick task of an animated tile.
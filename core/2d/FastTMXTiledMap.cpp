@@ -27,7 +27,11 @@ THE SOFTWARE.
 ****************************************************************************/
 #include "2d/FastTMXTiledMap.h"
 #include "2d/FastTMXLayer.h"
+#include "base/Director.h"
+#include "base/JobSystem.h"
+#include "base/Scheduler.h"
 #include "base/UTF8.h"
+#include "renderer/TextureCache.h"
 
 NS_AX_BEGIN
 
@@ -57,6 +61,61 @@ FastTMXTiledMap* FastTMXTiledMap::createWithXML(std::string_view tmxString, std:
     return nullptr;
 }
 
+void FastTMXTiledMap::createAsync(std::string_view tmxFile,
+                                  std::function<void(FastTMXTiledMap*)> callback,
+                                  int chunkSize)
+{
+    AXASSERT(tmxFile.size() > 0, "FastTMXTiledMap: tmx file should not be empty");
+
+    auto director = Director::getInstance();
+    director->getJobSystem()->schedule(
+        [director, file = std::string{tmxFile}, callback = std::move(callback), chunkSize]() {
+            // not autoreleased, the autorelease pool belongs to the GL thread
+            auto mapInfo = new TMXMapInfo();
+            if (!mapInfo->initWithTMXFile(file))
+                AX_SAFE_RELEASE_NULL(mapInfo);
+
+            director->getScheduler()->runOnAxmolThread([director, mapInfo, file, callback, chunkSize]() {
+                if (!mapInfo || mapInfo->getTilesets().empty())
+                {
+                    AXLOGW("FastTMXTiledMap: failed to load {}", file);
+                    AX_SAFE_RELEASE(mapInfo);
+                    callback(nullptr);
+                    return;
+                }
+
+                auto build = [mapInfo, file, callback, chunkSize]() {
+                    auto map = new FastTMXTiledMap();
+                    map->setContentSize(Vec2::ZERO);
+                    map->_chunkSize = chunkSize;
+                    map->buildWithMapInfo(mapInfo);
+                    map->_tmxFile = file;
+                    map->autorelease();
+                    mapInfo->release();
+                    callback(map);
+                };
+
+                std::vector<std::string> images;
+                for (auto&& tileset : mapInfo->getTilesets())
+                {
+                    if (!tileset->_sourceImage.empty())
+                        images.emplace_back(tileset->_sourceImage);
+                }
+                if (images.empty())
+                {
+                    build();
+                    return;
+                }
+                director->getTextureCache()->preloadImagesAsync(
+                    images, [build](Texture2D*, size_t loaded, size_t total) {
+                        if (loaded == total)
+                            build();
+                    });
+            });
+        },
+        JobPriority::Background);
+}
+
 bool FastTMXTiledMap::initWithTMXFile(std::string_view tmxFile)
 {
     AXASSERT(tmxFile.size() > 0, "FastTMXTiledMap: tmx file should not be empty");
@@ -107,6 +166,7 @@ FastTMXLayer* FastTMXTiledMap::parseLayer(TMXLayerInfo* layerInfo, TMXMapInfo* m
 
     // tell the layerinfo to release the ownership of the tiles map.
     layerInfo->_ownTiles = false;
+    layer->setChunkSize(_chunkSize);
     layer->setupTiles();
 
     return layer;
@@ -280,6 +340,19 @@ void FastTMXTiledMap::setTileAnimEnabled(bool enabled)
     }
 }
 
+void FastTMXTiledMap::setChunkSize(int chunkSize)
+{
+    _chunkSize = chunkSize;
+    for (auto&& child : _children)
+    {
+        FastTMXLayer* layer = dynamic_cast<FastTMXLayer*>(child);
+        if (layer)
+        {
+            layer->setChunkSize(chunkSize);
+        }
+    }
+}
+
 TMXTilesetInfo* FastTMXTiledMap::getTilesetInfo(std::string_view tsxNameString)
 {
     if (_mapInfo == nullptr)
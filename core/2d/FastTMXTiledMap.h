@@ -111,6 +111,18 @@ public:
      */
     static FastTMXTiledMap* createWithXML(std::string_view tmxString, std::string_view resourcePath);
 
+    /** Loads a TMX file in the background and creates a TMX Tiled Map with its layers in chunked mode.
+     * The file is parsed and the tiles are decoded on a JobSystem worker, the tileset textures are loaded with
+     * TextureCache::preloadImagesAsync, then the map is created in the GL thread.
+     *
+     * @param tmxFile A TMX file.
+     * @param callback Called in the GL thread with the autoreleased map, or nullptr if the file failed to load.
+     * @param chunkSize The chunk size of the layers, see FastTMXLayer::setChunkSize, 0 to build the whole layers.
+     */
+    static void createAsync(std::string_view tmxFile,
+                            std::function<void(FastTMXTiledMap*)> callback,
+                            int chunkSize = 32);
+
     /** Return the FastTMXLayer for the specific layer.
      *
      * @return Return the FastTMXLayer for the specific layer.
@@ -211,6 +223,10 @@ public:
 
     TMXMapInfo* getMapInfo() const { return _mapInfo; }
 
+    /** Sets the chunk size of all the layers, see FastTMXLayer::setChunkSize. Layers are not chunked by default. */
+    void setChunkSize(int chunkSize);
+    int getChunkSize() const { return _chunkSize; }
+
     TMXTilesetInfo* getTilesetInfo(std::string_view tsxNameString);
 
     Vector<ax::FastTMXLayer*> getLayers() const;
@@ -256,6 +272,8 @@ protected:
 
     TMXMapInfo* _mapInfo;
 
+    int _chunkSize = 0;
+
 private:
     AX_DISALLOW_COPY_AND_ASSIGN(FastTMXTiledMap);
 };
@@ -36,6 +36,8 @@ THE SOFTWARE.
 
 #include "xxhash.h"
 #include "base/Director.h"
+#include "base/Trace.h"
+#include "base/JobSystem.h"
 #include "base/Scheduler.h"
 #include "base/EventDispatcher.h"
 #include "base/UTF8.h"
@@ -44,6 +46,7 @@ THE SOFTWARE.
 #include "2d/Scene.h"
 #include "2d/Component.h"
 #include "renderer/Material.h"
+#include "renderer/Renderer.h"
 #include "math/TransformUtils.h"
 #include "renderer/backend/ProgramManager.h"
 #include "renderer/backend/ProgramStateRegistry.h"
@@ -89,6 +92,9 @@ Node::Node()
     , _additionalTransform(nullptr)
     , _additionalTransformDirty(false)
     , _transformUpdated(true)
+    , _preparedParentTransform(nullptr)
+    , _preparedFrame(0)
+    , _preparedFlags(0)
     // children (lazy allocs)
     , _childrenIndexer(nullptr)
     // lazy alloc
@@ -257,6 +263,7 @@ void Node::setSkewX(float skewX)
 
     _skewX            = skewX;
     _transformUpdated = _transformDirty = _inverseDirty = true;
+    invalidateParentSubtreeBounds();
 }
 
 float Node::getSkewY() const
@@ -271,6 +278,7 @@ void Node::setSkewY(float skewY)
 
     _skewY            = skewY;
     _transformUpdated = _transformDirty = _inverseDirty = true;
+    invalidateParentSubtreeBounds();
 }
 
 void Node::setLocalZOrder(int z)
@@ -323,6 +331,7 @@ void Node::setRotation(float rotation)
 
     _rotationZ_X = _rotationZ_Y = rotation;
     _transformUpdated = _transformDirty = _inverseDirty = true;
+    invalidateParentSubtreeBounds();
 
     updateRotationQuat();
 }
@@ -338,6 +347,7 @@ void Node::setRotation3D(const Vec3& rotation)
         return;
 
     _transformUpdated = _transformDirty = _inverseDirty = true;
+    invalidateParentSubtreeBounds();
 
     _rotationX = rotation.x;
     _rotationY = rotation.y;
@@ -391,6 +401,7 @@ void Node::setRotationQuat(const Quaternion& quat)
     _rotationQuat = quat;
     updateRotation3D();
     _transformUpdated = _transformDirty = _inverseDirty = true;
+    invalidateParentSubtreeBounds();
 }
 
 Quaternion Node::getRotationQuat() const
@@ -405,6 +416,7 @@ void Node::setRotationSkewX(float rotationX)
 
     _rotationZ_X      = rotationX;
     _transformUpdated = _transformDirty = _inverseDirty = true;
+    invalidateParentSubtreeBounds();
 
     updateRotationQuat();
 }
@@ -421,6 +433,7 @@ void Node::setRotationSkewY(float rotationY)
 
     _rotationZ_Y      = rotationY;
     _transformUpdated = _transformDirty = _inverseDirty = true;
+    invalidateParentSubtreeBounds();
 
     updateRotationQuat();
 }
@@ -440,6 +453,7 @@ void Node::setScale(float scale)
 
     _scaleX = _scaleY = _scaleZ = scale;
     _transformUpdated = _transformDirty = _inverseDirty = true;
+    invalidateParentSubtreeBounds();
 }
 
 /// scaleX getter
@@ -457,6 +471,7 @@ void Node::setScale(float scaleX, float scaleY)
     _scaleX           = scaleX;
     _scaleY           = scaleY;
     _transformUpdated = _transformDirty = _inverseDirty = true;
+    invalidateParentSubtreeBounds();
 }
 
 /// scaleX setter
@@ -467,6 +482,7 @@ void Node::setScaleX(float scaleX)
 
     _scaleX           = scaleX;
     _transformUpdated = _transformDirty = _inverseDirty = true;
+    invalidateParentSubtreeBounds();
 }
 
 /// scaleY getter
@@ -483,6 +499,7 @@ void Node::setScaleZ(float scaleZ)
 
     _scaleZ           = scaleZ;
     _transformUpdated = _transformDirty = _inverseDirty = true;
+    invalidateParentSubtreeBounds();
 }
 
 /// scaleY getter
@@ -499,6 +516,7 @@ void Node::setScaleY(float scaleY)
 
     _scaleY           = scaleY;
     _transformUpdated = _transformDirty = _inverseDirty = true;
+    invalidateParentSubtreeBounds();
 }
 
 /// position getter
@@ -528,6 +546,7 @@ void Node::setPosition(float x, float y)
     _position.y = y;
 
     _transformUpdated = _transformDirty = _inverseDirty = true;
+    invalidateParentSubtreeBounds();
     _usingNormalizedPosition                            = false;
 }
 
@@ -573,6 +592,7 @@ void Node::setPositionZ(float positionZ)
         return;
 
     _transformUpdated = _transformDirty = _inverseDirty = true;
+    invalidateParentSubtreeBounds();
 
     _positionZ = positionZ;
 }
@@ -593,6 +613,7 @@ void Node::setPositionNormalized(const Vec2& position)
     _usingNormalizedPosition = true;
     _normalizedPositionDirty = true;
     _transformUpdated = _transformDirty = _inverseDirty = true;
+    invalidateParentSubtreeBounds();
 }
 
 ssize_t Node::getChildrenCount() const
@@ -635,6 +656,7 @@ void Node::setAnchorPoint(const Vec2& point)
         _anchorPoint = point;
         _anchorPointInPoints.set(_contentSize.width * _anchorPoint.x, _contentSize.height * _anchorPoint.y);
         _transformUpdated = _transformDirty = _inverseDirty = true;
+        invalidateParentSubtreeBounds();
     }
 }
 
@@ -652,6 +674,7 @@ void Node::setContentSize(const Vec2& size)
 
         _anchorPointInPoints.set(_contentSize.width * _anchorPoint.x, _contentSize.height * _anchorPoint.y);
         _transformUpdated = _transformDirty = _inverseDirty = _contentSizeDirty = true;
+        invalidateSubtreeBounds();
     }
 }
 
@@ -671,9 +694,11 @@ bool Node::isRunning() const
 /// parent setter
 void Node::setParent(Node* parent)
 {
+    invalidateParentSubtreeBounds();
     _parent           = parent;
     _normalizedPositionDirty = true;
     _transformUpdated = _transformDirty = _inverseDirty = true;
+    invalidateParentSubtreeBounds();
 }
 
 /// isRelativeAnchorPoint getter
@@ -689,6 +714,7 @@ void Node::setIgnoreAnchorPointForPosition(bool newValue)
     {
         _ignoreAnchorPointForPosition = newValue;
         _transformUpdated = _transformDirty = _inverseDirty = true;
+        invalidateParentSubtreeBounds();
     }
 }
 
@@ -1230,17 +1256,34 @@ void Node::visit()
 
 uint32_t Node::processParentFlags(const Mat4& parentTransform, uint32_t parentFlags)
 {
+    // already updated by the transform pass of this frame, only consume its flags unless it was dirtied since: by
+    // the visit itself (AttachNode forces its flags), by changing the node or by the parent recomputing its transform
+    bool prepared = _preparedParentTransform == &parentTransform && _preparedFrame == _director->getTotalFrames();
+    if (prepared && ((parentFlags & FLAGS_DIRTY_MASK & ~_preparedFlags) || _transformDirty ||
+                     _normalizedPositionDirty || (_parent && !_parent->_preparedParentTransform)))
+        prepared = false;
+
+    if (prepared)
+    {
+        if (!isVisitableByVisitingCamera())
+            return parentFlags;
+
+        uint32_t flags    = parentFlags | _preparedFlags;
+        _preparedFlags    = 0;
+        _transformUpdated = false;
+        _contentSizeDirty = false;
+        if (_hitTestListeners > 0 && (flags & FLAGS_DIRTY_MASK))
+            _eventDispatcher->invalidateHitTestBounds(this);
+        return flags;
+    }
+    // the children can't rely on the transform pass either
+    _preparedParentTransform = nullptr;
+
     if (_usingNormalizedPosition)
     {
         AXASSERT(_parent, "setPositionNormalized() doesn't work with orphan nodes");
         if ((parentFlags & FLAGS_CONTENT_SIZE_DIRTY) || _normalizedPositionDirty)
-        {
-            auto& s           = _parent->getContentSize();
-            _position.x       = _normalizedPosition.x * s.width;
-            _position.y       = _normalizedPosition.y * s.height;
-            _transformUpdated = _transformDirty = _inverseDirty = true;
-            _normalizedPositionDirty                            = false;
-        }
+            updateNormalizedPosition();
     }
 
     // Fixes Github issue #16100. Basically when having two cameras, one camera might set as dirty the
@@ -1253,14 +1296,196 @@ uint32_t Node::processParentFlags(const Mat4& parentTransform, uint32_t parentFl
     flags |= (_contentSizeDirty ? FLAGS_CONTENT_SIZE_DIRTY : 0);
 
     if (flags & FLAGS_DIRTY_MASK)
+    {
         _modelViewTransform = this->transform(parentTransform);
 
+        // touches are hit-tested against what was drawn, so moving the node only moves its touch area from here
+        if (_hitTestListeners > 0)
+            _eventDispatcher->invalidateHitTestBounds(this);
+    }
+
     _transformUpdated = false;
     _contentSizeDirty = false;
 
     return flags;
 }
 
+void Node::updateNormalizedPosition()
+{
+    auto& s           = _parent->getContentSize();
+    _position.x       = _normalizedPosition.x * s.width;
+    _position.y       = _normalizedPosition.y * s.height;
+    _transformUpdated = _transformDirty = _inverseDirty = true;
+    _normalizedPositionDirty                            = false;
+}
+
+uint32_t Node::prepareTransform(const Mat4& parentTransform, uint32_t parentFlags, unsigned int frame)
+{
+    if (_usingNormalizedPosition)
+    {
+        AXASSERT(_parent, "setPositionNormalized() doesn't work with orphan nodes");
+        if ((parentFlags & FLAGS_CONTENT_SIZE_DIRTY) || _normalizedPositionDirty)
+            updateNormalizedPosition();
+    }
+
+    uint32_t flags = parentFlags;
+    flags |= (_transformUpdated ? FLAGS_TRANSFORM_DIRTY : 0);
+    flags |= (_contentSizeDirty ? FLAGS_CONTENT_SIZE_DIRTY : 0);
+
+    if (flags & FLAGS_DIRTY_MASK)
+        _modelViewTransform = this->transform(parentTransform);
+
+    // the dirty flags are cleared by processParentFlags, when visited by a camera
+    _preparedParentTransform = &parentTransform;
+    _preparedFrame           = frame;
+    _preparedFlags           = flags;
+
+    return flags;
+}
+
+void Node::prepareSubtreeTransforms(const Mat4& parentTransform,
+                                    uint32_t parentFlags,
+                                    unsigned int frame,
+                                    std::vector<PendingTransform>* pending)
+{
+    if (!_visible)
+        return;
+
+    uint32_t flags = prepareTransform(parentTransform, parentFlags, frame);
+
+    if (pending)
+    {
+        for (auto child : _children)
+            pending->emplace_back(child, flags);
+    }
+    else
+    {
+        for (auto child : _children)
+            child->prepareSubtreeTransforms(_modelViewTransform, flags, frame, nullptr);
+    }
+}
+
+void Node::prepareTransforms(const Mat4& parentTransform, uint32_t parentFlags)
+{
+    const auto frame = _director->getTotalFrames();
+
+    // expand the tree breadth first until there are enough subtrees to keep the workers busy
+    auto jobSystem         = _director->getJobSystem();
+    const size_t parallels = static_cast<size_t>(jobSystem->getWorkerCount()) + 1;
+    std::vector<PendingTransform> pending, next;
+    prepareSubtreeTransforms(parentTransform, parentFlags, frame, &pending);
+    while (!pending.empty() && pending.size() < parallels * 4)
+    {
+        next.clear();
+        for (auto& [node, flags] : pending)
+            node->prepareSubtreeTransforms(node->_parent->_modelViewTransform, flags, frame, &next);
+        pending.swap(next);
+    }
+
+    if (pending.empty())
+        return;
+
+    constexpr size_t CHUNK_SIZE = 8;
+    jobSystem->parallel_for(0, pending.size(), CHUNK_SIZE, [&pending, frame](size_t first, size_t last) {
+        for (; first != last; ++first)
+        {
+            auto& [node, flags] = pending[first];
+            node->prepareSubtreeTransforms(node->_parent->_modelViewTransform, flags, frame, nullptr);
+        }
+    });
+}
+
+void Node::setSubtreeCullingEnabled(bool enabled)
+{
+    if (enabled == _subtreeCullingEnabled)
+        return;
+
+    _subtreeCullingEnabled = enabled;
+    _culledFlags           = 0;
+    invalidateSubtreeBounds();
+}
+
+void Node::invalidateSubtreeBounds()
+{
+    // stops at the first outdated node, its ancestors are already outdated
+    for (auto node = this; node && !node->_subtreeBoundsDirty; node = node->_parent)
+        node->_subtreeBoundsDirty = true;
+}
+
+const Rect& Node::getSubtreeBounds()
+{
+    if (_subtreeBoundsDirty)
+    {
+        bool empty        = true;
+        _subtreeNodeCount = 0;
+        mergeSubtreeBounds(Mat4::IDENTITY, _subtreeBounds, empty, _subtreeNodeCount);
+    }
+    return _subtreeBounds;
+}
+
+void Node::mergeSubtreeBounds(const Mat4& transform, Rect& bounds, bool& empty, unsigned int& count)
+{
+    // the descendants are traversed too, so their bounds are up to date once merged
+    _subtreeBoundsDirty = false;
+    ++count;
+
+    auto rect = RectApplyTransform(Rect(Vec2::ZERO, _contentSize), transform);
+    if (empty)
+        bounds = rect;
+    else
+        bounds.merge(rect);
+    empty = false;
+
+    for (auto child : _children)
+        mergeChildSubtreeBounds(child, transform, bounds, empty, count);
+}
+
+void Node::mergeChildSubtreeBounds(Node* child,
+                                   const Mat4& parentTransform,
+                                   Rect& bounds,
+                                   bool& empty,
+                                   unsigned int& count)
+{
+    // the normalized positions are updated by visit, which didn't reach the child yet
+    if (child->_usingNormalizedPosition)
+        child->updateNormalizedPosition();
+
+    Mat4 transform = parentTransform * child->getNodeToParentTransform();
+    if (child->_subtreeCullingEnabled)
+    {
+        // nested culling nodes keep their own bounds
+        auto rect = RectApplyTransform(child->getSubtreeBounds(), transform);
+        if (empty)
+            bounds = rect;
+        else
+            bounds.merge(rect);
+        empty = false;
+        count += child->_subtreeNodeCount;
+    }
+    else
+    {
+        child->mergeSubtreeBounds(transform, bounds, empty, count);
+    }
+}
+
+bool Node::cullSubtree(Renderer* renderer, uint32_t& flags)
+{
+    if (!_subtreeCullingEnabled)
+        return false;
+
+    if (!renderer->checkVisibility(_modelViewTransform, getSubtreeBounds()))
+    {
+        // the descendants aren't visited, keep the dirty flags for them
+        _culledFlags |= flags & FLAGS_DIRTY_MASK;
+        renderer->addCulledNodes(_subtreeNodeCount);
+        return true;
+    }
+
+    flags |= _culledFlags;
+    _culledFlags = 0;
+    return false;
+}
+
 bool Node::isVisitableByVisitingCamera() const
 {
     auto camera          = Camera::getVisitingCamera();
@@ -1276,13 +1501,23 @@ void Node::visit(Renderer* renderer, const Mat4& parentTransform, uint32_t paren
         return;
     }
 
+    AX_TRACE_SCOPE("Node::visit");
+
+    renderer->addVisitedNodes(1);
+
     uint32_t flags = processParentFlags(parentTransform, parentFlags);
+    if (cullSubtree(renderer, flags))
+        return;
 
     // IMPORTANT:
     // To ease the migration to v3.0, we still support the Mat4 stack,
     // but it is deprecated and your code should not rely on it
-    _director->pushMatrix(MATRIX_STACK_TYPE::MATRIX_STACK_MODELVIEW);
-    _director->loadMatrix(MATRIX_STACK_TYPE::MATRIX_STACK_MODELVIEW, _modelViewTransform);
+    const bool matrixStackEnabled = _director->isMatrixStackEnabled();
+    if (matrixStackEnabled)
+    {
+        _director->pushMatrix(MATRIX_STACK_TYPE::MATRIX_STACK_MODELVIEW);
+        _director->loadMatrix(MATRIX_STACK_TYPE::MATRIX_STACK_MODELVIEW, _modelViewTransform);
+    }
 
     bool visibleByCamera = isVisitableByVisitingCamera();
 
@@ -1313,7 +1548,8 @@ void Node::visit(Renderer* renderer, const Mat4& parentTransform, uint32_t paren
         this->draw(renderer, _modelViewTransform, flags);
     }
 
-    _director->popMatrix(MATRIX_STACK_TYPE::MATRIX_STACK_MODELVIEW);
+    if (matrixStackEnabled)
+        _director->popMatrix(MATRIX_STACK_TYPE::MATRIX_STACK_MODELVIEW);
 
     // FIX ME: Why need to set _orderOfArrival to 0??
     // Please refer to https://github.com/cocos2d/cocos2d-x/pull/6920
@@ -1802,6 +2038,7 @@ void Node::setNodeToParentTransform(const Mat4& transform)
     _transform        = transform;
     _transformDirty   = false;
     _transformUpdated = true;
+    invalidateParentSubtreeBounds();
 
     if (_additionalTransform)
         // _additionalTransform[1] has a copy of lastest transform
@@ -1837,6 +2074,7 @@ void Node::setAdditionalTransform(const Mat4* additionalTransform)
         _additionalTransform[0] = *additionalTransform;
     }
     _transformUpdated = _additionalTransformDirty = _inverseDirty = true;
+    invalidateParentSubtreeBounds();
 }
 
 void Node::setAdditionalTransform(const Mat4& additionalTransform)
@@ -1141,6 +1141,56 @@ public:
     virtual void visit(Renderer* renderer, const Mat4& parentTransform, uint32_t parentFlags);
     virtual void visit();
 
+    /**
+     * Updates the model view transforms of this node and its descendants ahead of visiting them.
+     * Large trees are split into subtrees which are updated in parallel on the JobSystem, the following
+     * visit only submits render commands.
+     *
+     * @param parentTransform The transform matrix the node will be visited with.
+     * @param parentFlags Renderer flag.
+     * @see Director::setTransformPassEnabled
+     */
+    void prepareTransforms(const Mat4& parentTransform, uint32_t parentFlags);
+
+    /// A node and the flags of its parent, pending for the transform pass.
+    using PendingTransform = std::pair<Node*, uint32_t>;
+
+    /**
+     * Updates the model view transforms of this node and its descendants, used by prepareTransforms.
+     * If pending isn't null, the children are appended to it instead of being updated. Override it doing nothing to
+     * leave the subtree to the visit.
+     * @lua NA
+     */
+    virtual void prepareSubtreeTransforms(const Mat4& parentTransform,
+                                          uint32_t parentFlags,
+                                          unsigned int frame,
+                                          std::vector<PendingTransform>* pending);
+
+    /**
+     * Enables/disables culling this node and its descendants as a whole, disabled by default.
+     * When enabled, visit skips the entire subtree while its bounds are outside the visible rect of the default
+     * camera. The bounds are cached in this node's coordinates and only recomputed after a descendant was moved,
+     * resized, added or removed, so moving this node or its ancestors (e.g. scrolling a map) keeps them valid.
+     * Only enable it when the descendants draw within their content sizes.
+     *
+     * @param enabled Whether the subtree is culled.
+     * @see Renderer::getCulledNodes
+     */
+    void setSubtreeCullingEnabled(bool enabled);
+    bool isSubtreeCullingEnabled() const { return _subtreeCullingEnabled; }
+
+    /**
+     * Returns the bounds of the content of this node and its descendants, in this node's coordinates.
+     * Nested nodes with subtree culling enabled contribute the transformed box of their own bounds.
+     */
+    const Rect& getSubtreeBounds();
+
+    /**
+     * Marks the subtree bounds of this node and its ancestors as outdated.
+     * Call it when the content of a node changes without changing its transform or content size.
+     */
+    void invalidateSubtreeBounds();
+
     /** Returns the Scene that contains the Node.
      It returns `nullptr` if the node doesn't belong to any Scene.
      This function recursively calls parent->getScene() until parent is a Scene object. The results are not cached. It
@@ -1489,7 +1539,8 @@ public:
 
     /**
      * Returns the matrix that transform the node's (local) space coordinates into the parent's space coordinates.
-     * The matrix is in Pixels.
+     * The matrix is in Pixels. Overrides may be called from the JobSystem workers, see
+     * Director::setTransformPassEnabled.
      *
      * @return The transformation matrix.
      */
@@ -1878,6 +1929,28 @@ protected:
     Mat4 transform(const Mat4& parentTransform);
     uint32_t processParentFlags(const Mat4& parentTransform, uint32_t parentFlags);
 
+    /// Returns true if the subtree is culled, otherwise adds the flags the descendants missed while culled.
+    bool cullSubtree(Renderer* renderer, uint32_t& flags);
+
+    /// Merges the bounds of this node and its descendants, transformed by transform, used by getSubtreeBounds.
+    virtual void mergeSubtreeBounds(const Mat4& transform, Rect& bounds, bool& empty, unsigned int& count);
+    void mergeChildSubtreeBounds(Node* child,
+                                 const Mat4& parentTransform,
+                                 Rect& bounds,
+                                 bool& empty,
+                                 unsigned int& count);
+
+    void invalidateParentSubtreeBounds()
+    {
+        if (_parent)
+            _parent->invalidateSubtreeBounds();
+    }
+
+    void updateNormalizedPosition();
+
+    /// Updates the model view transform of this node ahead of visiting it, returns the flags for its children.
+    uint32_t prepareTransform(const Mat4& parentTransform, uint32_t parentFlags, unsigned int frame);
+
     virtual void updateCascadeOpacity();
     virtual void disableCascadeOpacity();
     virtual void updateCascadeColor();
@@ -1931,6 +2004,20 @@ protected:
     Vec2 _contentSize;  ///< untransformed size of the node
 
     Mat4 _modelViewTransform;  ///< ModelView transform of the Node.
+
+    const Mat4* _preparedParentTransform;  ///< the parent transform used by the transform pass
+    unsigned int _preparedFrame;           ///< the frame the transform pass updated this node
+    uint32_t _preparedFlags;               ///< the flags computed by the transform pass, consumed by visit
+
+    Rect _subtreeBounds;                  ///< cached bounds of the subtree, in this node's coordinates
+    unsigned int _subtreeNodeCount = 0;   ///< number of nodes in the subtree, for the culling stats
+    uint32_t _culledFlags          = 0;   ///< dirty flags the children missed while the subtree was culled
+    bool _subtreeBoundsDirty       = true;
+    bool _subtreeCullingEnabled    = false;
+
+    unsigned int _hitTestListeners = 0;  ///< number of touch listeners in the hit-test index of the EventDispatcher
+    friend class EventDispatcher;
+
     // "cache" variables are allowed to be mutable
     mutable Mat4 _transform;             ///< transform
     mutable Mat4 _inverse;               ///< inverse transform
@@ -52,7 +52,7 @@ THE SOFTWARE.
 #include "renderer/TextureAtlas.h"
 #include "base/ZipUtils.h"
 #include "base/Director.h"
-#include "base/Profiling.h"
+#include "base/Trace.h"
 #include "base/UTF8.h"
 #include "base/Utils.h"
 #include "renderer/TextureCache.h"
@@ -1554,7 +1554,7 @@ void ParticleSystem::update(float dt)
     if (!_visible)
         return;
 
-    AX_PROFILER_START_CATEGORY(kProfilerCategoryParticles, "CCParticleSystem - update");
+    AX_TRACE_SCOPE("ParticleSystem::update");
 
     if (_componentContainer && !_componentContainer->isEmpty())
     {
@@ -1568,7 +1568,6 @@ void ParticleSystem::update(float dt)
         {
             updateParticleQuads();
             _transformSystemDirty = false;
-            AX_PROFILER_STOP_CATEGORY(kProfilerCategoryParticles, "CCParticleSystem - update");
             return;
         }
         dt             = _fixedFPSDelta;
@@ -1833,8 +1832,6 @@ void ParticleSystem::update(float dt)
     {
         postStep();
     }
-
-    AX_PROFILER_STOP_CATEGORY(kProfilerCategoryParticles, "CCParticleSystem - update");
 }
 
 void ParticleSystem::updateWithNoTime()
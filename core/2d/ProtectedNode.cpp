@@ -31,6 +31,7 @@
 
 #include "base/Director.h"
 #include "2d/Scene.h"
+#include "renderer/Renderer.h"
 
 NS_AX_BEGIN
 
@@ -270,6 +271,14 @@ void ProtectedNode::reorderProtectedChild(ax::Node* child, int localZOrder)
     child->setLocalZOrder(localZOrder);
 }
 
+void ProtectedNode::mergeSubtreeBounds(const Mat4& transform, Rect& bounds, bool& empty, unsigned int& count)
+{
+    Node::mergeSubtreeBounds(transform, bounds, empty, count);
+
+    for (auto child : _protectedChildren)
+        mergeChildSubtreeBounds(child, transform, bounds, empty, count);
+}
+
 void ProtectedNode::visit(Renderer* renderer, const Mat4& parentTransform, uint32_t parentFlags)
 {
     // quick return if not visible. children won't be drawn.
@@ -278,13 +287,21 @@ void ProtectedNode::visit(Renderer* renderer, const Mat4& parentTransform, uint3
         return;
     }
 
+    renderer->addVisitedNodes(1);
+
     uint32_t flags = processParentFlags(parentTransform, parentFlags);
+    if (cullSubtree(renderer, flags))
+        return;
 
     // IMPORTANT:
     // To ease the migration to v3.0, we still support the Mat4 stack,
     // but it is deprecated and your code should not rely on it
-    _director->pushMatrix(MATRIX_STACK_TYPE::MATRIX_STACK_MODELVIEW);
-    _director->loadMatrix(MATRIX_STACK_TYPE::MATRIX_STACK_MODELVIEW, _modelViewTransform);
+    const bool matrixStackEnabled = _director->isMatrixStackEnabled();
+    if (matrixStackEnabled)
+    {
+        _director->pushMatrix(MATRIX_STACK_TYPE::MATRIX_STACK_MODELVIEW);
+        _director->loadMatrix(MATRIX_STACK_TYPE::MATRIX_STACK_MODELVIEW, _modelViewTransform);
+    }
 
     int i = 0;  // used by _children
     int j = 0;  // used by _protectedChildren
@@ -334,7 +351,32 @@ void ProtectedNode::visit(Renderer* renderer, const Mat4& parentTransform, uint3
     // Please refer to https://github.com/cocos2d/cocos2d-x/pull/6920
     // setOrderOfArrival(0);
 
-    _director->popMatrix(MATRIX_STACK_TYPE::MATRIX_STACK_MODELVIEW);
+    if (matrixStackEnabled)
+        _director->popMatrix(MATRIX_STACK_TYPE::MATRIX_STACK_MODELVIEW);
+}
+
+void ProtectedNode::prepareSubtreeTransforms(const Mat4& parentTransform,
+                                             uint32_t parentFlags,
+                                             unsigned int frame,
+                                             std::vector<PendingTransform>* pending)
+{
+    if (!_visible)
+        return;
+
+    Node::prepareSubtreeTransforms(parentTransform, parentFlags, frame, pending);
+
+    // the flags passed to children by Node::prepareSubtreeTransforms
+    uint32_t flags = _preparedFlags;
+    if (pending)
+    {
+        for (auto child : _protectedChildren)
+            pending->emplace_back(child, flags);
+    }
+    else
+    {
+        for (auto child : _protectedChildren)
+            child->prepareSubtreeTransforms(_modelViewTransform, flags, frame, nullptr);
+    }
 }
 
 void ProtectedNode::onEnter()
@@ -162,6 +162,11 @@ public:
      */
     virtual void visit(Renderer* renderer, const Mat4& parentTransform, uint32_t parentFlags) override;
 
+    virtual void prepareSubtreeTransforms(const Mat4& parentTransform,
+                                          uint32_t parentFlags,
+                                          unsigned int frame,
+                                          std::vector<PendingTransform>* pending) override;
+
     virtual void cleanup() override;
 
     virtual void onEnter() override;
@@ -206,6 +211,8 @@ protected:
     /// helper that reorder a child
     void insertProtectedChild(Node* child, int z);
 
+    virtual void mergeSubtreeBounds(const Mat4& transform, Rect& bounds, bool& empty, unsigned int& count) override;
+
     Vector<Node*> _protectedChildren;  ///< array of children nodes
     bool _reorderProtectedChildDirty;
 
@@ -35,6 +35,10 @@ THE SOFTWARE.
 #include "base/UTF8.h"
 #include "renderer/Renderer.h"
 
+#if defined(AX_ENABLE_3D)
+#    include "3d/MeshRenderer.h"
+#endif
+
 #if defined(AX_ENABLE_PHYSICS)
 #    include "physics/PhysicsWorld.h"
 #endif
@@ -214,6 +218,12 @@ void Scene::render(Renderer* renderer, const Mat4& eyeTransform, const Mat4* eye
         camera->apply();
         // clear background with max depth
         camera->clearBackground();
+#if defined(AX_ENABLE_3D)
+        camera->_culledMeshes = 0;
+#    if AX_USE_CULLING
+        MeshRenderer::cullMeshRenderers(_meshRenderers.data(), _meshRenderers.size(), camera);
+#    endif
+#endif
         // visit the scene
         visit(renderer, transform, 0);
 #if defined(AX_ENABLE_NAVMESH)
@@ -348,6 +358,31 @@ bool Scene::initWithPhysics()
     return initPhysicsWorld();
 }
 
+#    if defined(AX_ENABLE_3D_PHYSICS) && AX_ENABLE_BULLET_INTEGRATION
+Scene* Scene::createWithPhysics(Physics3DWorldDes* physics3DInfo)
+{
+    Scene* ret = new Scene();
+    if (ret->initWithPhysics(physics3DInfo))
+    {
+        ret->autorelease();
+        return ret;
+    }
+    else
+    {
+        AX_SAFE_DELETE(ret);
+        return nullptr;
+    }
+}
+
+bool Scene::initWithPhysics(Physics3DWorldDes* physics3DInfo)
+{
+    _physics3DInfo = physics3DInfo;
+    bool ret       = initWithPhysics();
+    _physics3DInfo = nullptr;
+    return ret;
+}
+#    endif
+
 bool Scene::initPhysicsWorld()
 {
 #    if defined(AX_ENABLE_PHYSICS)
@@ -361,7 +396,7 @@ bool Scene::initPhysicsWorld()
 
 #    if defined(AX_ENABLE_3D_PHYSICS) && AX_ENABLE_BULLET_INTEGRATION
         Physics3DWorldDes info;
-        AX_BREAK_IF(!(_physics3DWorld = Physics3DWorld::create(&info)));
+        AX_BREAK_IF(!(_physics3DWorld = Physics3DWorld::create(_physics3DInfo ? _physics3DInfo : &info)));
         _physics3DWorld->retain();
 #    endif
 
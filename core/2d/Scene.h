@@ -37,6 +37,7 @@ NS_AX_BEGIN
 
 class Camera;
 class BaseLight;
+class MeshRenderer;
 class Renderer;
 class EventListenerCustom;
 class EventCustom;
@@ -45,6 +46,7 @@ class PhysicsWorld;
 #endif
 #if defined(AX_ENABLE_3D_PHYSICS) && AX_ENABLE_BULLET_INTEGRATION
 class Physics3DWorld;
+struct Physics3DWorldDes;
 #endif
 #if defined(AX_ENABLE_NAVMESH)
 class NavMesh;
@@ -140,6 +142,7 @@ protected:
     friend class SpriteBatchNode;
     friend class Camera;
     friend class BaseLight;
+    friend class MeshRenderer;
     friend class Renderer;
 
     std::vector<Camera*> _cameras;     // weak ref to Camera
@@ -152,6 +155,7 @@ protected:
     EventListenerCustom* _event;
 
     std::vector<BaseLight*> _lights;
+    std::vector<MeshRenderer*> _meshRenderers;  // weak ref, the MeshRenderers tested in batch by each camera
 
 private:
     AX_DISALLOW_COPY_AND_ASSIGN(Scene);
@@ -177,6 +181,14 @@ public:
      * Set Physics3D debug draw camera.
      */
     void setPhysics3DDebugCamera(Camera* camera);
+
+    /** Create a scene with physics, the 3d physics world is created from the description.
+     * @return An autoreleased Scene object with physics.
+     * @js NA
+     */
+    static Scene* createWithPhysics(Physics3DWorldDes* physics3DInfo);
+
+    bool initWithPhysics(Physics3DWorldDes* physics3DInfo);
 #    endif
 
     /** Create a scene with physics.
@@ -197,8 +209,9 @@ protected:
 #    endif
 
 #    if defined(AX_ENABLE_3D_PHYSICS) && AX_ENABLE_BULLET_INTEGRATION
-    Physics3DWorld* _physics3DWorld = nullptr;
-    Camera* _physics3dDebugCamera   = nullptr;
+    Physics3DWorld* _physics3DWorld   = nullptr;
+    Camera* _physics3dDebugCamera     = nullptr;
+    Physics3DWorldDes* _physics3DInfo = nullptr;  // the description used by initPhysicsWorld, null for the default
 #    endif
 #endif  // (defined(AX_ENABLE_PHYSICS) || defined(AX_ENABLE_3D_PHYSICS))
 
@@ -667,8 +667,11 @@ void TMXMapInfo::startElement(void* /*ctx*/, const char* name, const char** atts
     }
     else if (elementName == "animation")
     {
+        // not autoreleased, maps may be parsed on a worker thread, see FastTMXTiledMap::createAsync
         TMXTilesetInfo* info = tmxMapInfo->getTilesets().back();
-        info->_animationInfo.insert(tmxMapInfo->getParentGID(), TMXTileAnimInfo::create(tmxMapInfo->getParentGID()));
+        auto animInfo        = new TMXTileAnimInfo(tmxMapInfo->getParentGID());
+        info->_animationInfo.insert(tmxMapInfo->getParentGID(), animInfo);
+        animInfo->release();
         tmxMapInfo->setParentElement(TMXPropertyAnimation);
     }
     else if (elementName == "frame")
@@ -0,0 +1,359 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+
+#include "2d/TweenBatch.h"
+#include "2d/ActionEase.h"
+#include "2d/ActionInterval.h"
+#include "2d/Node.h"
+
+#include <typeinfo>
+
+NS_AX_BEGIN
+
+TweenBatch::TweenBatch() : _count(0), _removedWhileUpdating(0), _updating(false) {}
+
+TweenBatch::~TweenBatch()
+{
+    clear();
+}
+
+bool TweenBatch::add(Action* action, Node* target, bool paused)
+{
+    AXASSERT(!isBatched(action), "action is already batched!");
+
+    auto interval = dynamic_cast<ActionInterval*>(action);
+    if (interval == nullptr)
+        return false;
+
+    // only the exact classes are batched, a subclass may override update
+    auto easing = tweenfunc::Linear;
+    auto tween  = interval;
+    if (auto ease = dynamic_cast<ActionEase*>(interval))
+    {
+        easing = ease->getTweenType();
+        tween  = ease->getInnerAction();
+        if (easing < tweenfunc::Linear || easing >= static_cast<int>(_lanes.size()) || tween == nullptr)
+            return false;
+    }
+
+    Kind kind;
+    Vec3 from;
+    Vec3 delta;
+    Vec3 previous;
+    auto& type = typeid(*tween);
+    if (type == typeid(MoveTo) || type == typeid(MoveBy))
+    {
+        auto move = static_cast<MoveBy*>(tween);
+        kind      = Kind::Move;
+        from      = move->_startPosition;
+        delta     = move->_positionDelta;
+        previous  = move->_previousPosition;
+    }
+    else if (type == typeid(ScaleTo) || type == typeid(ScaleBy))
+    {
+        auto scale = static_cast<ScaleTo*>(tween);
+        kind       = Kind::Scale;
+        from.set(scale->_startScaleX, scale->_startScaleY, scale->_startScaleZ);
+        delta.set(scale->_deltaX, scale->_deltaY, scale->_deltaZ);
+    }
+    else if (type == typeid(FadeTo) || type == typeid(FadeIn) || type == typeid(FadeOut))
+    {
+        auto fade = static_cast<FadeTo*>(tween);
+        kind      = Kind::Fade;
+        from.x    = fade->_fromOpacity;
+        delta.x   = static_cast<float>(fade->_toOpacity - fade->_fromOpacity);
+    }
+    else if (type == typeid(RotateTo))
+    {
+        auto rotate = static_cast<RotateTo*>(tween);
+        from        = rotate->_startAngle;
+        delta       = rotate->_diffAngle;
+        if (rotate->_is3D)
+            kind = Kind::Rotate3D;
+#if defined(AX_ENABLE_PHYSICS)
+        else if (from.x == from.y && delta.x == delta.y)
+            kind = Kind::Rotate;
+#endif
+        else
+            kind = Kind::RotateSkew;
+    }
+    else
+    {
+        return false;
+    }
+
+    auto& lane          = _lanes[easing];
+    action->_tweenBatch = this;
+    action->_tweenLane  = easing;
+    action->_tweenIndex = static_cast<int>(lane.actions.size());
+
+    lane.actions.push_back(action);
+    lane.targets.push_back(target);
+    lane.kinds.push_back(kind);
+    lane.flags.push_back(static_cast<uint8_t>(paused ? FIRST_TICK | PAUSED : FIRST_TICK));
+    lane.elapsed.push_back(0.0f);
+    lane.durations.push_back(interval->getDuration());
+    lane.times.push_back(0.0f);
+    lane.from.push_back(from);
+    lane.deltas.push_back(delta);
+    lane.previous.push_back(previous);
+    lane.values.push_back(Vec3::ZERO);
+    ++_count;
+
+    return true;
+}
+
+void TweenBatch::remove(Action* action)
+{
+    if (action->_tweenBatch != this)
+        return;
+
+    auto& lane = _lanes[action->_tweenLane];
+    auto index = static_cast<size_t>(action->_tweenIndex);
+    writeBack(lane, index);
+
+    action->_tweenBatch = nullptr;
+    action->_tweenLane  = -1;
+    action->_tweenIndex = -1;
+    if (_updating)
+    {
+        // the lanes are compacted once they are all written
+        lane.actions[index] = nullptr;
+        lane.flags[index] |= REMOVED;
+        ++_removedWhileUpdating;
+    }
+    else
+    {
+        erase(lane, index);
+    }
+}
+
+void TweenBatch::clear()
+{
+    for (auto& lane : _lanes)
+    {
+        for (size_t i = lane.actions.size(); i-- > 0;)
+        {
+            if (lane.actions[i])
+                remove(lane.actions[i]);
+        }
+    }
+}
+
+void TweenBatch::setPaused(Action* action, bool paused)
+{
+    if (action->_tweenBatch != this)
+        return;
+
+    auto& flags = _lanes[action->_tweenLane].flags[action->_tweenIndex];
+    if (paused)
+        flags |= PAUSED;
+    else
+        flags &= ~PAUSED;
+}
+
+float TweenBatch::getElapsed(const Action* action) const
+{
+    AXASSERT(action->_tweenBatch == this, "action isn't batched here!");
+    return _lanes[action->_tweenLane].elapsed[action->_tweenIndex];
+}
+
+void TweenBatch::update(float dt, std::vector<Action*>& finished, std::vector<Node*>& orphans)
+{
+    _updating = true;
+    for (size_t easing = 0; easing < _lanes.size(); ++easing)
+    {
+        if (!_lanes[easing].actions.empty())
+            updateLane(_lanes[easing], static_cast<tweenfunc::TweenType>(easing), dt, finished, orphans);
+    }
+    _updating = false;
+
+    if (_removedWhileUpdating > 0)
+        purge();
+}
+
+void TweenBatch::updateLane(Lane& lane,
+                            tweenfunc::TweenType easing,
+                            float dt,
+                            std::vector<Action*>& finished,
+                            std::vector<Node*>& orphans)
+{
+    // the setters called while writing may add tweens to this lane, those start on the next update
+    const size_t count = lane.actions.size();
+
+    uint8_t* flags        = lane.flags.data();
+    float* elapsed        = lane.elapsed.data();
+    const float* duration = lane.durations.data();
+    float* times          = lane.times.data();
+
+    // same clock as ActionInterval::step, the first tick evaluates the tween at 0
+    for (size_t i = 0; i < count; ++i)
+        elapsed[i] += flags[i] == 0 ? dt : 0.0f;
+    for (size_t i = 0; i < count; ++i)
+        times[i] = std::max(0.0f, std::min(1.0f, elapsed[i] / duration[i]));
+
+    tweenfunc::tweenTo(times, count, easing);
+
+    const Vec3* deltas = lane.deltas.data();
+    Vec3* values       = lane.values.data();
+    for (size_t i = 0; i < count; ++i)
+        values[i] = deltas[i] * times[i];
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        Node* target = lane.targets[i];
+        if (lane.flags[i] & (PAUSED | REMOVED))
+        {
+            // same as the ActionManager, which releases the targets nobody else holds even while paused
+            if (!(lane.flags[i] & REMOVED) && target->getReferenceCount() == 1)
+                orphans.push_back(target);
+            continue;
+        }
+        lane.flags[i] = 0;
+
+        // copied, the setters may add tweens to this lane
+        const Vec3 from  = lane.from[i];
+        const Vec3 value = lane.values[i];
+        switch (lane.kinds[i])
+        {
+        case Kind::Move:
+        {
+#if AX_ENABLE_STACKABLE_ACTIONS
+            // same as MoveBy::update, other actions may have moved the node since the last update
+            const Vec3 start    = from + target->getPosition3D() - lane.previous[i];
+            const Vec3 position = start + value;
+            lane.from[i]        = start;
+            lane.previous[i]    = position;
+            target->setPosition3D(position);
+#else
+            target->setPosition3D(from + value);
+#endif
+            break;
+        }
+        case Kind::Scale:
+            target->setScaleX(from.x + value.x);
+            target->setScaleY(from.y + value.y);
+            target->setScaleZ(from.z + value.z);
+            break;
+        case Kind::Fade:
+            target->setOpacity((uint8_t)(from.x + value.x));
+            break;
+        case Kind::Rotate:
+            target->setRotation(from.x + value.x);
+            break;
+        case Kind::RotateSkew:
+            target->setRotationSkewX(from.x + value.x);
+            target->setRotationSkewY(from.y + value.y);
+            break;
+        case Kind::Rotate3D:
+            target->setRotation3D(from + value);
+            break;
+        }
+
+        // a setter may have removed the action, and released the target
+        auto action = static_cast<ActionInterval*>(lane.actions[i]);
+        if (action == nullptr)
+            continue;
+
+        if (lane.elapsed[i] >= lane.durations[i])
+        {
+            action->_elapsed   = lane.elapsed[i];
+            action->_firstTick = false;
+            action->_done      = true;
+            action->retain();
+            finished.push_back(action);
+        }
+        else if (target->getReferenceCount() == 1)
+        {
+            orphans.push_back(target);
+        }
+    }
+}
+
+void TweenBatch::writeBack(Lane& lane, size_t index)
+{
+    auto action        = static_cast<ActionInterval*>(lane.actions[index]);
+    action->_elapsed   = lane.elapsed[index];
+    action->_firstTick = (lane.flags[index] & FIRST_TICK) != 0;
+
+    if (lane.kinds[index] == Kind::Move)
+    {
+        auto ease = dynamic_cast<ActionEase*>(action);
+        auto move = static_cast<MoveBy*>(ease ? ease->getInnerAction() : action);
+
+        move->_startPosition    = lane.from[index];
+        move->_previousPosition = lane.previous[index];
+    }
+}
+
+void TweenBatch::erase(Lane& lane, size_t index)
+{
+    const size_t last = lane.actions.size() - 1;
+    if (index != last)
+    {
+        lane.actions[index]   = lane.actions[last];
+        lane.targets[index]   = lane.targets[last];
+        lane.kinds[index]     = lane.kinds[last];
+        lane.flags[index]     = lane.flags[last];
+        lane.elapsed[index]   = lane.elapsed[last];
+        lane.durations[index] = lane.durations[last];
+        lane.times[index]     = lane.times[last];
+        lane.from[index]      = lane.from[last];
+        lane.deltas[index]    = lane.deltas[last];
+        lane.previous[index]  = lane.previous[last];
+        lane.values[index]    = lane.values[last];
+
+        if (lane.actions[index])
+            lane.actions[index]->_tweenIndex = static_cast<int>(index);
+    }
+
+    lane.actions.pop_back();
+    lane.targets.pop_back();
+    lane.kinds.pop_back();
+    lane.flags.pop_back();
+    lane.elapsed.pop_back();
+    lane.durations.pop_back();
+    lane.times.pop_back();
+    lane.from.pop_back();
+    lane.deltas.pop_back();
+    lane.previous.pop_back();
+    lane.values.pop_back();
+    --_count;
+}
+
+void TweenBatch::purge()
+{
+    for (auto& lane : _lanes)
+    {
+        for (size_t i = lane.actions.size(); i-- > 0;)
+        {
+            if (lane.actions[i] == nullptr)
+                erase(lane, i);
+        }
+    }
+    _removedWhileUpdating = 0;
+}
+
+NS_AX_END
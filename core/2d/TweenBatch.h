@@ -0,0 +1,145 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+
+#pragma once
+
+#include <array>
+#include <vector>
+
+#include "2d/Action.h"
+#include "2d/TweenFunction.h"
+#include "math/Vec3.h"
+
+NS_AX_BEGIN
+
+class Node;
+
+/**
+ * @addtogroup actions
+ * @{
+ */
+
+/** @class TweenBatch
+ * @brief Steps the common tweens of an ActionManager in bulk.
+ *
+ * MoveTo, MoveBy, ScaleTo, ScaleBy, FadeTo, FadeIn, FadeOut and RotateTo, either on their own or wrapped by one of
+ * the EASE_TEMPLATE_DECL_CLASS eases, are copied into contiguous arrays grouped by easing. Each update advances the
+ * clocks, eases the normalized times with tweenfunc::tweenTo and interpolates in tight loops, then writes the results
+ * to the nodes lane by lane, instead of calling Action::step per action.
+ *
+ * The batched actions stay in the ActionManager, so they can still be queried, stopped and removed like any other
+ * action. Their clock is written back when they finish or are removed, ActionInterval::getElapsed reads it from here
+ * in the meantime.
+ */
+class AX_DLL TweenBatch
+{
+public:
+    TweenBatch();
+    ~TweenBatch();
+
+    /** Returns true if the action is stepped by a TweenBatch instead of by Action::step. */
+    static bool isBatched(const Action* action) { return action->_tweenBatch != nullptr; }
+
+    /** Starts stepping the action if it's one of the supported tweens, it must have been started on target already.
+     *
+     * @return true if the action was batched.
+     */
+    bool add(Action* action, Node* target, bool paused);
+
+    /** Stops stepping the action, its state is written back so that Action::step can carry on from there. */
+    void remove(Action* action);
+
+    /** Removes all the batched actions. */
+    void clear();
+
+    void setPaused(Action* action, bool paused);
+
+    /** Returns the elapsed time of a batched action. */
+    float getElapsed(const Action* action) const;
+
+    /** Advances all the unpaused tweens.
+     *
+     * @param dt        In seconds.
+     * @param finished  Receives the actions which reached their duration, retained.
+     * @param orphans   Receives the targets only referenced by their actions.
+     */
+    void update(float dt, std::vector<Action*>& finished, std::vector<Node*>& orphans);
+
+    bool empty() const { return _count == 0; }
+    size_t size() const { return _count; }
+
+protected:
+    enum class Kind : uint8_t
+    {
+        Move,
+        Scale,
+        Fade,
+        Rotate,
+        RotateSkew,
+        Rotate3D,
+    };
+
+    enum Flags : uint8_t
+    {
+        FIRST_TICK = 1 << 0,
+        PAUSED     = 1 << 1,
+        REMOVED    = 1 << 2,
+    };
+
+    /** The tweens sharing one easing, as parallel arrays */
+    struct Lane
+    {
+        std::vector<Action*> actions;
+        std::vector<Node*> targets;
+        std::vector<Kind> kinds;
+        std::vector<uint8_t> flags;
+        std::vector<float> elapsed;
+        std::vector<float> durations;
+        std::vector<float> times;
+        std::vector<Vec3> from;
+        std::vector<Vec3> deltas;
+        std::vector<Vec3> previous;
+        std::vector<Vec3> values;
+    };
+
+    void updateLane(Lane& lane,
+                    tweenfunc::TweenType easing,
+                    float dt,
+                    std::vector<Action*>& finished,
+                    std::vector<Node*>& orphans);
+    void writeBack(Lane& lane, size_t index);
+    void erase(Lane& lane, size_t index);
+    void purge();
+
+    std::array<Lane, tweenfunc::Bounce_EaseInOut + 1> _lanes;
+    size_t _count;
+    size_t _removedWhileUpdating;
+    bool _updating;
+};
+
+// end of actions group
+/// @}
+
+NS_AX_END
@@ -24,6 +24,7 @@ THE SOFTWARE.
 ****************************************************************************/
 
 #include "2d/TweenFunction.h"
+#include "base/Macros.h"
 
 #define _USE_MATH_DEFINES  // needed for M_PI and M_PI2
 #include <math.h>          // M_PI
@@ -181,6 +182,134 @@ float tweenTo(float time, TweenType type, float* easingParam)
     return delta;
 }
 
+template <float (*EASE)(float)>
+static void easeEach(float* times, size_t count)
+{
+    for (size_t i = 0; i < count; ++i)
+        times[i] = EASE(times[i]);
+}
+
+template <float (*EASE)(float, float)>
+static void easeEach(float* times, size_t count, float param)
+{
+    for (size_t i = 0; i < count; ++i)
+        times[i] = EASE(times[i], param);
+}
+
+void tweenTo(float* times, size_t count, TweenType type)
+{
+    // dispatch once per batch, so that each loop below sees a single inlinable easing function
+    switch (type)
+    {
+    case Linear:
+        break;
+
+    case Sine_EaseIn:
+        easeEach<sineEaseIn>(times, count);
+        break;
+    case Sine_EaseOut:
+        easeEach<sineEaseOut>(times, count);
+        break;
+    case Sine_EaseInOut:
+        easeEach<sineEaseInOut>(times, count);
+        break;
+
+    case Quad_EaseIn:
+        easeEach<quadEaseIn>(times, count);
+        break;
+    case Quad_EaseOut:
+        easeEach<quadEaseOut>(times, count);
+        break;
+    case Quad_EaseInOut:
+        easeEach<quadEaseInOut>(times, count);
+        break;
+
+    case Cubic_EaseIn:
+        easeEach<cubicEaseIn>(times, count);
+        break;
+    case Cubic_EaseOut:
+        easeEach<cubicEaseOut>(times, count);
+        break;
+    case Cubic_EaseInOut:
+        easeEach<cubicEaseInOut>(times, count);
+        break;
+
+    case Quart_EaseIn:
+        easeEach<quartEaseIn>(times, count);
+        break;
+    case Quart_EaseOut:
+        easeEach<quartEaseOut>(times, count);
+        break;
+    case Quart_EaseInOut:
+        easeEach<quartEaseInOut>(times, count);
+        break;
+
+    case Quint_EaseIn:
+        easeEach<quintEaseIn>(times, count);
+        break;
+    case Quint_EaseOut:
+        easeEach<quintEaseOut>(times, count);
+        break;
+    case Quint_EaseInOut:
+        easeEach<quintEaseInOut>(times, count);
+        break;
+
+    case Expo_EaseIn:
+        easeEach<expoEaseIn>(times, count);
+        break;
+    case Expo_EaseOut:
+        easeEach<expoEaseOut>(times, count);
+        break;
+    case Expo_EaseInOut:
+        easeEach<expoEaseInOut>(times, count);
+        break;
+
+    case Circ_EaseIn:
+        easeEach<circEaseIn>(times, count);
+        break;
+    case Circ_EaseOut:
+        easeEach<circEaseOut>(times, count);
+        break;
+    case Circ_EaseInOut:
+        easeEach<circEaseInOut>(times, count);
+        break;
+
+    case Elastic_EaseIn:
+        easeEach<elasticEaseIn>(times, count, 0.3f);
+        break;
+    case Elastic_EaseOut:
+        easeEach<elasticEaseOut>(times, count, 0.3f);
+        break;
+    case Elastic_EaseInOut:
+        easeEach<elasticEaseInOut>(times, count, 0.3f);
+        break;
+
+    case Back_EaseIn:
+        easeEach<backEaseIn>(times, count);
+        break;
+    case Back_EaseOut:
+        easeEach<backEaseOut>(times, count);
+        break;
+    case Back_EaseInOut:
+        easeEach<backEaseInOut>(times, count);
+        break;
+
+    case Bounce_EaseIn:
+        easeEach<bounceEaseIn>(times, count);
+        break;
+    case Bounce_EaseOut:
+        easeEach<bounceEaseOut>(times, count);
+        break;
+    case Bounce_EaseInOut:
+        easeEach<bounceEaseInOut>(times, count);
+        break;
+
+    default:
+        AXASSERT(false, "tweenfunc::tweenTo: a batch can't be eased with a custom easing");
+        break;
+    }
+}
+
 // Linear
 float linear(float time)
 {
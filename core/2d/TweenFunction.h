@@ -129,6 +129,14 @@ float AX_DLL quadraticInOut(float time);
  */
 float AX_DLL tweenTo(float time, TweenType type, float* easingParam);
 
+/**
+ * Eases a batch of normalized times in place, e.g. the times of many tweens sharing one easing.
+ * Elastic easings use their default period. CUSTOM_EASING is not supported.
+ * @param times in normalized time, overwritten with the eased values.
+ * @param count the number of times.
+ */
+void AX_DLL tweenTo(float* times, size_t count, TweenType type);
+
 /**
  * @param time in seconds.
  */
@@ -72,4 +72,12 @@ void AttachNode::visit(Renderer* renderer, const Mat4& parentTransform, uint32_t
 {
     Node::visit(renderer, parentTransform, Node::FLAGS_DIRTY_MASK);
 }
+
+void AttachNode::prepareSubtreeTransforms(const Mat4& /*parentTransform*/,
+                                          uint32_t /*parentFlags*/,
+                                          unsigned int /*frame*/,
+                                          std::vector<PendingTransform>* /*pending*/)
+{
+    // the bone transform is only known when visited, the subtree is updated by the visit
+}
 NS_AX_END
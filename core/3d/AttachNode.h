@@ -58,6 +58,10 @@ public:
     virtual Mat4 getNodeToWorldTransform() const override;
     virtual const Mat4& getNodeToParentTransform() const override;
     virtual void visit(Renderer* renderer, const Mat4& parentTransform, uint32_t parentFlags) override;
+    virtual void prepareSubtreeTransforms(const Mat4& parentTransform,
+                                          uint32_t parentFlags,
+                                          unsigned int frame,
+                                          std::vector<PendingTransform>* pending) override;
 
     AttachNode();
     virtual ~AttachNode();
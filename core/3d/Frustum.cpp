@@ -26,6 +26,13 @@
 #include "3d/Frustum.h"
 #include "2d/Camera.h"
 
+#include <algorithm>
+#include <cmath>
+
+#ifdef AX_USE_SSE
+#    include <xmmintrin.h>
+#endif
+
 NS_AX_BEGIN
 
 bool Frustum::initFrustum(const Camera* camera)
@@ -80,6 +87,66 @@ bool Frustum::isOutOfFrustum(const OBB& obb) const
     return false;
 }
 
+void Frustum::isOutOfFrustum(const Vec3* centers, const Vec3* extents, size_t count, bool* outside) const
+{
+    if (!_initialized)
+    {
+        std::fill(outside, outside + count, false);
+        return;
+    }
+
+    // an aabb is out when its corner nearest to the inside of a plane is in front of it:
+    // dot(normal, center) - dot(abs(normal), extent) - dist > 0
+    const int planes = _clipZ ? 6 : 4;
+    size_t i         = 0;
+#ifdef AX_USE_SSE
+    for (; i + 4 <= count; i += 4)
+    {
+        const Vec3* c = centers + i;
+        const Vec3* e = extents + i;
+        __m128 cx     = _mm_setr_ps(c[0].x, c[1].x, c[2].x, c[3].x);
+        __m128 cy     = _mm_setr_ps(c[0].y, c[1].y, c[2].y, c[3].y);
+        __m128 cz     = _mm_setr_ps(c[0].z, c[1].z, c[2].z, c[3].z);
+        __m128 ex     = _mm_setr_ps(e[0].x, e[1].x, e[2].x, e[3].x);
+        __m128 ey     = _mm_setr_ps(e[0].y, e[1].y, e[2].y, e[3].y);
+        __m128 ez     = _mm_setr_ps(e[0].z, e[1].z, e[2].z, e[3].z);
+
+        __m128 out = _mm_setzero_ps();
+        for (int p = 0; p < planes; ++p)
+        {
+            const Vec3& n = _plane[p].getNormal();
+            __m128 d      = _mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_set1_ps(n.x), cx), _mm_mul_ps(_mm_set1_ps(n.y), cy)),
+                                       _mm_mul_ps(_mm_set1_ps(n.z), cz));
+            __m128 r      = _mm_add_ps(
+                _mm_add_ps(_mm_mul_ps(_mm_set1_ps(std::abs(n.x)), ex), _mm_mul_ps(_mm_set1_ps(std::abs(n.y)), ey)),
+                _mm_mul_ps(_mm_set1_ps(std::abs(n.z)), ez));
+            d   = _mm_sub_ps(_mm_sub_ps(d, r), _mm_set1_ps(_plane[p].getDist()));
+            out = _mm_or_ps(out, _mm_cmpgt_ps(d, _mm_setzero_ps()));
+        }
+
+        int mask       = _mm_movemask_ps(out);
+        outside[i]     = (mask & 1) != 0;
+        outside[i + 1] = (mask & 2) != 0;
+        outside[i + 2] = (mask & 4) != 0;
+        outside[i + 3] = (mask & 8) != 0;
+    }
+#endif
+    for (; i < count; ++i)
+    {
+        const Vec3& c = centers[i];
+        const Vec3& e = extents[i];
+        bool out      = false;
+        for (int p = 0; p < planes && !out; ++p)
+        {
+            const Vec3& n = _plane[p].getNormal();
+            out = n.x * c.x + n.y * c.y + n.z * c.z -
+                      (std::abs(n.x) * e.x + std::abs(n.y) * e.y + std::abs(n.z) * e.z) - _plane[p].getDist() >
+                  0;
+        }
+        outside[i] = out;
+    }
+}
+
 void Frustum::createPlane(const Camera* camera)
 {
     const Mat4& mat = camera->getViewProjectionMatrix();
@@ -66,6 +66,11 @@ public:
      * is obb out of frustum
      */
     bool isOutOfFrustum(const OBB& obb) const;
+    /**
+     * test a batch of aabbs, given by their centers and half extents, uses SSE when available.
+     * outside[i] is set to true if the i-th aabb is out of frustum.
+     */
+    void isOutOfFrustum(const Vec3* centers, const Vec3* extents, size_t count, bool* outside) const;
 
     /**
      * get & set z clip. if bclipZ == true use near and far plane
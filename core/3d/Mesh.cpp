@@ -28,6 +28,7 @@
 #include "3d/Skeleton3D.h"
 #include "3d/MeshVertexIndexData.h"
 #include "3d/VertexAttribBinding.h"
+#include "3d/MeshMaterial.h"
 #include "2d/Light.h"
 #include "2d/Scene.h"
 #include "base/EventDispatcher.h"
@@ -42,6 +43,7 @@
 #include "renderer/backend/Program.h"
 #include "renderer/RenderConsts.h"
 #include "math/Mat4.h"
+#include "xxhash.h"
 
 using namespace std;
 
@@ -118,6 +120,7 @@ Mesh::~Mesh()
     AX_SAFE_RELEASE(_meshIndexData);
     AX_SAFE_RELEASE(_material);
     AX_SAFE_RELEASE(_instanceTransformBuffer);
+    AX_SAFE_RELEASE(_autoInstancingProgramState);
     AX_SAFE_DELETE_ARRAY(_instanceMatrixCache);
 }
 
@@ -376,6 +379,7 @@ void Mesh::setMaterial(Material* material)
         AX_SAFE_RETAIN(_material);
     }
     _meshCommands.clear();
+    AX_SAFE_RELEASE_NULL(_autoInstancingProgramState);
 
     if (_material)
     {
@@ -526,9 +530,17 @@ void Mesh::draw(Renderer* renderer,
     }
     auto& commands = _meshCommands[technique->getName()];
 
+    // identical opaque meshes can be merged into one instanced draw by the renderer
+    uint64_t instancingKey                        = 0;
+    backend::ProgramState* instancingProgramState = nullptr;
+    if (renderer->isAutoInstancingEnabled() && !isTransparent && !_instancing && !_skin &&
+        technique->_passes.size() == 1 && !_material->isForce2DQueue())
+        instancingProgramState = prepareAutoInstancing(technique->_passes.at(0), color, wireframe, instancingKey);
+
     for (auto&& command : commands)
     {
         command.init(globalZ, transform);
+        command.setInstancingKey(instancingKey, instancingProgramState);
         command.setSkipBatching(isTransparent);
         command.setTransparent(isTransparent);
         command.set3D(!_material->isForce2DQueue());
@@ -547,6 +559,72 @@ void Mesh::draw(Renderer* renderer,
                     static_cast<unsigned int>(getIndexCount()), transform);
 }
 
+backend::ProgramState* Mesh::prepareAutoInstancing(Pass* pass, const Vec4& color, bool wireframe, uint64_t& key)
+{
+    // only the unlit material has an instancing variant of its program
+    auto meshMaterial = dynamic_cast<MeshMaterial*>(_material);
+    auto textureIt    = _textures.find(NTextureData::Usage::Diffuse);
+    auto texture      = textureIt != _textures.end() ? textureIt->second : nullptr;
+    if (!meshMaterial || meshMaterial->getMaterialType() != MeshMaterial::MaterialType::UNLIT || !texture)
+        return nullptr;
+
+    auto passProgramState = pass->getProgramState();
+    if (!_autoInstancingProgramState)
+    {
+        auto program = backend::Program::getBuiltinProgram(backend::ProgramType::POSITION_TEXTURE_3D_INSTANCE);
+        _autoInstancingProgramState = new backend::ProgramState(program);
+
+        // same vertex data as the pass, at the attribute locations of the instancing program
+        auto& activeAttributes = program->getActiveAttributes();
+        auto passLayout        = passProgramState->getVertexLayout();
+        auto layout            = _autoInstancingProgramState->getMutableVertexLayout();
+        for (auto&& item : passLayout->getAttributes())
+        {
+            auto& attribute = item.second;
+            auto it         = activeAttributes.find(attribute.name);
+            if (it != activeAttributes.end())
+                layout->setAttrib(attribute.name, it->second.location, attribute.format, attribute.offset,
+                                  attribute.needToBeNormallized);
+        }
+        layout->setStride(passLayout->getStride());
+
+        _autoInstancingTextureLocation = _autoInstancingProgramState->getUniformLocation("u_tex0");
+        _autoInstancingColorLocation   = _autoInstancingProgramState->getUniformLocation("u_color");
+    }
+    _autoInstancingProgramState->setTexture(_autoInstancingTextureLocation, 0, texture->getBackendTexture());
+    _autoInstancingProgramState->setUniform(_autoInstancingColorLocation, &color, sizeof(color));
+
+    struct
+    {
+        const void* vertexBuffer;
+        const void* indexBuffer;
+        const void* texture;
+        Vec4 color;
+        uint32_t indexCount;
+        uint32_t primitive;
+        uint32_t indexFormat;
+        uint32_t wireframe;
+        uint32_t stateHashes[3];
+    } state;
+    memset(&state, 0, sizeof(state));
+    state.vertexBuffer   = getVertexBuffer();
+    state.indexBuffer    = getIndexBuffer();
+    state.texture        = texture->getBackendTexture();
+    state.color          = color;
+    state.indexCount     = static_cast<uint32_t>(getIndexCount());
+    state.primitive      = static_cast<uint32_t>(_material->getPrimitiveType());
+    state.indexFormat    = static_cast<uint32_t>(getIndexFormat());
+    state.wireframe      = wireframe;
+    state.stateHashes[0] = _material->getStateBlock().getHash();
+    state.stateHashes[1] = _material->_currentTechnique->getStateBlock().getHash();
+    state.stateHashes[2] = pass->getStateBlock().getHash();
+
+    key = XXH64(&state, sizeof(state), 0);
+    if (key == 0)
+        key = 1;
+    return _autoInstancingProgramState;
+}
+
 void Mesh::setSkin(MeshSkin* skin)
 {
     if (_skin != skin)
@@ -280,6 +280,7 @@ protected:
     void resetLightUniformValues();
     void setLightUniforms(Pass* pass, Scene* scene, const Vec4& color, unsigned int lightmask);
     void bindMeshCommand();
+    backend::ProgramState* prepareAutoInstancing(Pass* pass, const Vec4& color, bool wireframe, uint64_t& key);
 
     std::map<NTextureData::Usage, Texture2D*> _textures;  // textures that submesh is using
     MeshSkin* _skin;                                      // skin
@@ -294,6 +295,11 @@ protected:
     float* _instanceMatrixCache;
     bool _dynamicInstancing;
 
+    // instancing variant of the unlit program, used when the renderer merges identical meshes
+    backend::ProgramState* _autoInstancingProgramState = nullptr;
+    backend::UniformLocation _autoInstancingTextureLocation;
+    backend::UniformLocation _autoInstancingColorLocation;
+
     CustomCommand::IndexFormat meshIndexFormat;
 
     std::string _name;
@@ -273,6 +273,10 @@ MeshRenderer::MeshRenderer()
     , _wireframe(false)
     , _usingAutogeneratedGLProgram(true)
     , _transparentMaterialHint(false)
+    , _instancing(false)
+    , _outOfFrustum(false)
+    , _frustumCullCamera(nullptr)
+    , _frustumCullFrame(0)
     , _meshTextureHint(0)
 {}
 
@@ -717,12 +721,14 @@ void MeshRenderer::enableInstancing(MeshMaterial* instanceMat, int count)
         mesh->enableInstancing(true, MAX(1, count));
         mesh->setMaterial(instanceMat);
     }
+    _instancing = true;
 }
 
 void MeshRenderer::disableInstancing()
 {
     for (auto&& mesh : _meshes)
         mesh->enableInstancing(false, 0);
+    _instancing = false;
 }
 
 void MeshRenderer::setDynamicInstancing(bool dynamic)
@@ -858,11 +864,13 @@ void MeshRenderer::visit(ax::Renderer* renderer, const ax::Mat4& parentTransform
 void MeshRenderer::draw(Renderer* renderer, const Mat4& transform, uint32_t flags)
 {
 #if AX_USE_CULLING
-    // TODO new-renderer: interface isVisibleInFrustum removal
-    //  camera clipping
-//    if(_children.empty() && Camera::getVisitingCamera() &&
-//    !Camera::getVisitingCamera()->isVisibleInFrustum(&getAABB()))
-//        return;
+    // camera clipping
+    auto camera = Camera::getVisitingCamera();
+    if (camera && isOutOfFrustum(camera))
+    {
+        camera->addCulledMeshes(1);
+        return;
+    }
 #endif
 
     if (_skeleton)
@@ -928,6 +936,100 @@ const BlendFunc& MeshRenderer::getBlendFunc() const
     return _blend;
 }
 
+bool MeshRenderer::isOutOfFrustum(const Camera* camera) const
+{
+    if (_instancing || isSkinned())
+        return false;
+
+    if (_frustumCullCamera == camera && _frustumCullFrame == _director->getTotalFrames())
+        return _outOfFrustum;
+
+    auto& aabb = getAABB();
+    return !aabb.isEmpty() && !camera->isVisibleInFrustum(&aabb);
+}
+
+bool MeshRenderer::isSkinned() const
+{
+    if (!_skeleton)
+        return false;
+    for (auto&& mesh : _meshes)
+    {
+        if (mesh->getSkin())
+            return true;
+    }
+    return false;
+}
+
+void MeshRenderer::cullMeshRenderers(MeshRenderer* const* meshRenderers, size_t count, const Camera* camera)
+{
+    if (count == 0)
+        return;
+
+    auto& centers = camera->_cullCenters;
+    auto& extents = camera->_cullExtents;
+    auto& tested  = camera->_cullTested;
+    centers.clear();
+    extents.clear();
+    tested.clear();
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        auto meshRenderer = meshRenderers[i];
+        if (meshRenderer->_instancing || meshRenderer->isSkinned())
+            continue;
+
+        auto& aabb = meshRenderer->getAABB();
+        if (aabb.isEmpty())
+            continue;
+
+        centers.emplace_back((aabb._min + aabb._max) * 0.5f);
+        extents.emplace_back((aabb._max - aabb._min) * 0.5f);
+        tested.emplace_back(meshRenderer);
+    }
+
+    auto& outside = camera->_cullOutside;
+    if (camera->_cullOutsideCapacity < tested.size())
+    {
+        camera->_cullOutsideCapacity = tested.size();
+        outside.reset(new bool[tested.size()]);
+    }
+    camera->isOutOfFrustum(centers.data(), extents.data(), tested.size(), outside.get());
+
+    const auto frame = Director::getInstance()->getTotalFrames();
+    for (size_t i = 0; i < tested.size(); ++i)
+    {
+        tested[i]->_outOfFrustum      = outside[i];
+        tested[i]->_frustumCullCamera = camera;
+        tested[i]->_frustumCullFrame  = frame;
+    }
+}
+
+void MeshRenderer::onEnter()
+{
+    auto scene = getScene();
+    if (scene)
+    {
+        auto& meshRenderers = scene->_meshRenderers;
+        auto iter           = std::find(meshRenderers.begin(), meshRenderers.end(), this);
+        if (iter == meshRenderers.end())
+            meshRenderers.emplace_back(this);
+    }
+    Node::onEnter();
+}
+
+void MeshRenderer::onExit()
+{
+    auto scene = getScene();
+    if (scene)
+    {
+        auto& meshRenderers = scene->_meshRenderers;
+        auto iter           = std::find(meshRenderers.begin(), meshRenderers.end(), this);
+        if (iter != meshRenderers.end())
+            meshRenderers.erase(iter);
+    }
+    Node::onExit();
+}
+
 AABB MeshRenderer::getAABBRecursively()
 {
     return getAABBRecursivelyImp(this);
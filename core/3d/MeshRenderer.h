@@ -51,6 +51,7 @@ class Mesh;
 class Texture2D;
 class MeshSkin;
 class AttachNode;
+class Camera;
 struct NodeData;
 /** @brief MeshRenderer: A mesh can be loaded from model files, .obj, .c3t, .c3b
  *and a mesh renderer renders a list of these loaded meshes with specified materials
@@ -147,6 +148,22 @@ public:
      */
     AABB getAABBRecursively();
 
+    /**
+     * Whether the AABB is out of the frustum of the camera. MeshRenderers using instancing or skinning are never out:
+     * their AABB only covers the base mesh or the bind pose.
+     * The result of the batched test of cullMeshRenderers is used when it was done for the camera in this frame.
+     */
+    bool isOutOfFrustum(const Camera* camera) const;
+
+    /**
+     * Tests the MeshRenderers against the frustum of the camera in a single batch, the results are used when they
+     * are drawn for the camera in this frame. Called by Scene::render for the MeshRenderers of the scene.
+     */
+    static void cullMeshRenderers(MeshRenderer* const* meshRenderers, size_t count, const Camera* camera);
+
+    virtual void onEnter() override;
+    virtual void onExit() override;
+
     /**
      * Executes an action, and returns the action that is executed. For the MeshRenderer special logic is needed to take
      * care of Fading.
@@ -306,6 +323,9 @@ protected:
     */
     void setModelTexture(std::string_view modelPath, std::string_view texPath);
 
+    /** whether a mesh is skinned, its AABB is then the bind pose one */
+    bool isSkinned() const;
+
     Skeleton3D* _skeleton;
 
     Vector<MeshVertexData*> _meshVertexDatas;
@@ -325,6 +345,10 @@ protected:
     bool _wireframe;         // render in wireframe mode
     bool _usingAutogeneratedGLProgram;
     bool _transparentMaterialHint; // Generate transparent materials when building from files
+    bool _instancing;
+    bool _outOfFrustum;                      // result of the batched frustum test
+    const Camera* _frustumCullCamera;        // camera of the batched frustum test
+    unsigned int _frustumCullFrame;          // frame of the batched frustum test
     unsigned short _meshTextureHint; // Whether model file has texture config
 
     struct AsyncLoadParam
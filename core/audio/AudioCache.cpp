@@ -53,6 +53,8 @@ AudioCache::AudioCache()
     , _duration(0.0f)
     , _alBufferId(INVALID_AL_BUFFER_ID)
     , _queBufferFrames(0)
+    , _sizeInBytes(0)
+    , _lastUsedTick(0)
     , _state(State::INITIAL)
     , _isDestroyed(std::make_shared<bool>(false))
     , _id(++__idIndex)
@@ -284,7 +286,8 @@ void AudioCache::readDataTask(unsigned int selfId)
                 break;
             }
 
-            _state = State::READY;
+            _sizeInBytes = dataSize;
+            _state       = State::READY;
         }
         else
         {
@@ -301,7 +304,8 @@ void AudioCache::readDataTask(unsigned int selfId)
                 decoder->readFixedFrames(_queBufferFrames, _queBuffers[index]);
             }
 
-            _state = State::READY;
+            _sizeInBytes = static_cast<size_t>(queBufferBytes) * QUEUEBUFFER_NUM;
+            _state       = State::READY;
         }
 
     } while (false);
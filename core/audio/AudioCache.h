@@ -87,6 +87,11 @@ protected:
     ALsizei _queBufferSize[QUEUEBUFFER_NUM];
     uint32_t _queBufferFrames;
 
+    // bytes held by the al buffer or the queue buffers, set once loaded
+    size_t _sizeInBytes;
+    // AudioEngineImpl tick of the last preload or play, the least recently used caches are evicted first
+    uint64_t _lastUsedTick;
+
     std::mutex _playCallbackMutex;
     std::vector<std::function<void()>> _playCallbacks;
 
@@ -31,6 +31,9 @@ THE SOFTWARE.
 #include "audio/AudioMacros.h"
 #include "platform/FileUtils.h"
 #include "base/Logging.h"
+#include "base/Data.h"
+
+#include <mutex>
 
 #if !defined(__APPLE__)
 #    include "audio/AudioDecoderMp3.h"
@@ -43,6 +46,77 @@ THE SOFTWARE.
 
 NS_AX_BEGIN
 
+namespace
+{
+// Read-only stream over the bytes of a file kept by AudioDecoderManager::addMemoryFile, holds a reference so the
+// bytes stay valid while a decoder reads them even if the file is removed meanwhile.
+class MemoryFileStream : public IFileStream
+{
+public:
+    explicit MemoryFileStream(std::shared_ptr<Data> data) : _data(std::move(data)), _offset(0) {}
+
+    bool open(std::string_view /*path*/, IFileStream::Mode /*mode*/) override { return false; }
+
+    int close() override
+    {
+        _data.reset();
+        return 0;
+    }
+
+    int64_t seek(int64_t offset, int origin) const override
+    {
+        if (!_data)
+            return -1;
+
+        int64_t newOffset;
+        switch (origin)
+        {
+        case SEEK_SET:
+            newOffset = offset;
+            break;
+        case SEEK_CUR:
+            newOffset = _offset + offset;
+            break;
+        case SEEK_END:
+            newOffset = _data->getSize() + offset;
+            break;
+        default:
+            return -1;
+        }
+        if (newOffset < 0 || newOffset > _data->getSize())
+            return -1;
+        _offset = newOffset;
+        return _offset;
+    }
+
+    int read(void* buf, unsigned int size) const override
+    {
+        if (!_data)
+            return -1;
+
+        auto bytesRead = static_cast<int>((std::min)(static_cast<int64_t>(size), _data->getSize() - _offset));
+        memcpy(buf, _data->getBytes() + _offset, bytesRead);
+        _offset += bytesRead;
+        return bytesRead;
+    }
+
+    int write(const void* /*buf*/, unsigned int /*size*/) const override { return -1; }
+
+    int64_t tell() const override { return _data ? _offset : -1; }
+
+    int64_t size() const override { return _data ? _data->getSize() : -1; }
+
+    bool isOpen() const override { return _data != nullptr; }
+
+private:
+    std::shared_ptr<Data> _data;
+    mutable int64_t _offset;
+};
+
+std::mutex s_memoryFilesMutex;
+hlookup::string_map<std::shared_ptr<Data>> s_memoryFiles;
+}  // namespace
+
 bool AudioDecoderManager::init()
 {
 #if !defined(__APPLE__)
@@ -90,6 +164,50 @@ void AudioDecoderManager::destroyDecoder(AudioDecoder* decoder)
     delete decoder;
 }
 
+void AudioDecoderManager::addMemoryFile(std::string_view fullPath, Data&& data)
+{
+    auto shared = std::make_shared<Data>(std::move(data));
+    std::lock_guard<std::mutex> lck(s_memoryFilesMutex);
+    s_memoryFiles.insert_or_assign(std::string{fullPath}, std::move(shared));
+}
+
+void AudioDecoderManager::removeMemoryFile(std::string_view fullPath)
+{
+    std::lock_guard<std::mutex> lck(s_memoryFilesMutex);
+    s_memoryFiles.erase(fullPath);
+}
+
+void AudioDecoderManager::removeAllMemoryFiles()
+{
+    std::lock_guard<std::mutex> lck(s_memoryFilesMutex);
+    s_memoryFiles.clear();
+}
+
+size_t AudioDecoderManager::getMemoryFileSize(std::string_view fullPath)
+{
+    std::lock_guard<std::mutex> lck(s_memoryFilesMutex);
+    auto it = s_memoryFiles.find(fullPath);
+    return it != s_memoryFiles.end() ? static_cast<size_t>(it->second->getSize()) : 0;
+}
+
+void AudioDecoderManager::forEachMemoryFile(const std::function<void(std::string_view, size_t)>& visitor)
+{
+    std::lock_guard<std::mutex> lck(s_memoryFilesMutex);
+    for (auto&& file : s_memoryFiles)
+        visitor(file.first, static_cast<size_t>(file.second->getSize()));
+}
+
+std::unique_ptr<IFileStream> AudioDecoderManager::openFileStream(std::string_view fullPath)
+{
+    {
+        std::lock_guard<std::mutex> lck(s_memoryFilesMutex);
+        auto it = s_memoryFiles.find(fullPath);
+        if (it != s_memoryFiles.end())
+            return std::make_unique<MemoryFileStream>(it->second);
+    }
+    return FileUtils::getInstance()->openFileStream(fullPath, IFileStream::Mode::READ);
+}
+
 NS_AX_END  // namespace ax
 
 #undef LOG_TAG
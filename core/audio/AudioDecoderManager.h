@@ -26,12 +26,16 @@ THE SOFTWARE.
 
 #pragma once
 #include <string>
+#include <memory>
+#include <functional>
 
 #include "platform/PlatformMacros.h"
+#include "platform/IFileStream.h"
 
 NS_AX_BEGIN
 
 class AudioDecoder;
+class Data;
 
 class AudioDecoderManager
 {
@@ -40,6 +44,17 @@ public:
     static void destroy();
     static AudioDecoder* createDecoder(std::string_view path);
     static void destroyDecoder(AudioDecoder* decoder);
+
+    /** Keeps the undecoded bytes of a file in memory, decoders read them instead of the file system afterwards. */
+    static void addMemoryFile(std::string_view fullPath, Data&& data);
+    static void removeMemoryFile(std::string_view fullPath);
+    static void removeAllMemoryFiles();
+    /** Returns the size of the in-memory bytes of a file, 0 if it isn't kept in memory. */
+    static size_t getMemoryFileSize(std::string_view fullPath);
+    static void forEachMemoryFile(const std::function<void(std::string_view fullPath, size_t size)>& visitor);
+
+    /** Opens a file for decoding, from memory if it was added with addMemoryFile. */
+    static std::unique_ptr<IFileStream> openFileStream(std::string_view fullPath);
 };
 
 NS_AX_END  // namespace ax
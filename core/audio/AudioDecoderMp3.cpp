@@ -27,6 +27,7 @@
 #define LOG_TAG "AudioDecoderMp3"
 #include "audio/AudioDecoderMp3.h"
 #include "audio/AudioMacros.h"
+#include "audio/AudioDecoderManager.h"
 #include "platform/FileUtils.h"
 
 #include "base/Logging.h"
@@ -130,7 +131,7 @@ bool AudioDecoderMp3::open(std::string_view fullPath)
 #if !AX_USE_MPG123
     do
     {
-        _fileStream = FileUtils::getInstance()->openFileStream(fullPath, IFileStream::Mode::READ);
+        _fileStream = AudioDecoderManager::openFileStream(fullPath);
         if (!_fileStream)
         {
             AXLOGE("Trouble with minimp3(1): {}\n", strerror(errno));
@@ -28,6 +28,7 @@
 
 #include "audio/AudioDecoderOgg.h"
 #include "audio/AudioMacros.h"
+#include "audio/AudioDecoderManager.h"
 #include "platform/FileUtils.h"
 
 #if AX_TARGET_PLATFORM == AX_PLATFORM_ANDROID
@@ -71,7 +72,7 @@ AudioDecoderOgg::~AudioDecoderOgg()
 
 bool AudioDecoderOgg::open(std::string_view fullPath)
 {
-    auto fs = FileUtils::getInstance()->openFileStream(fullPath, IFileStream::Mode::READ).release();
+    auto fs = AudioDecoderManager::openFileStream(fullPath).release();
     if (!fs)
     {
         AXLOGE("Trouble with ogg(1): {}\n", strerror(errno));
@@ -28,6 +28,7 @@
 #include <assert.h>
 #include "audio/AudioDecoderWav.h"
 #include "audio/AudioMacros.h"
+#include "audio/AudioDecoderManager.h"
 #include "platform/FileUtils.h"
 
 NS_AX_BEGIN
@@ -80,7 +81,7 @@ static bool wav_scan_chunk(WAV_FILE* wavf, uint32_t chunkID, void* header, void*
 }
 static bool wav_open(std::string_view fullPath, WAV_FILE* wavf)
 {
-    wavf->Stream = FileUtils::getInstance()->openFileStream(fullPath, IFileStream::Mode::READ);
+    wavf->Stream = AudioDecoderManager::openFileStream(fullPath);
     if (!wavf->Stream)
         return false;
 
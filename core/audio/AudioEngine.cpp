@@ -55,6 +55,8 @@ std::unordered_map<AUDIO_ID, AudioEngine::AudioInfo> AudioEngine::_audioIDInfoMa
 AudioEngineImpl* AudioEngine::_audioEngineImpl = nullptr;
 
 bool AudioEngine::_isEnabled                                  = true;
+AudioEngine::CacheMode AudioEngine::_cacheMode                = AudioEngine::CacheMode::PCM;
+size_t AudioEngine::_cacheBudget                              = 0;
 
 AudioEngine::AudioInfo::AudioInfo()
     : profileHelper(nullptr), volume(1.0f), loop(false), duration(TIME_UNKNOWN), state(AudioState::INITIALIZING)
@@ -498,10 +500,30 @@ void AudioEngine::preload(std::string_view filePath, std::function<void(bool isS
             return;
         }
 
-        _audioEngineImpl->preload(filePath, callback);
+        if (_cacheMode == CacheMode::COMPRESSED)
+            _audioEngineImpl->preloadCompressed(filePath, callback);
+        else
+            _audioEngineImpl->preload(filePath, callback);
     }
 }
 
+void AudioEngine::setCacheBudget(size_t bytes)
+{
+    _cacheBudget = bytes;
+    if (_audioEngineImpl)
+        _audioEngineImpl->trimCaches(nullptr);
+}
+
+size_t AudioEngine::getCacheSize()
+{
+    return _audioEngineImpl ? _audioEngineImpl->getCacheSize() : 0;
+}
+
+std::vector<AudioCacheInfo> AudioEngine::getCacheInfos()
+{
+    return _audioEngineImpl ? _audioEngineImpl->getCacheInfos() : std::vector<AudioCacheInfo>{};
+}
+
 void AudioEngine::addTask(const std::function<void()>& task)
 {
     lazyInit();
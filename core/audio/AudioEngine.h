@@ -33,6 +33,7 @@
 #include <list>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 #ifdef ERROR
 #    undef ERROR
@@ -83,6 +84,29 @@ public:
     AudioProfile() : maxInstances(0), minDelay(0.0) {}
 };
 
+/**
+ * @class AudioCacheInfo
+ *
+ * @brief Memory held by the audio engine for one cached audio file.
+ * @js NA
+ */
+class AX_DLL AudioCacheInfo
+{
+public:
+    // Full path of the audio file.
+    std::string filePath;
+    // Bytes of decoded PCM data, or of the queue buffers if the file is streamed.
+    size_t pcmBytes;
+    // Bytes of the undecoded file kept in memory, see `AudioEngine::CacheMode::COMPRESSED`.
+    size_t compressedBytes;
+    // Whether the file is too large to be decoded at once and is streamed while playing.
+    bool streaming;
+    // The number of audio instances using the cache, a cache in use is never evicted.
+    unsigned int playerCount;
+
+    AudioCacheInfo() : pcmBytes(0), compressedBytes(0), streaming(false), playerCount(0) {}
+};
+
 class AudioEngineImpl;
 
 /**
@@ -106,6 +130,16 @@ public:
         PAUSED
     };
 
+    /** CacheMode enum, how preloaded audio data is kept in memory. */
+    enum class CacheMode
+    {
+        // Decode the whole file on preload and keep the PCM data until it's uncached or evicted.
+        PCM,
+        // Keep the undecoded file in memory on preload, it's decoded on a worker when first played and
+        // decoded again from memory if the PCM data was evicted meanwhile.
+        COMPRESSED
+    };
+
     static const int INVALID_AUDIO_ID;
 
     static const float TIME_UNKNOWN;
@@ -316,6 +350,30 @@ public:
      */
     static void preload(std::string_view filePath, std::function<void(bool isSuccess)> callback);
 
+    /**
+     * Sets how audio data is cached by the later 'preload' and 'play2d' calls, default is CacheMode::PCM.
+     */
+    static void setCacheMode(CacheMode mode) { _cacheMode = mode; }
+    static CacheMode getCacheMode() { return _cacheMode; }
+
+    /**
+     * Sets the budget in bytes for decoded PCM data, 0 means unlimited (default).
+     * When the budget is exceeded the least recently played caches which aren't in use are evicted, they are loaded
+     * again on the next 'play2d'.
+     */
+    static void setCacheBudget(size_t bytes);
+    static size_t getCacheBudget() { return _cacheBudget; }
+
+    /**
+     * Gets the bytes of all cached audio data, decoded and compressed.
+     */
+    static size_t getCacheSize();
+
+    /**
+     * Gets the memory held by each cached audio file.
+     */
+    static std::vector<AudioCacheInfo> getCacheInfos();
+
     /**
      * Gets playing audio count.
      */
@@ -384,6 +442,10 @@ protected:
 
     static bool _isEnabled;
 
+    static CacheMode _cacheMode;
+
+    static size_t _cacheBudget;
+
     friend class AudioEngineImpl;
 };
 
@@ -315,7 +315,8 @@ ALvoid ax::AudioEngineImpl::myAlSourceNotificationCallback(ALuint sid, ALuint no
         player = e.second;
         if (player->_alSource == sid && player->_streamingSource)
         {
-            player->wakeupRotateThread();
+            s_instance->_streamer.wakeup();
+            break;
         }
     }
     s_instance->_threadMutex.unlock();
@@ -324,13 +325,15 @@ ALvoid ax::AudioEngineImpl::myAlSourceNotificationCallback(ALuint sid, ALuint no
 
 NS_AX_BEGIN
 
-AudioEngineImpl::AudioEngineImpl() : _scheduled(false), _currentAudioID(0), _scheduler(nullptr)
+AudioEngineImpl::AudioEngineImpl() : _scheduled(false), _currentAudioID(0), _scheduler(nullptr), _cacheTick(0)
 {
     s_instance = this;
 }
 
 AudioEngineImpl::~AudioEngineImpl()
 {
+    _streamer.stop();
+
     if (_scheduled && _scheduler != nullptr)
     {
         _scheduler->unschedule(AX_SCHEDULE_SELECTOR(AudioEngineImpl::update), this);
@@ -494,6 +497,20 @@ bool AudioEngineImpl::init()
     return ret;
 }
 
+static bool loadCompressedData(std::string_view fullPath)
+{
+    // Note: It's in sub thread
+    if (AudioDecoderManager::getMemoryFileSize(fullPath) > 0)
+        return true;
+
+    auto data = FileUtils::getInstance()->getDataFromFile(fullPath);
+    if (data.isNull())
+        return false;
+
+    AudioDecoderManager::addMemoryFile(fullPath, std::move(data));
+    return true;
+}
+
 AudioCache* AudioEngineImpl::preload(std::string_view filePath, std::function<void(bool)> callback)
 {
     AudioCache* audioCache = nullptr;
@@ -506,20 +523,27 @@ AudioCache* AudioEngineImpl::preload(std::string_view filePath, std::function<vo
         audioCache->_fileFullPath = FileUtils::getInstance()->fullPathForFilename(filePath);
         unsigned int cacheId      = audioCache->_id;
         auto isCacheDestroyed     = audioCache->_isDestroyed;
-        AudioEngine::addTask([audioCache, cacheId, isCacheDestroyed]() {
+        bool keepCompressed       = AudioEngine::_cacheMode == AudioEngine::CacheMode::COMPRESSED;
+        AudioEngine::addTask([audioCache, cacheId, isCacheDestroyed, keepCompressed]() {
             if (*isCacheDestroyed)
             {
                 AXLOGV("AudioCache (id={}) was destroyed, no need to launch readDataTask.", cacheId);
                 audioCache->setSkipReadDataTask(true);
                 return;
             }
+            if (keepCompressed)
+                loadCompressedData(audioCache->_fileFullPath);
             audioCache->readDataTask(cacheId);
         });
+
+        // the size is known once loaded, the new cache itself is kept since it's about to be used
+        audioCache->addLoadCallback([this, audioCache](bool) { trimCaches(audioCache); });
     }
     else
     {
         audioCache = it->second.get();
     }
+    audioCache->_lastUsedTick = ++_cacheTick;
 
     if (audioCache && callback)
     {
@@ -528,6 +552,23 @@ AudioCache* AudioEngineImpl::preload(std::string_view filePath, std::function<vo
     return audioCache;
 }
 
+void AudioEngineImpl::preloadCompressed(std::string_view filePath, std::function<void(bool)> callback)
+{
+    // a cache which is loading or loaded already holds the decoded data
+    if (_audioCaches.find(filePath) != _audioCaches.end())
+    {
+        preload(filePath, std::move(callback));
+        return;
+    }
+
+    auto fullPath = FileUtils::getInstance()->fullPathForFilename(filePath);
+    AudioEngine::addTask([fullPath = std::move(fullPath), callback = std::move(callback)]() {
+        bool succeed = loadCompressedData(fullPath);
+        if (callback)
+            Director::getInstance()->getScheduler()->runOnAxmolThread([callback, succeed]() { callback(succeed); });
+    });
+}
+
 AUDIO_ID AudioEngineImpl::play2d(std::string_view filePath, bool loop, float volume, float time)
 {
     if (s_ALDevice == nullptr)
@@ -550,6 +591,7 @@ AUDIO_ID AudioEngineImpl::play2d(std::string_view filePath, bool loop, float vol
     player->_alSource = alSource;
     player->_loop     = loop;
     player->_volume   = volume;
+    player->_streamer = &_streamer;
     if (time > 0.0f)
     {
         player->_currTime  = time;
@@ -941,6 +983,8 @@ void AudioEngineImpl::_updatePlayers(bool forStop)
 
         if (_audioPlayers.empty())
             _unscheduleUpdate();
+
+        trimCaches(nullptr);
     }
     else if (!_audioPlayers.empty() && !_finishCallbacks.empty())
         _unscheduleUpdate();
@@ -957,7 +1001,14 @@ void AudioEngineImpl::_unscheduleUpdate()
 
 void AudioEngineImpl::uncache(std::string_view filePath)
 {
-    _audioCaches.erase(filePath);
+    auto it = _audioCaches.find(filePath);
+    if (it != _audioCaches.end())
+    {
+        AudioDecoderManager::removeMemoryFile(it->second->_fileFullPath);
+        _audioCaches.erase(it);
+    }
+    else
+        AudioDecoderManager::removeMemoryFile(FileUtils::getInstance()->fullPathForFilename(filePath));
 }
 
 void AudioEngineImpl::uncacheAll()
@@ -967,6 +1018,94 @@ void AudioEngineImpl::uncacheAll()
         player.second->setCache(nullptr);
 
     _audioCaches.clear();
+    AudioDecoderManager::removeAllMemoryFiles();
+}
+
+void AudioEngineImpl::trimCaches(AudioCache* keep)
+{
+    const size_t budget = AudioEngine::_cacheBudget;
+    if (budget == 0)
+        return;
+
+    size_t totalBytes = 0;
+    for (auto&& item : _audioCaches)
+        totalBytes += item.second->_sizeInBytes;
+    if (totalBytes <= budget)
+        return;
+
+    std::lock_guard<std::recursive_mutex> lck(_threadMutex);
+
+    // players hold the cache from play2d on, even while waiting for it to be loaded
+    std::vector<AudioCache*> cachesInUse;
+    for (auto&& item : _audioPlayers)
+    {
+        if (item.second->_audioCache)
+            cachesInUse.emplace_back(item.second->_audioCache);
+    }
+
+    std::vector<std::pair<uint64_t, std::string>> candidates;
+    for (auto&& item : _audioCaches)
+    {
+        auto cache = item.second.get();
+        if (cache == keep || cache->_state != AudioCache::State::READY || !cache->_isLoadingFinished ||
+            std::find(cachesInUse.begin(), cachesInUse.end(), cache) != cachesInUse.end())
+            continue;
+        candidates.emplace_back(cache->_lastUsedTick, item.first);
+    }
+    std::sort(candidates.begin(), candidates.end());
+
+    for (auto&& candidate : candidates)
+    {
+        if (totalBytes <= budget)
+            break;
+
+        auto it = _audioCaches.find(candidate.second);
+        AXLOGV("Evict audio cache {}, {} bytes", candidate.second, it->second->_sizeInBytes);
+        totalBytes -= it->second->_sizeInBytes;
+        _audioCaches.erase(it);
+    }
+}
+
+size_t AudioEngineImpl::getCacheSize()
+{
+    size_t totalBytes = 0;
+    for (auto&& item : _audioCaches)
+        totalBytes += item.second->_sizeInBytes;
+    AudioDecoderManager::forEachMemoryFile([&totalBytes](std::string_view, size_t size) { totalBytes += size; });
+    return totalBytes;
+}
+
+std::vector<AudioCacheInfo> AudioEngineImpl::getCacheInfos()
+{
+    std::vector<AudioCacheInfo> infos;
+    {
+        std::lock_guard<std::recursive_mutex> lck(_threadMutex);
+        for (auto&& item : _audioCaches)
+        {
+            auto cache = item.second.get();
+            auto& info = infos.emplace_back();
+            info.filePath  = cache->_fileFullPath;
+            info.pcmBytes  = cache->_sizeInBytes;
+            info.streaming = cache->_queBufferFrames > 0;
+            for (auto&& player : _audioPlayers)
+            {
+                if (player.second->_audioCache == cache)
+                    ++info.playerCount;
+            }
+        }
+    }
+
+    AudioDecoderManager::forEachMemoryFile([&infos](std::string_view fullPath, size_t size) {
+        auto it = std::find_if(infos.begin(), infos.end(),
+                               [fullPath](const AudioCacheInfo& info) { return info.filePath == fullPath; });
+        if (it == infos.end())
+        {
+            it           = infos.emplace(infos.end());
+            it->filePath = fullPath;
+        }
+        it->compressedBytes = size;
+    });
+    return infos;
 }
 NS_AX_END
 #undef LOG_TAG
@@ -34,8 +34,10 @@
 
 #    include "base/Object.h"
 #    include "audio/AudioMacros.h"
+#    include "audio/AudioEngine.h"
 #    include "audio/AudioCache.h"
 #    include "audio/AudioPlayer.h"
+#    include "audio/AudioStreamer.h"
 
 NS_AX_BEGIN
 
@@ -63,8 +65,14 @@ public:
     void uncache(std::string_view filePath);
     void uncacheAll();
     AudioCache* preload(std::string_view filePath, std::function<void(bool)> callback);
+    void preloadCompressed(std::string_view filePath, std::function<void(bool)> callback);
     void update(float dt);
 
+    // evicts the least recently used caches which aren't in use until the PCM data fits AudioEngine's budget
+    void trimCaches(AudioCache* keep);
+    size_t getCacheSize();
+    std::vector<AudioCacheInfo> getCacheInfos();
+
 private:
     // query players state per frame and dispatch finish callback if possible
     void _updatePlayers(bool forStop);
@@ -86,6 +94,9 @@ private:
     std::unordered_map<AUDIO_ID, AudioPlayer*> _audioPlayers;
     std::recursive_mutex _threadMutex;
 
+    // refills the queued buffers of all streaming players
+    AudioStreamer _streamer;
+
     // finish callbacks
     std::vector<std::function<void()>> _finishCallbacks;
 
@@ -93,6 +104,8 @@ private:
 
     AUDIO_ID _currentAudioID;
     Scheduler* _scheduler;
+
+    uint64_t _cacheTick;
 };
 
 NS_AX_END
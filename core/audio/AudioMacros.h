@@ -30,8 +30,14 @@
 
 #include <functional>
 
-#define QUEUEBUFFER_NUM (3)
-#define QUEUEBUFFER_TIME_STEP (0.05f)
+// Number and length (in seconds) of the buffers queued per streaming source, override at build time to trade
+// memory and decode work against underrun safety
+#ifndef QUEUEBUFFER_NUM
+#    define QUEUEBUFFER_NUM (3)
+#endif
+#ifndef QUEUEBUFFER_TIME_STEP
+#    define QUEUEBUFFER_TIME_STEP (0.05f)
+#endif
 
 #define QUOTEME_(x) #x
 #define QUOTEME(x) QUOTEME_(x)
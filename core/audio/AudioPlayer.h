@@ -29,9 +29,7 @@
 #include "platform/PlatformConfig.h"
 
 #include <string>
-#include <condition_variable>
 #include <mutex>
-#include <thread>
 
 #include "audio/AudioMacros.h"
 #include "platform/PlatformMacros.h"
@@ -40,11 +38,14 @@
 NS_AX_BEGIN
 
 class AudioCache;
+class AudioDecoder;
 class AudioEngineImpl;
+class AudioStreamer;
 
 class AX_DLL AudioPlayer
 {
     friend class AudioEngineImpl;
+    friend class AudioStreamer;
 
 public:
     AudioPlayer();
@@ -61,11 +62,10 @@ public:
 
 protected:
     void setCache(AudioCache* cache);
-    void rotateBufferThread(int offsetFrame);
+    void rotateBuffers();
+    bool openStream();
+    void closeStream();
     bool play2d();
-#if defined(__APPLE__)
-    void wakeupRotateThread();
-#endif
 
     AudioCache* _audioCache;
 
@@ -82,14 +82,12 @@ protected:
     float _currTime;
     bool _streamingSource;
     ALuint _bufferIds[QUEUEBUFFER_NUM];
-    std::thread* _rotateBufferThread;
-    std::condition_variable _sleepCondition;
-    std::mutex _sleepMutex;
+    AudioStreamer* _streamer;
+    AudioDecoder* _streamDecoder;  // opened when the stream starts, read by the streamer
+    char* _streamBuffer;
+    int _streamOffsetFrame;
     bool _timeDirty;
-    bool _isRotateThreadExited;
-#if defined(__APPLE__)
-    std::atomic_bool _needWakeupRotateThread;
-#endif
+    bool _streamFinished;
 
     std::mutex _play2dMutex;
 
@@ -0,0 +1,133 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+
+#define LOG_TAG "AudioStreamer"
+
+#include "audio/AudioStreamer.h"
+#include "audio/AudioPlayer.h"
+#include "audio/AudioMacros.h"
+
+#include <algorithm>
+
+#include "yasio/thread_name.hpp"
+
+NS_AX_BEGIN
+
+AudioStreamer::AudioStreamer() : _rotatingPlayer(nullptr), _needWakeup(false), _stopped(false) {}
+
+AudioStreamer::~AudioStreamer()
+{
+    stop();
+}
+
+void AudioStreamer::add(AudioPlayer* player)
+{
+    std::lock_guard<std::mutex> lck(_mutex);
+    if (_stopped)
+        return;
+
+    _players.emplace_back(player);
+    if (!_thread.joinable())
+        _thread = std::thread(&AudioStreamer::run, this);
+    _condition.notify_one();
+}
+
+void AudioStreamer::remove(AudioPlayer* player)
+{
+    std::unique_lock<std::mutex> lck(_mutex);
+    auto it = std::find(_players.begin(), _players.end(), player);
+    if (it != _players.end())
+        _players.erase(it);
+
+    // the worker may be refilling its queue right now
+    _rotated.wait(lck, [this, player] { return _rotatingPlayer != player; });
+}
+
+void AudioStreamer::wakeup()
+{
+    // may be called from an OpenAL thread, don't wait for the worker
+    _needWakeup = true;
+    _condition.notify_one();
+}
+
+void AudioStreamer::stop()
+{
+    {
+        std::lock_guard<std::mutex> lck(_mutex);
+        _stopped = true;
+        _players.clear();
+    }
+    _condition.notify_one();
+    if (_thread.joinable())
+        _thread.join();
+}
+
+size_t AudioStreamer::getStreamCount()
+{
+    std::lock_guard<std::mutex> lck(_mutex);
+    return _players.size();
+}
+
+void AudioStreamer::run()
+{
+    yasio::set_thread_name("axmol-audio");
+
+    const auto interval = std::chrono::milliseconds(static_cast<long long>(QUEUEBUFFER_TIME_STEP * 1000) / 2);
+
+    std::vector<AudioPlayer*> players;
+    std::unique_lock<std::mutex> lck(_mutex);
+    while (!_stopped)
+    {
+        if (_players.empty())
+        {
+            _condition.wait(lck, [this] { return _stopped || !_players.empty(); });
+            continue;
+        }
+
+        // refill without holding the lock, players may be added or removed meanwhile
+        players = _players;
+        for (auto player : players)
+        {
+            if (std::find(_players.begin(), _players.end(), player) == _players.end())
+                continue;
+
+            _rotatingPlayer = player;
+            lck.unlock();
+            player->rotateBuffers();
+            lck.lock();
+            _rotatingPlayer = nullptr;
+            _rotated.notify_all();
+        }
+
+        if (!_needWakeup)
+            _condition.wait_for(lck, interval, [this] { return _stopped || _needWakeup.load(); });
+        _needWakeup = false;
+    }
+    AXLOGV("{}", "Exit audio streaming thread ...");
+}
+
+NS_AX_END
+
+#undef LOG_TAG
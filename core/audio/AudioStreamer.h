@@ -0,0 +1,79 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+
+#pragma once
+
+#include "platform/PlatformConfig.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "platform/PlatformMacros.h"
+
+NS_AX_BEGIN
+
+class AudioPlayer;
+
+/**
+ * Refills the buffer queues of all streaming AudioPlayers from one worker thread.
+ * The thread is started with the first stream and wakes up every QUEUEBUFFER_TIME_STEP / 2 seconds.
+ */
+class AX_DLL AudioStreamer
+{
+public:
+    AudioStreamer();
+    ~AudioStreamer();
+
+    /** Starts refilling the queue of a playing streaming source. */
+    void add(AudioPlayer* player);
+
+    /** Stops refilling the queue, the worker doesn't touch the player anymore once it returns. */
+    void remove(AudioPlayer* player);
+
+    /** Refills the queues right away, e.g. when the OpenAL implementation notifies processed buffers. */
+    void wakeup();
+
+    /** Stops the worker thread, players which are still added are no longer refilled. */
+    void stop();
+
+    size_t getStreamCount();
+
+private:
+    void run();
+
+    std::thread _thread;
+    std::mutex _mutex;  // guards _players and _rotatingPlayer, not held while a queue is refilled
+    std::condition_variable _condition;
+    std::condition_variable _rotated;
+    std::vector<AudioPlayer*> _players;
+    AudioPlayer* _rotatingPlayer;  // the player whose queue the worker is refilling
+    std::atomic_bool _needWakeup;
+    bool _stopped;
+};
+
+NS_AX_END
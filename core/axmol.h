@@ -48,7 +48,7 @@ THE SOFTWARE.
 #include "base/IMEDispatcher.h"
 #include "base/Map.h"
 #include "base/NS.h"
-#include "base/Profiling.h"
+#include "base/Trace.h"
 #include "base/Properties.h"
 #include "base/Object.h"
 #include "base/RefPtr.h"
@@ -237,14 +237,13 @@ THE SOFTWARE.
 #    define AX_NODE_DEBUG_VERIFY_EVENT_LISTENERS 0
 #endif
 
-/** @def AX_ENABLE_PROFILERS
- * If enabled, will activate various profilers within cocos2d. This statistical data will be output to the console
- * once per second showing average time (in milliseconds) required to execute the specific routine(s).
- * Useful for debugging purposes only. It is recommended to leave it disabled.
- * To enable set it to a value different than 0. Disabled by default.
+/** @def AX_ENABLE_TRACE
+ * If enabled, scopes instrumented with AX_TRACE_SCOPE can be recorded by the TraceRecorder at runtime.
+ * Recording is stopped by default and costs one atomic load per scope, so it is enabled by default.
+ * To disable set it to 0.
  */
-#ifndef AX_ENABLE_PROFILERS
-#    define AX_ENABLE_PROFILERS 0
+#ifndef AX_ENABLE_TRACE
+#    define AX_ENABLE_TRACE 1
 #endif
 
 /** Enable Lua engine debug log. */
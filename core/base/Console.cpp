@@ -52,6 +52,7 @@
 #include "renderer/TextureCache.h"
 #include "base/Utils.h"
 #include "base/UTF8.h"
+#include "base/Trace.h"
 
 #include "yasio/xxsocket.hpp"
 
@@ -367,6 +368,7 @@ Console::Console()
     createCommandSceneGraph();
     createCommandTexture();
     createCommandTouch();
+    createCommandTrace();
     createCommandUpload();
     createCommandVersion();
 }
@@ -944,6 +946,23 @@ void Console::createCommandTouch()
                             AX_CALLBACK_2(Console::commandTouchSubCommandSwipe, this)});
 }
 
+void Console::createCommandTrace()
+{
+    addCommand({"trace",
+                "Record traced scopes and save them as a Chrome trace. Args: [-h | help | start | stop | clear | save | ]",
+                AX_CALLBACK_2(Console::commandTrace, this)});
+    addSubCommand("trace", {"start", "Start recording the traced scopes.",
+                            AX_CALLBACK_2(Console::commandTraceSubCommandStartStop, this)});
+    addSubCommand("trace", {"stop", "Stop recording the traced scopes.",
+                            AX_CALLBACK_2(Console::commandTraceSubCommandStartStop, this)});
+    addSubCommand("trace", {"clear", "Discard the recorded scopes.",
+                            AX_CALLBACK_2(Console::commandTraceSubCommandClear, this)});
+    addSubCommand("trace", {"save",
+                            "trace save [filename]: save the recorded scopes as a Chrome trace JSON file in the "
+                            "writable path, trace.json by default.",
+                            AX_CALLBACK_2(Console::commandTraceSubCommandSave, this)});
+}
+
 void Console::createCommandUpload()
 {
     addCommand(
@@ -1156,6 +1175,40 @@ void Console::commandTexturesSubCommandFlush(socket_native_type /*fd*/, std::str
     sched->runOnAxmolThread([]() { Director::getInstance()->getTextureCache()->removeAllTextures(); });
 }
 
+void Console::commandTrace(socket_native_type fd, std::string_view /*args*/)
+{
+    Console::Utility::mydprintf(fd, "Trace is: %s\n", TraceRecorder::isEnabled() ? "started" : "stopped");
+}
+
+void Console::commandTraceSubCommandStartStop(socket_native_type /*fd*/, std::string_view args)
+{
+    if (args.compare("start") == 0)
+        TraceRecorder::start();
+    else
+        TraceRecorder::stop();
+}
+
+void Console::commandTraceSubCommandClear(socket_native_type /*fd*/, std::string_view /*args*/)
+{
+    Scheduler* sched = Director::getInstance()->getScheduler();
+    sched->runOnAxmolThread([]() { TraceRecorder::clear(); });
+}
+
+void Console::commandTraceSubCommandSave(socket_native_type fd, std::string_view args)
+{
+    auto argv            = Console::Utility::split(args, ' ');
+    std::string filename = argv.size() > 1 ? argv[1] : "trace.json";
+    Scheduler* sched     = Director::getInstance()->getScheduler();
+    sched->runOnAxmolThread([=]() {
+        auto path = FileUtils::getInstance()->getWritablePath() + filename;
+        if (TraceRecorder::saveChromeTrace(path))
+            Console::Utility::mydprintf(fd, "Trace saved to %s\n", path.c_str());
+        else
+            Console::Utility::mydprintf(fd, "Failed to save the trace to %s\n", path.c_str());
+        Console::Utility::sendPrompt(fd);
+    });
+}
+
 void Console::commandTouchSubCommandTap(socket_native_type fd, std::string_view args)
 {
     auto argv = Console::Utility::split(args, ' ');
@@ -225,6 +225,7 @@ protected:
     void createCommandSceneGraph();
     void createCommandTexture();
     void createCommandTouch();
+    void createCommandTrace();
     void createCommandUpload();
     void createCommandVersion();
 
@@ -254,6 +255,10 @@ protected:
     void commandTexturesSubCommandFlush(socket_native_type fd, std::string_view args);
     void commandTouchSubCommandTap(socket_native_type fd, std::string_view args);
     void commandTouchSubCommandSwipe(socket_native_type fd, std::string_view args);
+    void commandTrace(socket_native_type fd, std::string_view args);
+    void commandTraceSubCommandStartStop(socket_native_type fd, std::string_view args);
+    void commandTraceSubCommandClear(socket_native_type fd, std::string_view args);
+    void commandTraceSubCommandSave(socket_native_type fd, std::string_view args);
     void commandUpload(socket_native_type fd);
     void commandVersion(socket_native_type fd, std::string_view args);
     // file descriptor: socket, console, etc.
@@ -59,6 +59,7 @@ THE SOFTWARE.
 #include "base/Configuration.h"
 #include "base/AsyncTaskPool.h"
 #include "base/ObjectFactory.h"
+#include "base/Trace.h"
 #include "platform/Application.h"
 #if defined(AX_ENABLE_AUDIO)
 #    include "audio/AudioEngine.h"
@@ -119,6 +120,8 @@ bool Director::init()
     auto concurrency = Configuration::getInstance()->getValue("axmol.concurrency", Value{-1}).asInt();
     _jobSystem = new JobSystem(concurrency);
 
+    TraceRecorder::setThreadName("axmol-main");
+
 #ifdef AX_ENABLE_CONSOLE
     _console = new Console();
 #endif
@@ -312,6 +315,10 @@ void Director::drawScene()
         // clear draw stats
         _renderer->clearDrawStats();
 
+        // update the transforms ahead, the scene visit only submits render commands
+        if (_transformPassEnabled)
+            _runningScene->prepareTransforms(_runningScene->getNodeToParentTransform(), 0);
+
         // render the scene
         if (_glView)
             _glView->renderScene(_runningScene, _renderer);
@@ -1538,6 +1545,8 @@ void Director::processOperations()
 
 void Director::mainLoop()
 {
+    AX_TRACE_SCOPE("Director::mainLoop");
+
 #if defined(AX_PLATFORM_PC)
     processOperations();
 #endif
@@ -504,6 +504,26 @@ public:
      */
     void resetMatrixStack();
 
+    /**
+     * Enables/disables maintaining the deprecated model view matrix stack while visiting nodes, enabled by default.
+     * Disable it when nothing reads the model view matrix from Node::draw or Node::visit overrides.
+     */
+    void setMatrixStackEnabled(bool enabled) { _matrixStackEnabled = enabled; }
+    bool isMatrixStackEnabled() const { return _matrixStackEnabled; }
+
+    /**
+     * Enables/disables the transform pass, disabled by default.
+     * When enabled, the model view transforms of the running scene are updated in parallel on the JobSystem
+     * before it's visited, so that visiting only submits render commands.
+     * Node::getNodeToParentTransform is then called on the workers for several nodes at once, its overrides must
+     * only read the node and its ancestors and write the node's own members: no retain, release or autorelease, no
+     * change to other nodes or to shared state. A node which can't, like AttachNode, overrides
+     * Node::prepareSubtreeTransforms to do nothing, its subtree is then updated by the visit.
+     * @see Node::prepareTransforms
+     */
+    void setTransformPassEnabled(bool enabled) { _transformPassEnabled = enabled; }
+    bool isTransformPassEnabled() const { return _transformPassEnabled; }
+
     /**
      * returns the axmol thread id.
      Useful to know if certain code is already running on the axmol thread
@@ -673,6 +693,9 @@ protected:
 
     bool _childrenIndexerEnabled = false;
 
+    bool _matrixStackEnabled   = true;
+    bool _transformPassEnabled = false;
+
     /* axmol thread id */
     std::thread::id _axmol_thread_id;
 
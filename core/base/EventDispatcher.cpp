@@ -192,7 +192,8 @@ void EventDispatcher::EventListenerVector::clear()
     clearFixedListeners();
 }
 
-EventDispatcher::EventDispatcher() : _inDispatch(0), _isEnabled(false), _nodePriorityIndex(0)
+EventDispatcher::EventDispatcher()
+    : _inDispatch(0), _isEnabled(false), _nodePriorityIndex(0), _hitTestIndexEnabled(false)
 {
     _toAddedListeners.reserve(50);
     _toRemovedListeners.reserve(50);
@@ -357,6 +358,8 @@ void EventDispatcher::pauseEventListenersForTarget(Node* target, bool recursive
         for (auto&& l : *listeners)
         {
             l->setPaused(true);
+            // the node may be leaving the scene, which moves its listeners last
+            l->_isMoved = true;
         }
     }
 
@@ -475,10 +478,13 @@ void EventDispatcher::associateNodeAndEventListener(Node* node, EventListener* l
     }
 
     listeners->emplace_back(listener);
+    addToHitTestIndex(listener);
 }
 
 void EventDispatcher::dissociateNodeAndEventListener(Node* node, EventListener* listener)
 {
+    removeFromHitTestIndex(listener);
+
     std::vector<EventListener*>* listeners = nullptr;
     auto found                             = _nodeListenersMap.find(node);
     if (found != _nodeListenersMap.end())
@@ -539,6 +545,7 @@ void EventDispatcher::forceAddEventListener(EventListener* listener)
     if (listener->getFixedPriority() == 0)
     {
         setDirty(listenerID, DirtyFlag::SCENE_GRAPH_PRIORITY);
+        listener->_isMoved = true;
 
         auto node = listener->getAssociatedNode();
         AXASSERT(node != nullptr, "Invalid scene graph priority!");
@@ -861,6 +868,13 @@ void EventDispatcher::dispatchEventToListeners(EventListenerVector* listeners,
 
 void EventDispatcher::dispatchTouchEventToListeners(EventListenerVector* listeners,
                                                     const std::function<bool(EventListener*)>& onEvent)
+{
+    dispatchTouchEventToListeners(listeners, onEvent, nullptr);
+}
+
+void EventDispatcher::dispatchTouchEventToListeners(EventListenerVector* listeners,
+                                                    const std::function<bool(EventListener*)>& onEvent,
+                                                    Touch* hitTestTouch)
 {
     bool shouldStopPropagation       = false;
     auto fixedPriorityListeners      = listeners->getFixedPriorityListeners();
@@ -896,11 +910,14 @@ void EventDispatcher::dispatchTouchEventToListeners(EventListenerVector* listene
 
             // first, get all enabled, unPaused and registered listeners
             std::vector<EventListener*> sceneListeners;
-            for (auto&& l : *sceneGraphPriorityListeners)
+            if (hitTestTouch == nullptr)
             {
-                if (l->isEnabled() && !l->isPaused() && l->isRegistered())
+                for (auto&& l : *sceneGraphPriorityListeners)
                 {
-                    sceneListeners.emplace_back(l);
+                    if (l->isEnabled() && !l->isPaused() && l->isRegistered())
+                    {
+                        sceneListeners.emplace_back(l);
+                    }
                 }
             }
             // second, for all camera call all listeners
@@ -917,6 +934,13 @@ void EventDispatcher::dispatchTouchEventToListeners(EventListenerVector* listene
 
                 Camera::_visitingCamera = camera;
                 auto cameraFlag         = (unsigned short)camera->getCameraFlag();
+                if (hitTestTouch)
+                {
+                    // the touch location is seen differently by each camera
+                    sceneListeners.clear();
+                    getHitTestCandidates(camera, Director::getInstance()->getWinSize(), hitTestTouch->getLocation(),
+                                         sceneListeners);
+                }
                 for (auto&& l : sceneListeners)
                 {
                     if (nullptr == l->getAssociatedNode() ||
@@ -1128,8 +1152,12 @@ void EventDispatcher::dispatchTouchEvent(EventTouch* event)
                 return false;
             };
 
-            //
-            dispatchTouchEventToListeners(oneByOneListeners, onTouchEvent);
+            // only the listeners whose node is under the touch may claim it
+            Touch* hitTestTouch = nullptr;
+            if (_hitTestIndexEnabled && event->getEventCode() == EventTouch::EventCode::BEGAN)
+                hitTestTouch = touches;
+
+            dispatchTouchEventToListeners(oneByOneListeners, onTouchEvent, hitTestTouch);
             if (event->isStopped())
             {
                 return;
@@ -1328,6 +1356,7 @@ void EventDispatcher::updateDirtyFlagForSceneGraph()
                 for (auto&& l : *iter->second)
                 {
                     setDirty(l->getListenerID(), DirtyFlag::SCENE_GRAPH_PRIORITY);
+                    l->_isMoved = true;
                 }
             }
         }
@@ -1382,17 +1411,27 @@ void EventDispatcher::sortEventListenersOfSceneGraphPriority(std::string_view li
     if (sceneGraphListeners == nullptr)
         return;
 
-    // Reset priority index
-    _nodePriorityIndex = 0;
-    _nodePriorityMap.clear();
+    if (!sortMovedListenersOfSceneGraphPriority(sceneGraphListeners, rootNode))
+    {
+        // Reset priority index
+        _nodePriorityIndex = 0;
+        _nodePriorityMap.clear();
+
+        visitTarget(rootNode, true);
 
-    visitTarget(rootNode, true);
+        // After sort: priority < 0, > 0
+        std::stable_sort(sceneGraphListeners->begin(), sceneGraphListeners->end(),
+                         [this](const EventListener* l1, const EventListener* l2) {
+                             return _nodePriorityMap[l1->getAssociatedNode()] >
+                                    _nodePriorityMap[l2->getAssociatedNode()];
+                         });
 
-    // After sort: priority < 0, > 0
-    std::stable_sort(sceneGraphListeners->begin(), sceneGraphListeners->end(),
-                     [this](const EventListener* l1, const EventListener* l2) {
-                         return _nodePriorityMap[l1->getAssociatedNode()] > _nodePriorityMap[l2->getAssociatedNode()];
-                     });
+        for (auto&& l : *sceneGraphListeners)
+            l->_isMoved = false;
+    }
+
+    if (_hitTestIndexEnabled && listenerID == EventListenerTouchOneByOne::LISTENER_ID)
+        updateHitTestRanks(*sceneGraphListeners);
 
 #if DUMP_LISTENER_ITEM_PRIORITY_INFO
     AXLOGI("-----------------------------------");
@@ -1404,6 +1443,93 @@ void EventDispatcher::sortEventListenersOfSceneGraphPriority(std::string_view li
 #endif
 }
 
+bool EventDispatcher::sortMovedListenersOfSceneGraphPriority(std::vector<EventListener*>* listeners, Node* rootNode)
+{
+    const auto movedCount = std::count_if(listeners->begin(), listeners->end(),
+                                          [](const EventListener* l) { return l->_isMoved; });
+    if (movedCount * 4 > static_cast<ptrdiff_t>(listeners->size()))
+        return false;
+
+    // the other listeners stay sorted, their nodes didn't move relative to each other
+    std::vector<EventListener*> moved;
+    moved.reserve(movedCount);
+    listeners->erase(std::remove_if(listeners->begin(), listeners->end(),
+                                    [&moved](EventListener* l) {
+                                        if (!l->_isMoved)
+                                            return false;
+                                        l->_isMoved = false;
+                                        moved.emplace_back(l);
+                                        return true;
+                                    }),
+                     listeners->end());
+
+    auto isBefore = [this, rootNode](const EventListener* l1, const EventListener* l2) {
+        return isDispatchedBefore(l1->getAssociatedNode(), l2->getAssociatedNode(), rootNode);
+    };
+    std::stable_sort(moved.begin(), moved.end(), isBefore);
+    for (auto&& l : moved)
+        listeners->insert(std::upper_bound(listeners->begin(), listeners->end(), l, isBefore), l);
+
+    return true;
+}
+
+bool EventDispatcher::isDispatchedBefore(Node* a, Node* b, Node* rootNode)
+{
+    if (a == b)
+        return false;
+
+    // the ancestors of the nodes from rootNode down, empty if the node isn't in the scene
+    auto& pathA  = _dispatchPathA;
+    auto& pathB  = _dispatchPathB;
+    auto getPath = [rootNode](Node* node, std::vector<Node*>& path) {
+        path.clear();
+        for (; node; node = node->getParent())
+            path.emplace_back(node);
+        if (path.empty() || path.back() != rootNode)
+            path.clear();
+        std::reverse(path.begin(), path.end());
+    };
+    getPath(a, pathA);
+    getPath(b, pathB);
+
+    if (pathA.empty() || pathB.empty())
+        return !pathA.empty();
+
+    // the later a node is drawn, the earlier its listeners get the events
+    if (a->_globalZOrder != b->_globalZOrder)
+        return a->_globalZOrder > b->_globalZOrder;
+
+    size_t depth = 1;
+    while (depth < pathA.size() && depth < pathB.size() && pathA[depth] == pathB[depth])
+        ++depth;
+
+    // one is an ancestor of the other, which is drawn first if it's in front of the branch of the other one
+    if (depth == pathA.size())
+        return pathB[depth]->_localZOrder < 0;
+    if (depth == pathB.size())
+        return pathA[depth]->_localZOrder >= 0;
+
+    // siblings, drawn like visitTarget does: children < 0, protected children < 0, children >= 0, protected >= 0
+    auto parent        = pathA[depth - 1];
+    auto childA        = pathA[depth];
+    auto childB        = pathB[depth];
+    auto protectedNode = dynamic_cast<ProtectedNode*>(parent);
+    auto getDrawGroup  = [protectedNode](Node* child) {
+        int group = child->_localZOrder < 0 ? 0 : 2;
+        if (protectedNode && protectedNode->getProtectedChildren().contains(child))
+            ++group;
+        return group;
+    };
+
+    const int groupA = getDrawGroup(childA);
+    const int groupB = getDrawGroup(childB);
+    if (groupA != groupB)
+        return groupA > groupB;
+    if (childA->_localZOrder != childB->_localZOrder)
+        return childA->_localZOrder > childB->_localZOrder;
+    return childA->_orderOfArrival > childB->_orderOfArrival;
+}
+
 void EventDispatcher::sortEventListenersOfFixedPriority(std::string_view listenerID)
 {
     auto listeners = getListeners(listenerID);
@@ -1620,6 +1746,158 @@ void EventDispatcher::setDirty(std::string_view listenerID, DirtyFlag flag)
     }
 }
 
+void EventDispatcher::setHitTestIndexEnabled(bool enabled)
+{
+    if (_hitTestIndexEnabled == enabled)
+        return;
+
+    auto listeners           = getListeners(EventListenerTouchOneByOne::LISTENER_ID);
+    auto sceneGraphListeners = listeners ? listeners->getSceneGraphPriorityListeners() : nullptr;
+    if (enabled)
+    {
+        _hitTestIndexEnabled = true;
+        if (sceneGraphListeners)
+        {
+            for (auto&& l : *sceneGraphListeners)
+            {
+                if (l->isRegistered())
+                    addToHitTestIndex(l);
+            }
+            updateHitTestRanks(*sceneGraphListeners);
+        }
+    }
+    else
+    {
+        if (sceneGraphListeners)
+        {
+            for (auto&& l : *sceneGraphListeners)
+                removeFromHitTestIndex(l);
+        }
+        _hitTestIndexEnabled = false;
+
+        _hitTestGrid.clear();
+        _hitTestListeners.clear();
+        _unindexedTouchListeners.clear();
+    }
+}
+
+void EventDispatcher::setHitTestIndexed(EventListenerTouchOneByOne* listener, bool indexed)
+{
+    if (listener == nullptr || listener->_hitTestIndexed == indexed)
+        return;
+
+    // only the listeners the index knows of are moved, the others are picked up when they're added or sorted
+    bool known = listener->_hitTestSlot >= 0 || std::find(_unindexedTouchListeners.begin(),
+                                                          _unindexedTouchListeners.end(),
+                                                          listener) != _unindexedTouchListeners.end();
+    removeFromHitTestIndex(listener);
+    listener->_hitTestIndexed = indexed;
+    if (known)
+    {
+        if (indexed)
+            addToHitTestIndex(listener);
+        else
+            _unindexedTouchListeners.emplace_back(listener);  // keeps its rank
+    }
+}
+
+void EventDispatcher::addToHitTestIndex(EventListener* listener)
+{
+    if (!_hitTestIndexEnabled || listener->getType() != EventListener::Type::TOUCH_ONE_BY_ONE)
+        return;
+
+    auto touchListener = static_cast<EventListenerTouchOneByOne*>(listener);
+    if (!touchListener->_hitTestIndexed || touchListener->_hitTestSlot >= 0)
+        return;
+
+    auto node                   = touchListener->getAssociatedNode();
+    touchListener->_hitTestSlot = _hitTestGrid.add(node);
+    ++node->_hitTestListeners;
+
+    if (static_cast<size_t>(touchListener->_hitTestSlot) >= _hitTestListeners.size())
+        _hitTestListeners.resize(touchListener->_hitTestSlot + 1);
+    _hitTestListeners[touchListener->_hitTestSlot] = touchListener;
+}
+
+void EventDispatcher::removeFromHitTestIndex(EventListener* listener)
+{
+    if (!_hitTestIndexEnabled || listener->getType() != EventListener::Type::TOUCH_ONE_BY_ONE)
+        return;
+
+    auto touchListener = static_cast<EventListenerTouchOneByOne*>(listener);
+    if (touchListener->_hitTestSlot >= 0)
+    {
+        _hitTestGrid.remove(touchListener->_hitTestSlot);
+        _hitTestListeners[touchListener->_hitTestSlot] = nullptr;
+        touchListener->_hitTestSlot                    = -1;
+        --touchListener->getAssociatedNode()->_hitTestListeners;
+    }
+    else
+    {
+        auto iter = std::find(_unindexedTouchListeners.begin(), _unindexedTouchListeners.end(), touchListener);
+        if (iter != _unindexedTouchListeners.end())
+            _unindexedTouchListeners.erase(iter);
+    }
+}
+
+void EventDispatcher::invalidateHitTestBounds(Node* node)
+{
+    auto listenerIter = _nodeListenersMap.find(node);
+    if (listenerIter == _nodeListenersMap.end())
+        return;
+
+    for (auto&& l : *listenerIter->second)
+    {
+        if (l->getType() == EventListener::Type::TOUCH_ONE_BY_ONE)
+        {
+            auto touchListener = static_cast<EventListenerTouchOneByOne*>(l);
+            if (touchListener->_hitTestSlot >= 0)
+                _hitTestGrid.invalidate(touchListener->_hitTestSlot);
+        }
+    }
+}
+
+void EventDispatcher::updateHitTestRanks(const std::vector<EventListener*>& listeners)
+{
+    _unindexedTouchListeners.clear();
+
+    size_t rank = 0;
+    for (auto&& l : listeners)
+    {
+        auto touchListener             = static_cast<EventListenerTouchOneByOne*>(l);
+        touchListener->_sceneGraphRank = rank++;
+        if (touchListener->_hitTestSlot < 0 && touchListener->getAssociatedNode() != nullptr)
+            _unindexedTouchListeners.emplace_back(touchListener);
+    }
+}
+
+void EventDispatcher::getHitTestCandidates(const Camera* camera,
+                                           const Size& winSize,
+                                           const Vec2& point,
+                                           std::vector<EventListener*>& listeners)
+{
+    auto isAvailable = [](const EventListener* l) { return l->isEnabled() && !l->isPaused() && l->isRegistered(); };
+
+    _hitTestSlots.clear();
+    _hitTestGrid.query(camera, winSize, point, _hitTestSlots);
+    for (auto slot : _hitTestSlots)
+    {
+        if (isAvailable(_hitTestListeners[slot]))
+            listeners.emplace_back(_hitTestListeners[slot]);
+    }
+
+    for (auto&& l : _unindexedTouchListeners)
+    {
+        if (isAvailable(l))
+            listeners.emplace_back(l);
+    }
+
+    std::sort(listeners.begin(), listeners.end(), [](const EventListener* l1, const EventListener* l2) {
+        return static_cast<const EventListenerTouchOneByOne*>(l1)->_sceneGraphRank <
+               static_cast<const EventListenerTouchOneByOne*>(l2)->_sceneGraphRank;
+    });
+}
+
 void EventDispatcher::cleanToRemovedListeners()
 {
     for (auto&& l : _toRemovedListeners)
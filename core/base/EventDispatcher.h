@@ -35,6 +35,7 @@
 #include "platform/PlatformMacros.h"
 #include "base/EventListener.h"
 #include "base/Event.h"
+#include "base/HitTestGrid.h"
 #include "platform/StdC.h"
 
 /**
@@ -49,6 +50,9 @@ class EventTouch;
 class Node;
 class EventCustom;
 class EventListenerCustom;
+class EventListenerTouchOneByOne;
+class Camera;
+class Touch;
 
 /** @class EventDispatcher
 * @brief This class manages event listener subscriptions
@@ -189,6 +193,27 @@ public:
      */
     bool hasEventListener(std::string_view listenerID) const;
 
+    /** Enables/disables the hit-test index of the touch listeners, disabled by default.
+     * When enabled, the EventListenerTouchOneByOne listeners with scene graph priority which are hit-test indexed
+     * are only offered the touches that begin inside the screen bounds of their node's content rect, looked up in a
+     * grid per camera instead of calling every onTouchBegan. The bounds are refreshed when the nodes are drawn, so
+     * touches hit the nodes where they were last seen.
+     *
+     * @param enabled True if the touch listeners are hit-test indexed.
+     * @see EventListenerTouchOneByOne::setHitTestIndexed
+     */
+    void setHitTestIndexEnabled(bool enabled);
+    bool isHitTestIndexEnabled() const { return _hitTestIndexEnabled; }
+
+    /** Changes whether a touch listener is hit-test indexed, it may already be added.
+     * Unlike adding the listener again, the touches it claimed are kept.
+     *
+     * @param listener A given touch listener.
+     * @param indexed True if the listener can be skipped for touches outside of its node.
+     * @see EventListenerTouchOneByOne::setHitTestIndexed
+     */
+    void setHitTestIndexed(EventListenerTouchOneByOne* listener, bool indexed);
+
     /////////////////////////////////////////////
 
     /** Constructor of EventDispatcher.
@@ -268,6 +293,16 @@ protected:
     /** Sorts the listeners of specified type by scene graph priority */
     void sortEventListenersOfSceneGraphPriority(std::string_view listenerID, Node* rootNode);
 
+    /** Reinserts the listeners whose node was added or reordered since the last sort among the sorted ones, instead
+     * of visiting the whole scene. Returns false if so many moved that a full sort is cheaper.
+     */
+    bool sortMovedListenersOfSceneGraphPriority(std::vector<EventListener*>* listeners, Node* rootNode);
+
+    /** Returns true if the listeners of node a receive events before those of node b, the order set by visitTarget.
+     * The nodes which aren't in the scene of rootNode come last.
+     */
+    bool isDispatchedBefore(Node* a, Node* b, Node* rootNode);
+
     /** Sorts the listeners of specified type by fixed priority */
     void sortEventListenersOfFixedPriority(std::string_view listenerID);
 
@@ -297,9 +332,13 @@ protected:
      *      order by viewport/camera first, because the touch location convert
      *      to 3D world space is different by different camera.
      *  When listener process touch event, can get current camera by Camera::getVisitingCamera().
+     *  When hitTestTouch is given, only the scene graph listeners that may claim it are offered the event.
      */
     void dispatchTouchEventToListeners(EventListenerVector* listeners,
                                        const std::function<bool(EventListener*)>& onEvent);
+    void dispatchTouchEventToListeners(EventListenerVector* listeners,
+                                       const std::function<bool(EventListener*)>& onEvent,
+                                       Touch* hitTestTouch);
 
     void releaseListener(EventListener* listener);
 
@@ -322,6 +361,24 @@ protected:
     /** Remove all listeners in _toRemoveListeners list and cleanup */
     void cleanToRemovedListeners();
 
+    /** Adds a scene graph priority listener to the hit-test index if it's an indexed touch listener */
+    void addToHitTestIndex(EventListener* listener);
+
+    /** Removes a scene graph priority listener from the hit-test index */
+    void removeFromHitTestIndex(EventListener* listener);
+
+    /** Marks the hit-test bounds of the node as outdated, called by Node when it's drawn with a new transform */
+    void invalidateHitTestBounds(Node* node);
+
+    /** Records the positions of the sorted touch listeners, and collects those which aren't indexed */
+    void updateHitTestRanks(const std::vector<EventListener*>& listeners);
+
+    /** Gathers the scene graph touch listeners which may claim a touch beginning at point, in priority order */
+    void getHitTestCandidates(const Camera* camera,
+                              const Size& winSize,
+                              const Vec2& point,
+                              std::vector<EventListener*>& listeners);
+
     /** Listeners map */
     hlookup::string_map<EventListenerVector*> _listenerMap;
 
@@ -355,6 +412,23 @@ protected:
     int _nodePriorityIndex;
 
     std::set<std::string> _internalCustomListenerIDs;
+
+    /** The screen bounds of the nodes of the hit-test indexed touch listeners */
+    HitTestGrid _hitTestGrid;
+
+    /** The hit-test indexed touch listeners, by slot in _hitTestGrid */
+    std::vector<EventListenerTouchOneByOne*> _hitTestListeners;
+
+    /** The scene graph priority touch listeners which aren't hit-test indexed, in priority order */
+    std::vector<EventListenerTouchOneByOne*> _unindexedTouchListeners;
+
+    std::vector<int> _hitTestSlots;
+
+    bool _hitTestIndexEnabled;
+
+    /** The ancestors of the two nodes compared by isDispatchedBefore, kept to avoid allocations */
+    std::vector<Node*> _dispatchPathA;
+    std::vector<Node*> _dispatchPathB;
 };
 
 NS_AX_END
@@ -43,6 +43,7 @@ bool EventListener::init(Type t, std::string_view listenerID, const std::functio
     _isRegistered = false;
     _paused       = false;
     _isEnabled    = true;
+    _isMoved      = false;
 
     return true;
 }
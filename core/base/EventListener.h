@@ -176,6 +176,7 @@ protected:
     Node* _node;         // scene graph based priority
     bool _paused;        // Whether the listener is paused
     bool _isEnabled;     // Whether the listener is enabled
+    bool _isMoved;       // Whether the node was added or reordered in the scene graph since the last sort
     friend class EventDispatcher;
 };
 
@@ -40,6 +40,9 @@ EventListenerTouchOneByOne::EventListenerTouchOneByOne()
     , onTouchEnded(nullptr)
     , onTouchCancelled(nullptr)
     , _needSwallow(false)
+    , _hitTestIndexed(false)
+    , _hitTestSlot(-1)
+    , _sceneGraphRank(0)
 {}
 
 EventListenerTouchOneByOne::~EventListenerTouchOneByOne()
@@ -108,6 +111,7 @@ EventListenerTouchOneByOne* EventListenerTouchOneByOne::clone()
 
         ret->_claimedTouches = _claimedTouches;
         ret->_needSwallow    = _needSwallow;
+        ret->_hitTestIndexed = _hitTestIndexed;
     }
     else
     {
@@ -69,6 +69,16 @@ public:
      */
     bool isSwallowTouches();
 
+    /** Declares that onTouchBegan only claims touches inside the content rect of the associated node.
+     * This lets the EventDispatcher skip the listener for touches elsewhere when its hit-test index is enabled, set it
+     * before adding the listener, or with EventDispatcher::setHitTestIndexed once added.
+     *
+     * @param indexed True if the listener can be skipped for touches outside of its node.
+     * @see EventDispatcher::setHitTestIndexEnabled
+     */
+    void setHitTestIndexed(bool indexed) { _hitTestIndexed = indexed; }
+    bool isHitTestIndexed() const { return _hitTestIndexed; }
+
     /// Overrides
     virtual EventListenerTouchOneByOne* clone() override;
     virtual bool checkAvailable() override;
@@ -89,6 +99,9 @@ public:
 private:
     std::vector<Touch*> _claimedTouches;
     bool _needSwallow;
+    bool _hitTestIndexed;
+    int _hitTestSlot;        // the slot in the hit-test grid of the EventDispatcher, -1 if not indexed
+    size_t _sceneGraphRank;  // the position among the scene graph listeners at the last sort
 
     friend class EventDispatcher;
 };
@@ -0,0 +1,243 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include "base/HitTestGrid.h"
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <cstring>
+
+#include "2d/Camera.h"
+#include "2d/Node.h"
+
+NS_AX_BEGIN
+
+namespace
+{
+// cells along the longer side of the window
+constexpr float GRID_RESOLUTION = 32.0f;
+// the bounds are widened by that much in GL units, so that rounding can't reject points on the edges
+constexpr float BOUNDS_MARGIN = 1.0f;
+// views of the cameras that aren't queried anymore are dropped past that many
+constexpr size_t MAX_VIEWS = 8;
+}  // namespace
+
+int HitTestGrid::add(Node* node)
+{
+    int slot;
+    if (!_freeSlots.empty())
+    {
+        slot = _freeSlots.back();
+        _freeSlots.pop_back();
+        _nodes[slot] = node;
+    }
+    else
+    {
+        slot = static_cast<int>(_nodes.size());
+        _nodes.emplace_back(node);
+    }
+
+    for (auto&& view : _views)
+        markDirty(view, slot);
+    return slot;
+}
+
+void HitTestGrid::remove(int slot)
+{
+    for (auto&& view : _views)
+        unplace(view, slot);
+
+    _nodes[slot] = nullptr;
+    _freeSlots.emplace_back(slot);
+}
+
+void HitTestGrid::invalidate(int slot)
+{
+    for (auto&& view : _views)
+        markDirty(view, slot);
+}
+
+void HitTestGrid::clear()
+{
+    _nodes.clear();
+    _freeSlots.clear();
+    _views.clear();
+}
+
+void HitTestGrid::query(const Camera* camera, const Size& winSize, const Vec2& point, std::vector<int>& slots)
+{
+    auto& view = getView(camera, winSize);
+
+    for (auto slot : view.dirty)
+    {
+        view.dirtyMarks[slot] = 0;
+        unplace(view, slot);
+        if (_nodes[slot])
+            place(view, slot);
+    }
+    view.dirty.clear();
+
+    const int column = static_cast<int>(std::clamp(point.x / view.cellSize, 0.0f, view.columns - 1.0f));
+    const int row    = static_cast<int>(std::clamp(point.y / view.cellSize, 0.0f, view.rows - 1.0f));
+    for (auto slot : view.cells[row * view.columns + column])
+    {
+        if (view.bounds[slot].containsPoint(point))
+            slots.emplace_back(slot);
+    }
+    slots.insert(slots.end(), view.unbounded.begin(), view.unbounded.end());
+}
+
+HitTestGrid::View& HitTestGrid::getView(const Camera* camera, const Size& winSize)
+{
+    auto it = std::find_if(_views.begin(), _views.end(), [camera](const View& view) { return view.camera == camera; });
+    if (it == _views.end())
+    {
+        if (_views.size() >= MAX_VIEWS)
+            _views.erase(_views.begin());
+
+        auto& view  = _views.emplace_back();
+        view.camera = camera;
+        resetView(view, winSize);
+        return view;
+    }
+
+    // moving the camera or resizing the window moves everything on screen
+    if (memcmp(&it->viewProjection, &camera->getViewProjectionMatrix(), sizeof(Mat4)) != 0 ||
+        !it->winSize.equals(winSize))
+        resetView(*it, winSize);
+    return *it;
+}
+
+void HitTestGrid::resetView(View& view, const Size& winSize)
+{
+    view.viewProjection = view.camera->getViewProjectionMatrix();
+    view.winSize        = winSize;
+    view.cellSize       = std::max(1.0f, std::max(view.winSize.width, view.winSize.height) / GRID_RESOLUTION);
+    view.columns        = std::max(1, static_cast<int>(std::ceil(view.winSize.width / view.cellSize)));
+    view.rows           = std::max(1, static_cast<int>(std::ceil(view.winSize.height / view.cellSize)));
+
+    view.cells.assign(view.columns * view.rows, {});
+    view.unbounded.clear();
+    view.dirty.clear();
+
+    const size_t count = _nodes.size();
+    view.bounds.assign(count, Rect::ZERO);
+    view.ranges.assign(count * 4, 0);
+    view.placements.assign(count, Placement::NONE);
+    view.dirtyMarks.assign(count, 0);
+    for (size_t slot = 0; slot < count; ++slot)
+    {
+        if (_nodes[slot])
+            markDirty(view, static_cast<int>(slot));
+    }
+}
+
+void HitTestGrid::markDirty(View& view, int slot)
+{
+    if (static_cast<size_t>(slot) >= view.placements.size())
+    {
+        const size_t count = _nodes.size();
+        view.bounds.resize(count, Rect::ZERO);
+        view.ranges.resize(count * 4, 0);
+        view.placements.resize(count, Placement::NONE);
+        view.dirtyMarks.resize(count, 0);
+    }
+
+    if (!view.dirtyMarks[slot])
+    {
+        view.dirtyMarks[slot] = 1;
+        view.dirty.emplace_back(slot);
+    }
+}
+
+void HitTestGrid::place(View& view, int slot)
+{
+    const auto& size = _nodes[slot]->getContentSize();
+    const Mat4 transform = view.viewProjection * _nodes[slot]->getNodeToWorldTransform();
+    const Vec2 corners[] = {Vec2::ZERO, Vec2(size.width, 0.0f), Vec2(0.0f, size.height), Vec2(size.width, size.height)};
+
+    // same as Camera::projectGL
+    float minX = FLT_MAX, minY = FLT_MAX, maxX = -FLT_MAX, maxY = -FLT_MAX;
+    for (auto&& corner : corners)
+    {
+        Vec4 clipPos;
+        transform.transformVector(Vec4(corner.x, corner.y, 0.0f, 1.0f), &clipPos);
+
+        const float x = (clipPos.x / clipPos.w + 1.0f) * 0.5f * view.winSize.width;
+        const float y = (clipPos.y / clipPos.w + 1.0f) * 0.5f * view.winSize.height;
+        if (clipPos.w <= FLT_EPSILON || !std::isfinite(x) || !std::isfinite(y))
+        {
+            view.placements[slot] = Placement::UNBOUNDED;
+            view.unbounded.emplace_back(slot);
+            return;
+        }
+
+        minX = std::min(minX, x);
+        minY = std::min(minY, y);
+        maxX = std::max(maxX, x);
+        maxY = std::max(maxY, y);
+    }
+
+    view.bounds[slot] = Rect(minX - BOUNDS_MARGIN, minY - BOUNDS_MARGIN, maxX - minX + BOUNDS_MARGIN * 2,
+                             maxY - minY + BOUNDS_MARGIN * 2);
+
+    int* range = &view.ranges[slot * 4];
+    range[0]   = static_cast<int>(std::clamp(view.bounds[slot].getMinX() / view.cellSize, 0.0f, view.columns - 1.0f));
+    range[1]   = static_cast<int>(std::clamp(view.bounds[slot].getMinY() / view.cellSize, 0.0f, view.rows - 1.0f));
+    range[2]   = static_cast<int>(std::clamp(view.bounds[slot].getMaxX() / view.cellSize, 0.0f, view.columns - 1.0f));
+    range[3]   = static_cast<int>(std::clamp(view.bounds[slot].getMaxY() / view.cellSize, 0.0f, view.rows - 1.0f));
+    for (int row = range[1]; row <= range[3]; ++row)
+    {
+        for (int column = range[0]; column <= range[2]; ++column)
+            view.cells[row * view.columns + column].emplace_back(slot);
+    }
+    view.placements[slot] = Placement::CELLS;
+}
+
+void HitTestGrid::unplace(View& view, int slot)
+{
+    if (static_cast<size_t>(slot) >= view.placements.size())
+        return;
+
+    if (view.placements[slot] == Placement::CELLS)
+    {
+        const int* range = &view.ranges[slot * 4];
+        for (int row = range[1]; row <= range[3]; ++row)
+        {
+            for (int column = range[0]; column <= range[2]; ++column)
+            {
+                auto& cell = view.cells[row * view.columns + column];
+                cell.erase(std::find(cell.begin(), cell.end(), slot));
+            }
+        }
+    }
+    else if (view.placements[slot] == Placement::UNBOUNDED)
+    {
+        view.unbounded.erase(std::find(view.unbounded.begin(), view.unbounded.end(), slot));
+    }
+    view.placements[slot] = Placement::NONE;
+}
+
+NS_AX_END
@@ -0,0 +1,112 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#pragma once
+
+#include <vector>
+
+#include "base/Macros.h"
+#include "math/Mat4.h"
+#include "math/Rect.h"
+
+NS_AX_BEGIN
+
+class Node;
+class Camera;
+
+/**
+ * @addtogroup base
+ * @{
+ */
+
+/** @class HitTestGrid
+ * @brief Finds the nodes whose content rect may contain a touch point.
+ *
+ * Each node's content rect is projected by every camera it's queried with, and the screen-space boxes are bucketed
+ * into a uniform grid covering the window. Nodes are only reprojected after invalidate, so a query costs one cell
+ * lookup plus the nodes moved since the previous one. Rects that cross the near plane of a camera can't be bounded
+ * on screen, they are returned by every query of that camera.
+ * @js NA
+ */
+class AX_DLL HitTestGrid
+{
+public:
+    /** Starts tracking the node, returns its slot. */
+    int add(Node* node);
+
+    /** Stops tracking the node of the slot, the slot may be reused by the next add. */
+    void remove(int slot);
+
+    /** Marks the bounds of the slot as outdated, they're reprojected by the next query. */
+    void invalidate(int slot);
+
+    void clear();
+
+    /** Appends the slots whose screen bounds seen by camera in a window of winSize contain point, given in GL
+     * coordinates. */
+    void query(const Camera* camera, const Size& winSize, const Vec2& point, std::vector<int>& slots);
+
+protected:
+    enum class Placement : uint8_t
+    {
+        NONE,
+        CELLS,
+        UNBOUNDED
+    };
+
+    /// The screen-space grid of one camera.
+    struct View
+    {
+        const Camera* camera;
+        Mat4 viewProjection;
+        Size winSize;
+        float cellSize;
+        int columns;
+        int rows;
+        std::vector<std::vector<int>> cells;
+        std::vector<int> unbounded;
+        std::vector<int> dirty;
+
+        // per slot
+        std::vector<Rect> bounds;
+        std::vector<int> ranges;  // first column, first row, last column, last row
+        std::vector<Placement> placements;
+        std::vector<uint8_t> dirtyMarks;
+    };
+
+    View& getView(const Camera* camera, const Size& winSize);
+    void resetView(View& view, const Size& winSize);
+    void markDirty(View& view, int slot);
+    void place(View& view, int slot);
+    void unplace(View& view, int slot);
+
+    std::vector<Node*> _nodes;
+    std::vector<int> _freeSlots;
+    std::vector<View> _views;
+};
+
+// end of base group
+/** @} */
+
+NS_AX_END
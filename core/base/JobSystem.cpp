@@ -1,106 +1,328 @@
 #include "base/JobSystem.h"
 #include "base/Director.h"
+#include "base/Scheduler.h"
+#include "base/Trace.h"
 #include "yasio/thread_name.hpp"
 
-#include <queue>
+#include <deque>
 #include <thread>
 #include <mutex>
+#include <atomic>
+#include <chrono>
 #include <condition_variable>
-#include <future>
 #include <functional>
 #include <stdexcept>
 
 NS_AX_BEGIN
 
+struct JobState
+{
+    std::function<void(JobThreadData*)> job;
+    JobPriority priority{JobPriority::High};
+    JobExecutor* executor{nullptr};
+
+    // the dependencies not finished yet, plus one released once the job is fully scheduled
+    std::atomic<int> pendingDependencies{1};
+    // set once the job is in a worker deque, claimed by the first one to run it: a worker or a waiter
+    std::atomic<bool> queued{false};
+    std::atomic<bool> claimed{false};
+    std::atomic<bool> done{false};
+
+    std::mutex mutex;
+    std::condition_variable finished;
+    std::vector<std::shared_ptr<JobState>> continuations;
+};
+
 #pragma region JobExecutor
 class JobExecutor
 {
 public:
-    explicit JobExecutor(std::span<std::shared_ptr<JobThreadData>> tdds) : stop(false)
+    static constexpr int PRIORITY_COUNT = 2;
+
+    JobExecutor(std::span<std::shared_ptr<JobThreadData>> tdds, JobThreadData* mainThreadData)
+        : _mainThreadData(mainThreadData)
     {
-        for (auto thread_data : tdds)
-            workers.emplace_back([this, thread_data] {
-                thread_data->init();
-                yasio::set_thread_name(thread_data->name());
-                for (;;)
-                {
-                    std::function<void(JobThreadData*)> task;
-                    {
-                        std::unique_lock<std::mutex> lock(this->queue_mutex);
-                        this->condition.wait(lock, [this] { return this->stop || !this->tasks.empty(); });
-                        if (this->stop && this->tasks.empty())
-                            break;
-                        task = std::move(this->tasks.front());
-                        this->tasks.pop();
-                    }
+        // keep some workers for the frame when background jobs block on I/O
+        const int count      = static_cast<int>(tdds.size());
+        const int reserved   = (std::max)(static_cast<int>(std::thread::hardware_concurrency()) / 2, 1);
+        _maxBackgroundWorkers = (std::max)(count - reserved, 1);
 
-                    task(thread_data.get());
-                }
-                thread_data->finz();
-            });
+        for (auto& thread_data : tdds)
+        {
+            auto worker  = std::make_unique<Worker>();
+            worker->data = thread_data;
+            _workers.emplace_back(std::move(worker));
+        }
+
+        for (size_t index = 0; index < _workers.size(); ++index)
+            _workers[index]->thread = std::thread([this, index] { workerLoop(index); });
     }
-    template <class F, class... Args>
-    auto enqueue(F&& f, Args&&... args) -> std::future<typename std::invoke_result<F(Args...)>::type>
+
+    ~JobExecutor()
     {
-        using return_type = typename std::invoke_result<F(Args...)>::type;
+        {
+            std::unique_lock<std::mutex> lock(_sleepMutex);
+            _stop = true;
+        }
+        _wakeup.notify_all();
+        for (auto& worker : _workers)
+            worker->thread.join();
+    }
 
-        auto task = std::make_shared<std::packaged_task<return_type(size_t)>>(
-            std::bind(std::forward<F>(f), std::placeholders::_1, std::forward<Args>(args)...));
+    int getWorkerCount() const { return static_cast<int>(_workers.size()); }
 
-        std::future<return_type> res = task->get_future();
+    void submit(std::shared_ptr<JobState> state, const std::vector<JobHandle>& dependencies)
+    {
+        state->executor = this;
+        for (auto& dependency : dependencies)
         {
-            std::unique_lock<std::mutex> lock(queue_mutex);
+            auto& other = dependency._state;
+            if (!other)
+                continue;
+            std::lock_guard<std::mutex> lock(other->mutex);
+            if (!other->done.load(std::memory_order_acquire))
+            {
+                state->pendingDependencies.fetch_add(1, std::memory_order_relaxed);
+                other->continuations.emplace_back(state);
+            }
+        }
 
-            // don't allow enqueueing after stopping the pool
-            if (stop)
-                throw std::runtime_error("enqueue on stopped executor");
+        if (state->pendingDependencies.fetch_sub(1, std::memory_order_acq_rel) == 1)
+            push(std::move(state));
+    }
 
-            tasks.emplace([task](JobThreadData* thread_data) { (*task)(thread_data); });
+    // Run a queued high priority job on the calling thread, returns false if there was none.
+    // A worker waiting from a background job also runs background jobs: its own slot is idle meanwhile.
+    bool runOne()
+    {
+        const bool isWorker = t_executor == this;
+        auto state = pop(isWorker ? t_workerIndex : _workers.size(), isWorker && t_runningBackground, true);
+        if (!state)
+            return false;
+        run(state, isWorker ? _workers[t_workerIndex]->data.get() : _mainThreadData);
+        return true;
+    }
+
+    // Run the job on the calling thread if it is queued and no one took it yet, returns false otherwise.
+    bool runInline(const std::shared_ptr<JobState>& state)
+    {
+        if (!state->queued.load(std::memory_order_acquire) || state->claimed.exchange(true, std::memory_order_acq_rel))
+            return false;
+        _queued[static_cast<int>(state->priority)].fetch_sub(1, std::memory_order_relaxed);
+
+        // not counted as a running background job, the waiter's slot is idle anyway
+        const bool isWorker = t_executor == this;
+        run(state, isWorker ? _workers[t_workerIndex]->data.get() : _mainThreadData, false);
+        return true;
+    }
+
+private:
+    struct Worker
+    {
+        std::mutex mutex;
+        std::deque<std::shared_ptr<JobState>> queues[PRIORITY_COUNT];
+        std::shared_ptr<JobThreadData> data;
+        std::thread thread;
+    };
+
+    void push(std::shared_ptr<JobState> state)
+    {
+        // jobs scheduled by a worker go to its own deque, the others are spread over the workers
+        const auto lane = static_cast<int>(state->priority);
+        auto& worker    = t_executor == this ? *_workers[t_workerIndex]
+                                             : *_workers[_nextWorker.fetch_add(1, std::memory_order_relaxed) %
+                                                         _workers.size()];
+        {
+            std::lock_guard<std::mutex> lock(worker.mutex);
+            worker.queues[lane].emplace_back(state);
+            // under the lock, pop() can only take and uncount the job once it's counted
+            _queued[lane].fetch_add(1, std::memory_order_release);
         }
-        condition.notify_one();
-        return res;
+        // likewise for runInline(), which uncounts the job it claims once it's marked queued
+        state->queued.store(true, std::memory_order_release);
+
+        {
+            // pairs with the predicate check of sleeping workers
+            std::lock_guard<std::mutex> lock(_sleepMutex);
+        }
+        _wakeup.notify_one();
     }
 
-    template <class F, class... Args>
-    void enqueue_v(F&& f, Args&&... args)
+    std::shared_ptr<JobState> pop(size_t self, bool allowBackground, bool ignoreBackgroundLimit = false)
     {
-        auto task = std::bind(std::forward<F>(f), std::placeholders::_1, std::forward<Args>(args)...);
+        for (int lane = 0; lane < PRIORITY_COUNT; ++lane)
+        {
+            const bool background = lane == static_cast<int>(JobPriority::Background);
+            if (background && !allowBackground)
+                break;
+            if (_queued[lane].load(std::memory_order_acquire) == 0)
+                continue;
+            if (background && _runningBackground.fetch_add(1, std::memory_order_acq_rel) >= _maxBackgroundWorkers &&
+                !ignoreBackgroundLimit)
+            {
+                _runningBackground.fetch_sub(1, std::memory_order_acq_rel);
+                continue;
+            }
 
+            // newest own high priority job first, it is likely still in cache, then the oldest jobs of the others;
+            // background jobs such as loads always run oldest first
+            const size_t count = _workers.size();
+            for (size_t i = 0; i < count; ++i)
+            {
+                const size_t index = (self + i) % count;
+                auto& worker       = *_workers[index];
+                std::lock_guard<std::mutex> lock(worker.mutex);
+                auto& queue = worker.queues[lane];
+                while (!queue.empty())
+                {
+                    std::shared_ptr<JobState> state;
+                    if (index == self && !background)
+                    {
+                        state = std::move(queue.back());
+                        queue.pop_back();
+                    }
+                    else
+                    {
+                        state = std::move(queue.front());
+                        queue.pop_front();
+                    }
+
+                    // already run inline by a waiter, which uncounted it
+                    if (state->claimed.exchange(true, std::memory_order_acq_rel))
+                        continue;
+                    _queued[lane].fetch_sub(1, std::memory_order_relaxed);
+                    return state;
+                }
+            }
+
+            if (background)
+                _runningBackground.fetch_sub(1, std::memory_order_acq_rel);
+        }
+        return nullptr;
+    }
+
+    void run(const std::shared_ptr<JobState>& state, JobThreadData* thread_data, bool counted = true)
+    {
+        const bool background = counted && state->priority == JobPriority::Background;
+        {
+            AX_TRACE_SCOPE("JobSystem::task");
+            const bool wasRunningBackground = t_runningBackground;
+            t_runningBackground             = background || wasRunningBackground;
+            state->job(thread_data);
+            t_runningBackground = wasRunningBackground;
+        }
+        state->job = nullptr;
+
+        std::vector<std::shared_ptr<JobState>> continuations;
         {
-            std::unique_lock<std::mutex> lock(queue_mutex);
+            std::lock_guard<std::mutex> lock(state->mutex);
+            state->done.store(true, std::memory_order_release);
+            continuations.swap(state->continuations);
+        }
+        state->finished.notify_all();
 
-            // don't allow enqueueing after stopping the pool
-            if (stop)
-                throw std::runtime_error("enqueue on stopped executor");
+        if (background)
+        {
+            _runningBackground.fetch_sub(1, std::memory_order_acq_rel);
+            if (_queued[static_cast<int>(JobPriority::Background)].load(std::memory_order_acquire) != 0)
+            {
+                std::lock_guard<std::mutex> lock(_sleepMutex);
+                _wakeup.notify_one();
+            }
+        }
 
-            tasks.emplace(std::move(task));
+        for (auto& continuation : continuations)
+        {
+            if (continuation->pendingDependencies.fetch_sub(1, std::memory_order_acq_rel) == 1)
+                push(std::move(continuation));
         }
-        condition.notify_one();
     }
-    ~JobExecutor()
+
+    bool hasRunnableJobs() const
     {
+        return _queued[static_cast<int>(JobPriority::High)].load(std::memory_order_acquire) != 0 ||
+               (_queued[static_cast<int>(JobPriority::Background)].load(std::memory_order_acquire) != 0 &&
+                _runningBackground.load(std::memory_order_acquire) < _maxBackgroundWorkers);
+    }
+
+    void workerLoop(size_t index)
+    {
+        auto thread_data = _workers[index]->data.get();
+        t_executor       = this;
+        t_workerIndex    = index;
+
+        thread_data->init();
+        yasio::set_thread_name(thread_data->name());
+        TraceRecorder::setThreadName(thread_data->name());
+        for (;;)
         {
-            std::unique_lock<std::mutex> lock(queue_mutex);
-            stop = true;
+            if (auto state = pop(index, true))
+            {
+                run(state, thread_data);
+                continue;
+            }
+
+            std::unique_lock<std::mutex> lock(_sleepMutex);
+            _wakeup.wait(lock, [this] { return _stop || hasRunnableJobs(); });
+            // like before, the queued jobs are still run when stopping
+            if (_stop && _queued[0].load() == 0 && _queued[1].load() == 0)
+                break;
         }
-        condition.notify_all();
-        for (std::thread& worker : workers)
-            worker.join();
+        thread_data->finz();
     }
 
-private:
-    // need to keep track of threads so we can join them
-    std::vector<std::thread> workers;
+    static thread_local JobExecutor* t_executor;
+    static thread_local size_t t_workerIndex;
+    // whether the thread runs a background job, which may be waiting from it
+    static thread_local bool t_runningBackground;
 
-    // the task queue
-    std::queue<std::function<void(JobThreadData*)>> tasks;
+    std::vector<std::unique_ptr<Worker>> _workers;
+    JobThreadData* _mainThreadData;
 
-    // synchronization
-    std::mutex queue_mutex;
-    std::condition_variable condition;
-    bool stop;
+    std::atomic<size_t> _queued[PRIORITY_COUNT]{};
+    std::atomic<int> _runningBackground{0};
+    int _maxBackgroundWorkers{1};
+    std::atomic<size_t> _nextWorker{0};
+
+    std::mutex _sleepMutex;
+    std::condition_variable _wakeup;
+    bool _stop{false};
 };
 
+thread_local JobExecutor* JobExecutor::t_executor = nullptr;
+thread_local size_t JobExecutor::t_workerIndex   = 0;
+thread_local bool JobExecutor::t_runningBackground = false;
+
+#pragma endregion
+
+#pragma region JobHandle
+
+bool JobHandle::isDone() const
+{
+    return !_state || _state->done.load(std::memory_order_acquire);
+}
+
+void JobHandle::wait() const
+{
+    if (!_state)
+        return;
+
+    // still queued: run it here rather than waiting for a worker, whatever its priority
+    if (_state->executor && _state->executor->runInline(_state))
+        return;
+
+    while (!_state->done.load(std::memory_order_acquire))
+    {
+        if (_state->executor && (_state->executor->runInline(_state) || _state->executor->runOne()))
+            continue;
+
+        // nothing to help with, the job runs on a worker: sleep until it's done or more jobs may be queued
+        std::unique_lock<std::mutex> lock(_state->mutex);
+        _state->finished.wait_for(lock, std::chrono::milliseconds(1),
+                                  [this] { return _state->done.load(std::memory_order_acquire); });
+    }
+}
+
 #pragma endregion
 
 #pragma region JobSystem
@@ -149,7 +371,7 @@ void JobSystem::init(const std::span<std::shared_ptr<JobThreadData>>& tdds)
 {
     _mainThreadData = new MainThreadData();
     if (!tdds.empty())
-        _executor = new JobExecutor(tdds);
+        _executor = new JobExecutor(tdds, _mainThreadData);
 }
 
 JobSystem::~JobSystem()
@@ -159,10 +381,101 @@ JobSystem::~JobSystem()
     delete _mainThreadData;
 }
 
+int JobSystem::getWorkerCount() const
+{
+    return _executor ? _executor->getWorkerCount() : 0;
+}
+
+JobHandle JobSystem::schedule(std::function<void()> job,
+                              JobPriority priority,
+                              const std::vector<JobHandle>& dependencies)
+{
+    auto state      = std::make_shared<JobState>();
+    state->priority = priority;
+    if (_executor)
+    {
+        state->job = [job_ = std::move(job)](JobThreadData*) { job_(); };
+        _executor->submit(state, dependencies);
+    }
+    else
+    {
+        // without workers the dependencies already ran
+        job();
+        state->done = true;
+    }
+    return JobHandle{std::move(state)};
+}
+
+void JobSystem::parallel_for(size_t begin, size_t end, size_t grain, const std::function<void(size_t, size_t)>& body)
+{
+    if (begin >= end)
+        return;
+
+    grain               = (std::max)(grain, size_t{1});
+    const size_t chunks = (end - begin + grain - 1) / grain;
+    if (!_executor || chunks == 1)
+    {
+        body(begin, end);
+        return;
+    }
+
+    struct Context
+    {
+        const std::function<void(size_t, size_t)>* body;
+        size_t begin, end, grain, chunks;
+        std::atomic<size_t> next{0};
+        size_t done{0};
+        std::mutex mutex;
+        std::condition_variable finished;
+    };
+    auto context    = std::make_shared<Context>();
+    context->body   = &body;
+    context->begin  = begin;
+    context->end    = end;
+    context->grain  = grain;
+    context->chunks = chunks;
+
+    // each participant claims chunks until none left, so the caller never waits for an idle worker;
+    // jobs starting after the last chunk was claimed return without touching body
+    auto runChunks = [](Context* ctx) {
+        for (size_t c = ctx->next++; c < ctx->chunks; c = ctx->next++)
+        {
+            const size_t first = ctx->begin + c * ctx->grain;
+            (*ctx->body)(first, (std::min)(first + ctx->grain, ctx->end));
+
+            std::lock_guard<std::mutex> lock(ctx->mutex);
+            if (++ctx->done == ctx->chunks)
+                ctx->finished.notify_all();
+        }
+    };
+
+    const size_t helpers = (std::min)(chunks - 1, static_cast<size_t>(_executor->getWorkerCount()));
+    for (size_t i = 0; i < helpers; ++i)
+    {
+        auto state      = std::make_shared<JobState>();
+        state->priority = JobPriority::High;
+        state->job      = [context, runChunks](JobThreadData*) { runChunks(context.get()); };
+        _executor->submit(std::move(state), {});
+    }
+
+    // once the caller runs out of chunks, the remaining ones are being run by workers
+    runChunks(context.get());
+    std::unique_lock<std::mutex> lock(context->mutex);
+    context->finished.wait(lock, [&context, chunks] { return context->done == chunks; });
+}
+
+static void submitBackground(JobExecutor* executor, std::function<void(JobThreadData*)> task)
+{
+    auto state      = std::make_shared<JobState>();
+    state->priority = JobPriority::Background;
+    state->job      = std::move(task);
+    executor->submit(std::move(state), {});
+}
+
 void JobSystem::enqueue_v(std::function<void(JobThreadData*)> task)
 {
     if (_executor)
-        _executor->enqueue_v(std::move(task));
+        submitBackground(_executor, std::move(task));
     else
         task(_mainThreadData);
 }
@@ -187,7 +500,7 @@ void JobSystem::enqueue(std::shared_ptr<JobThreadTask> task)
         }
     };
     if (_executor)
-        _executor->enqueue_v(std::move(taskw));
+        submitBackground(_executor, std::move(taskw));
     else
         taskw(_mainThreadData);
 }
@@ -202,7 +515,7 @@ void JobSystem::enqueue(std::function<void()> task, std::function<void()> done)
             Director::getInstance()->getScheduler()->runOnAxmolThread(done_);
     };
     if (_executor)
-        _executor->enqueue_v(taskw);
+        submitBackground(_executor, std::move(taskw));
     else
         taskw(_mainThreadData);
 }
@@ -40,6 +40,7 @@
 #include <memory>
 #include <string>
 #include <span>
+#include <functional>
 #include "base/Config.h"
 #include "platform/PlatformDefine.h"
 
@@ -47,6 +48,46 @@ NS_AX_BEGIN
 
 class JobExecutor;
 class JobSystem;
+struct JobState;
+
+/** The lane a job is queued in, workers always take high priority jobs first. */
+enum class JobPriority
+{
+    /** Work the current frame waits for, such as the transform pass or the vertex fill. */
+    High,
+    /** Background work such as asset loading, it never occupies all the workers. */
+    Background,
+};
+
+/**
+ A handle to a scheduled job, which can be waited on or passed as a dependency of other jobs.
+ A default constructed handle refers to no job and is always done.
+ */
+class AX_API JobHandle
+{
+    friend class JobSystem;
+    friend class JobExecutor;
+
+public:
+    JobHandle() = default;
+
+    /** Whether the handle refers to a job. */
+    bool isValid() const { return _state != nullptr; }
+    /** Whether the job has finished. */
+    bool isDone() const;
+    /**
+     Block until the job has finished. If no worker took the job yet, it runs on the calling thread.
+     Otherwise the calling thread runs queued high priority jobs meanwhile, and background ones when
+     waiting from a background job, so waiting from a job doesn't starve the workers.
+     */
+    void wait() const;
+
+private:
+    explicit JobHandle(std::shared_ptr<JobState> state) : _state(std::move(state)) {}
+
+    std::shared_ptr<JobState> _state;
+};
+
 class JobThreadData
 {
 public:
@@ -96,6 +137,25 @@ public:
     JobSystem(std::span<std::shared_ptr<JobThreadData>> tdds);
     ~JobSystem();
 
+    /**
+     Schedule a job, which runs once all its dependencies have finished.
+     Workers run their own high priority jobs newest first and steal the oldest jobs of the other workers when
+     idle, background jobs always run oldest first.
+     */
+    JobHandle schedule(std::function<void()> job,
+                       JobPriority priority                      = JobPriority::High,
+                       const std::vector<JobHandle>& dependencies = {});
+
+    /**
+     Split [begin, end) into chunks of grain indices and call body(chunkBegin, chunkEnd) for each of them
+     on the workers and the calling thread, returns once all the chunks are done.
+     */
+    void parallel_for(size_t begin, size_t end, size_t grain, const std::function<void(size_t, size_t)>& body);
+
+    /** The number of worker threads, 0 if jobs run on the calling thread. */
+    int getWorkerCount() const;
+
+    // The enqueue functions schedule background jobs, without handle.
     void enqueue_v(std::function<void(JobThreadData*)> task);
 
     void enqueue(std::function<void()> task);
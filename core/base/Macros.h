@@ -199,108 +199,6 @@ It should work same as apples CFSwapInt32LittleToHost(..)
 #define AX_SWAP_INT32_BIG_TO_HOST(i)    ((AX_HOST_IS_BIG_ENDIAN == true) ? (i) : AX_SWAP32(i))
 #define AX_SWAP_INT16_BIG_TO_HOST(i)    ((AX_HOST_IS_BIG_ENDIAN == true) ? (i) : AX_SWAP16(i))
 
-/**********************/
-/** Profiling Macros **/
-/**********************/
-#if AX_ENABLE_PROFILERS
-
-#    define AX_PROFILER_DISPLAY_TIMERS() NS_AX::Profiler::getInstance()->displayTimers()
-#    define AX_PROFILER_PURGE_ALL()      NS_AX::Profiler::getInstance()->releaseAllTimers()
-
-#    define AX_PROFILER_START(__name__)  NS_AX::ProfilingBeginTimingBlock(__name__)
-#    define AX_PROFILER_STOP(__name__)   NS_AX::ProfilingEndTimingBlock(__name__)
-#    define AX_PROFILER_RESET(__name__)  NS_AX::ProfilingResetTimingBlock(__name__)
-
-#    define AX_PROFILER_START_CATEGORY(__cat__, __name__)   \
-        do                                                  \
-        {                                                   \
-            if (__cat__)                                    \
-                NS_AX::ProfilingBeginTimingBlock(__name__); \
-        } while (0)
-#    define AX_PROFILER_STOP_CATEGORY(__cat__, __name__)  \
-        do                                                \
-        {                                                 \
-            if (__cat__)                                  \
-                NS_AX::ProfilingEndTimingBlock(__name__); \
-        } while (0)
-#    define AX_PROFILER_RESET_CATEGORY(__cat__, __name__)   \
-        do                                                  \
-        {                                                   \
-            if (__cat__)                                    \
-                NS_AX::ProfilingResetTimingBlock(__name__); \
-        } while (0)
-
-#    define AX_PROFILER_START_INSTANCE(__id__, __name__)                                       \
-        do                                                                                     \
-        {                                                                                      \
-            NS_AX::ProfilingBeginTimingBlock(                                                  \
-                NS_AX::String::createWithFormat("%08X - %s", __id__, __name__)->getCString()); \
-        } while (0)
-#    define AX_PROFILER_STOP_INSTANCE(__id__, __name__)                                        \
-        do                                                                                     \
-        {                                                                                      \
-            NS_AX::ProfilingEndTimingBlock(                                                    \
-                NS_AX::String::createWithFormat("%08X - %s", __id__, __name__)->getCString()); \
-        } while (0)
-#    define AX_PROFILER_RESET_INSTANCE(__id__, __name__)                                       \
-        do                                                                                     \
-        {                                                                                      \
-            NS_AX::ProfilingResetTimingBlock(                                                  \
-                NS_AX::String::createWithFormat("%08X - %s", __id__, __name__)->getCString()); \
-        } while (0)
-
-#else
-
-#    define AX_PROFILER_DISPLAY_TIMERS() \
-        do                               \
-        {                                \
-        } while (0)
-#    define AX_PROFILER_PURGE_ALL() \
-        do                          \
-        {                           \
-        } while (0)
-
-#    define AX_PROFILER_START(__name__) \
-        do                              \
-        {                               \
-        } while (0)
-#    define AX_PROFILER_STOP(__name__) \
-        do                             \
-        {                              \
-        } while (0)
-#    define AX_PROFILER_RESET(__name__) \
-        do                              \
-        {                               \
-        } while (0)
-
-#    define AX_PROFILER_START_CATEGORY(__cat__, __name__) \
-        do                                                \
-        {                                                 \
-        } while (0)
-#    define AX_PROFILER_STOP_CATEGORY(__cat__, __name__) \
-        do                                               \
-        {                                                \
-        } while (0)
-#    define AX_PROFILER_RESET_CATEGORY(__cat__, __name__) \
-        do                                                \
-        {                                                 \
-        } while (0)
-
-#    define AX_PROFILER_START_INSTANCE(__id__, __name__) \
-        do                                               \
-        {                                                \
-        } while (0)
-#    define AX_PROFILER_STOP_INSTANCE(__id__, __name__) \
-        do                                              \
-        {                                               \
-        } while (0)
-#    define AX_PROFILER_RESET_INSTANCE(__id__, __name__) \
-        do                                               \
-        {                                                \
-        } while (0)
-
-#endif
-
 /*********************************/
 /** 64bits Program Sense Macros **/
 /*********************************/
@@ -31,6 +31,7 @@ THE SOFTWARE.
 #include "base/Macros.h"
 #include "base/Director.h"
 #include "base/ScriptSupport.h"
+#include "base/Trace.h"
 
 NS_AX_BEGIN
 
@@ -46,6 +47,10 @@ Timer::Timer()
     , _delay(0.0f)
     , _interval(0.0f)
     , _aborted(false)
+    , _deadline(0.0)
+    , _queueIndex(-1)
+    , _queueState(QueueState::None)
+    , _queueStarted(false)
 {}
 
 void Timer::setupTimerWithInterval(float seconds, unsigned int repeat, float delay)
@@ -111,6 +116,47 @@ void Timer::update(float dt)
     }
 }
 
+void Timer::fire(double now)
+{
+    if (_useDelay)
+    {
+        _useDelay = false;
+        _deadline = (_interval > 0) ? _deadline + _interval : now;
+        _timesExecuted += 1;  // important to increment before call trigger
+        trigger(_delay);
+        if (isExhausted())
+        {
+            cancel();
+            return;
+        }
+    }
+    else if (_interval <= 0)
+    {
+        // trigger once every frame with the time since the last trigger
+        auto dt   = static_cast<float>(now - _deadline);
+        _deadline = now;
+        _timesExecuted += 1;
+        trigger(dt);
+        if (isExhausted())
+            cancel();
+        return;
+    }
+
+    // catch up the intervals passed like update does, the deadline moves before the trigger so that a callback
+    // pausing the target keeps the right time left
+    while (_interval > 0 && _deadline <= now && _queueState == QueueState::Firing)
+    {
+        _deadline += _interval;
+        _timesExecuted += 1;
+        trigger(_interval);
+        if (isExhausted())
+        {
+            cancel();
+            break;
+        }
+    }
+}
+
 bool Timer::isExhausted() const
 {
     return !_runForever && _timesExecuted > _repeat;
@@ -231,6 +277,238 @@ Scheduler::Scheduler()
 Scheduler::~Scheduler()
 {
     unscheduleAll();
+
+    for (auto timer : _timersToStart)
+        timer->release();
+}
+
+void Scheduler::setTimerQueueEnabled(bool enabled)
+{
+    AXASSERT(!_indexMapLocked, "Can't switch the timer queue while updating");
+    if (_timerQueueEnabled == enabled)
+        return;
+
+    _timerQueueEnabled = enabled;
+
+    // carry the time left of every timer over to the other backend
+    for (auto& [target, timerHandle] : _timersMap)
+    {
+        for (auto timer : timerHandle.timers)
+        {
+            auto wait = timer->_useDelay ? timer->_delay : std::max(timer->_interval, 0.0f);
+            if (enabled)
+            {
+                if (timer->_elapsed == -1)
+                {
+                    queueTimer(timer, timerHandle.paused);
+                    continue;
+                }
+
+                timer->_queueStarted = true;
+                timer->_deadline     = wait - timer->_elapsed;
+                if (timerHandle.paused)
+                {
+                    timer->_queueState = Timer::QueueState::Paused;
+                }
+                else
+                {
+                    timer->_deadline += _timerClock;
+                    pushTimer(timer);
+                }
+            }
+            else
+            {
+                auto started = timer->_queueStarted && (timer->_queueState == Timer::QueueState::Queued ||
+                                                        timer->_queueState == Timer::QueueState::Paused);
+                if (started)
+                {
+                    auto left = timer->_deadline;
+                    if (timer->_queueState == Timer::QueueState::Queued)
+                        left -= _timerClock;
+                    timer->_elapsed = static_cast<float>(wait - left);
+                }
+                else
+                {
+                    timer->_elapsed = -1;
+                }
+                timer->_queueState = Timer::QueueState::None;
+                timer->_queueIndex = -1;
+            }
+        }
+    }
+
+    if (!enabled)
+    {
+        _timerQueue.clear();
+        for (auto timer : _timersToStart)
+            timer->release();
+        _timersToStart.clear();
+    }
+}
+
+void Scheduler::queueTimer(Timer* timer, bool paused)
+{
+    // a (re)started timer begins to wait at the end of the next update, like the first Timer::update does
+    if (timer->_queueState == Timer::QueueState::Queued)
+        removeTimerAt(timer->_queueIndex);
+
+    timer->_queueStarted = false;
+    if (paused)
+    {
+        timer->_queueState = Timer::QueueState::Paused;
+    }
+    else if (timer->_queueState != Timer::QueueState::Pending)
+    {
+        timer->_queueState = Timer::QueueState::Pending;
+        timer->retain();
+        _timersToStart.emplace_back(timer);
+    }
+}
+
+void Scheduler::dequeueTimer(Timer* timer)
+{
+    // a pending or firing timer is released by updateTimerQueue
+    if (timer->_queueState == Timer::QueueState::Queued)
+        removeTimerAt(timer->_queueIndex);
+    timer->_queueState = Timer::QueueState::None;
+}
+
+void Scheduler::pauseQueuedTimers(TimerHandle& timerHandle)
+{
+    for (auto timer : timerHandle.timers)
+    {
+        switch (timer->_queueState)
+        {
+        case Timer::QueueState::Queued:
+            removeTimerAt(timer->_queueIndex);
+            [[fallthrough]];
+        case Timer::QueueState::Firing:
+            timer->_deadline -= _timerClock;  // keep the time left
+            timer->_queueState = Timer::QueueState::Paused;
+            break;
+        case Timer::QueueState::Pending:
+            timer->_queueState = Timer::QueueState::Paused;
+            break;
+        default:
+            break;
+        }
+    }
+}
+
+void Scheduler::resumeQueuedTimers(TimerHandle& timerHandle)
+{
+    for (auto timer : timerHandle.timers)
+    {
+        if (timer->_queueState != Timer::QueueState::Paused)
+            continue;
+
+        if (timer->_queueStarted)
+        {
+            timer->_deadline += _timerClock;
+            pushTimer(timer);
+        }
+        else
+        {
+            queueTimer(timer, false);
+        }
+    }
+}
+
+void Scheduler::updateTimerQueue()
+{
+    // take all the due timers first, the ones triggering every frame are pushed back with a deadline of now
+    while (!_timerQueue.empty() && _timerQueue.front()->_deadline <= _timerClock)
+    {
+        auto timer = _timerQueue.front();
+        removeTimerAt(0);
+        timer->_queueState = Timer::QueueState::Firing;
+        timer->retain();
+        _dueTimers.emplace_back(timer);
+    }
+
+    for (auto timer : _dueTimers)
+    {
+        // the callback of a previous timer may have unscheduled or paused it
+        if (timer->_queueState == Timer::QueueState::Firing)
+        {
+            timer->fire(_timerClock);
+            if (timer->_queueState == Timer::QueueState::Firing)
+                pushTimer(timer);
+        }
+        timer->release();
+    }
+    _dueTimers.clear();
+
+    for (auto timer : _timersToStart)
+    {
+        if (timer->_queueState == Timer::QueueState::Pending)
+        {
+            timer->_queueStarted = true;
+            timer->_deadline =
+                _timerClock + (timer->_useDelay ? timer->_delay : std::max(timer->_interval, 0.0f));
+            pushTimer(timer);
+        }
+        timer->release();
+    }
+    _timersToStart.clear();
+}
+
+void Scheduler::pushTimer(Timer* timer)
+{
+    timer->_queueState = Timer::QueueState::Queued;
+    _timerQueue.emplace_back(timer);
+    siftTimerUp(static_cast<int>(_timerQueue.size()) - 1);
+}
+
+void Scheduler::removeTimerAt(int index)
+{
+    auto timer         = _timerQueue[index];
+    auto last          = _timerQueue.back();
+    timer->_queueIndex = -1;
+    _timerQueue.pop_back();
+    if (last != timer)
+    {
+        _timerQueue[index] = last;
+        siftTimerUp(index);
+        siftTimerDown(last->_queueIndex);
+    }
+}
+
+void Scheduler::siftTimerUp(int index)
+{
+    auto timer = _timerQueue[index];
+    while (index > 0)
+    {
+        int parent = (index - 1) / 2;
+        if (_timerQueue[parent]->_deadline <= timer->_deadline)
+            break;
+        _timerQueue[index]              = _timerQueue[parent];
+        _timerQueue[index]->_queueIndex = index;
+        index                           = parent;
+    }
+    _timerQueue[index] = timer;
+    timer->_queueIndex = index;
+}
+
+void Scheduler::siftTimerDown(int index)
+{
+    auto timer = _timerQueue[index];
+    int count  = static_cast<int>(_timerQueue.size());
+    while (true)
+    {
+        int child = index * 2 + 1;
+        if (child >= count)
+            break;
+        if (child + 1 < count && _timerQueue[child + 1]->_deadline < _timerQueue[child]->_deadline)
+            ++child;
+        if (timer->_deadline <= _timerQueue[child]->_deadline)
+            break;
+        _timerQueue[index]              = _timerQueue[child];
+        _timerQueue[index]->_queueIndex = index;
+        index                           = child;
+    }
+    _timerQueue[index] = timer;
+    timer->_queueIndex = index;
 }
 
 void Scheduler::schedule(const ccSchedulerFunc& callback,
@@ -266,7 +544,8 @@ void Scheduler::schedule(const ccSchedulerFunc& callback,
         AXASSERT(timerIt->second.paused == paused, "element's paused should be paused!");
     }
 
-    auto& timers = timerIt->second.timers;
+    auto& timerHandle = timerIt->second;
+    auto& timers      = timerHandle.timers;
     if (timers.empty())
     {
         timers.reserve(10);
@@ -282,6 +561,8 @@ void Scheduler::schedule(const ccSchedulerFunc& callback,
             AXLOGD("Scheduler#schedule. Reiniting timer with interval {:.4f}, repeat {}, delay {:.4f}", interval, repeat,
                   delay);
             (*timerIt)->setupTimerWithInterval(interval, repeat, delay);
+            if (_timerQueueEnabled)
+                queueTimer(*timerIt, timerHandle.paused);
             return;
         }
     }
@@ -289,6 +570,8 @@ void Scheduler::schedule(const ccSchedulerFunc& callback,
     TimerTargetCallback* timer = new TimerTargetCallback();
     timer->initWithCallback(this, callback, target, key, interval, repeat, delay);
     timers.pushBack(timer);
+    if (_timerQueueEnabled)
+        queueTimer(timer, timerHandle.paused);
     timer->release();
 }
 
@@ -316,6 +599,9 @@ void Scheduler::unschedule(std::string_view key, void* target)
                     timer->setAborted();
                 }
 
+                if (_timerQueueEnabled)
+                    dequeueTimer(timer);
+
                 timerHandle.timers.erase(i);
 
                 // update timerIndex in case we are in tick:, looping over the actions
@@ -561,6 +847,11 @@ void Scheduler::unscheduleAllForTarget(std::unordered_map<void*, TimerHandle>::i
         timerHandle.currentTimer->retain();
         timerHandle.currentTimer->setAborted();
     }
+    if (_timerQueueEnabled)
+    {
+        for (auto timer : timerHandle.timers)
+            dequeueTimer(timer);
+    }
     timerHandle.timers.clear();
 
     if (_currentTarget == &timerHandle)
@@ -608,6 +899,8 @@ void Scheduler::resumeTarget(void* target)
     if (timerIt != _timersMap.end())
     {
         timerIt->second.paused = false;
+        if (_timerQueueEnabled)
+            resumeQueuedTimers(timerIt->second);
     }
 
     // update selector
@@ -627,6 +920,8 @@ void Scheduler::pauseTarget(void* target)
     if (timerIt != _timersMap.end())
     {
         timerIt->second.paused = true;
+        if (_timerQueueEnabled)
+            pauseQueuedTimers(timerIt->second);
     }
 
     // update selector
@@ -671,6 +966,8 @@ std::set<void*> Scheduler::pauseAllTargetsWithMinPriority(int minPriority)
     for (auto& [target, timerHandle] : _timersMap)
     {
         timerHandle.paused = true;
+        if (_timerQueueEnabled)
+            pauseQueuedTimers(timerHandle);
         idsWithSelectors.insert(target);
     }
 
@@ -731,6 +1028,8 @@ void Scheduler::removeAllPendingActions()
 // main loop
 void Scheduler::update(float dt)
 {
+    AX_TRACE_SCOPE("Scheduler::update");
+
     // active waitlist
     if (!_waitList.empty())
         activeWaitList();
@@ -742,6 +1041,8 @@ void Scheduler::update(float dt)
         dt *= _timeScale;
     }
 
+    _timerClock += dt;
+
     //
     // Selector callbacks
     //
@@ -774,42 +1075,49 @@ void Scheduler::update(float dt)
         }
     }
 
-    // Iterate over all the custom selectors
-    for (auto it = _timersMap.begin(); it != _timersMap.end();)
+    // Iterate over the due timers or all the custom selectors
+    if (_timerQueueEnabled)
     {
-        auto elt               = &it->second;
-        _currentTarget         = elt;
-        _currentTargetSalvaged = false;
-
-        if (!_currentTarget->paused)
+        updateTimerQueue();
+    }
+    else
+    {
+        for (auto it = _timersMap.begin(); it != _timersMap.end();)
         {
-            // The 'timers' array may change while inside this loop
-            for (elt->timerIndex = 0; elt->timerIndex < elt->timers.size(); ++(elt->timerIndex))
+            auto elt               = &it->second;
+            _currentTarget         = elt;
+            _currentTargetSalvaged = false;
+
+            if (!_currentTarget->paused)
             {
-                elt->currentTimer = elt->timers[elt->timerIndex];
-                AXASSERT(!elt->currentTimer->isAborted(), "An aborted timer should not be updated");
+                // The 'timers' array may change while inside this loop
+                for (elt->timerIndex = 0; elt->timerIndex < elt->timers.size(); ++(elt->timerIndex))
+                {
+                    elt->currentTimer = elt->timers[elt->timerIndex];
+                    AXASSERT(!elt->currentTimer->isAborted(), "An aborted timer should not be updated");
 
-                elt->currentTimer->update(dt);
+                    elt->currentTimer->update(dt);
 
-                if (elt->currentTimer->isAborted())
-                {
-                    // The currentTimer told the remove itself. To prevent the timer from
-                    // accidentally deallocating itself before finishing its step, we retained
-                    // it. Now that step is done, it's safe to release it.
-                    elt->currentTimer->release();
-                }
+                    if (elt->currentTimer->isAborted())
+                    {
+                        // The currentTimer told the remove itself. To prevent the timer from
+                        // accidentally deallocating itself before finishing its step, we retained
+                        // it. Now that step is done, it's safe to release it.
+                        elt->currentTimer->release();
+                    }
 
-                elt->currentTimer = nullptr;
+                    elt->currentTimer = nullptr;
+                }
             }
-        }
 
-        // only delete currentTarget if no actions were scheduled during the cycle (issue #481)
-        if (_currentTargetSalvaged && _currentTarget->timers.empty())
-        {
-            it = _timersMap.erase(it);
+            // only delete currentTarget if no actions were scheduled during the cycle (issue #481)
+            if (_currentTargetSalvaged && _currentTarget->timers.empty())
+            {
+                it = _timersMap.erase(it);
+            }
+            else
+                ++it;
         }
-        else
-            ++it;
     }
 
     // delete all updates that are removed in update
@@ -890,7 +1198,8 @@ void Scheduler::schedule(SEL_SCHEDULE selector,
         AXASSERT(timerIt->second.paused == paused, "element's paused should be paused.");
     }
 
-    auto&& timers = timerIt->second.timers;
+    auto& timerHandle = timerIt->second;
+    auto&& timers     = timerHandle.timers;
     if (timers.empty())
     {
         timers.reserve(10);
@@ -906,6 +1215,8 @@ void Scheduler::schedule(SEL_SCHEDULE selector,
             AXLOGD("Scheduler#schedule. Reiniting timer with interval {:.4}, repeat {}, delay {:.4f}", interval, repeat,
                   delay);
             (*timerIt)->setupTimerWithInterval(interval, repeat, delay);
+            if (_timerQueueEnabled)
+                queueTimer(*timerIt, timerHandle.paused);
             return;
         }
     }
@@ -913,6 +1224,8 @@ void Scheduler::schedule(SEL_SCHEDULE selector,
     TimerTargetSelector* timer = new TimerTargetSelector();
     timer->initWithSelector(this, selector, target, interval, repeat, delay);
     timers.pushBack(timer);
+    if (_timerQueueEnabled)
+        queueTimer(timer, timerHandle.paused);
     timer->release();
 }
 
@@ -967,6 +1280,9 @@ void Scheduler::unschedule(SEL_SCHEDULE selector, Object* target)
                     timer->setAborted();
                 }
 
+                if (_timerQueueEnabled)
+                    dequeueTimer(timer);
+
                 timers.erase(i);
 
                 // update timerIndex in case we are in tick:, looping over the actions
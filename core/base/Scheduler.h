@@ -47,6 +47,8 @@ typedef std::function<void(float)> ccSchedulerFunc;
  */
 class AX_DLL Timer : public Object
 {
+    friend class Scheduler;
+
 protected:
     Timer();
 
@@ -62,7 +64,19 @@ public:
     /** triggers the timer */
     void update(float dt);
 
+    /** triggers the timer waiting in the timer queue, now is the clock of the queue */
+    void fire(double now);
+
 protected:
+    enum class QueueState : uint8_t
+    {
+        None,     // not in the timer queue
+        Pending,  // starts at the end of the next update
+        Queued,   // waits in the heap for its deadline
+        Paused,   // the target is paused, _deadline is the time left if started
+        Firing,
+    };
+
     Scheduler* _scheduler;  // weak ref
     float _elapsed;
     bool _runForever;
@@ -72,6 +86,12 @@ protected:
     float _delay;
     float _interval;
     bool _aborted;
+
+    // timer queue state, see Scheduler::setTimerQueueEnabled
+    double _deadline;
+    int _queueIndex;
+    QueueState _queueState;
+    bool _queueStarted;
 };
 
 class AX_DLL TimerTargetSelector : public Timer
@@ -244,6 +264,17 @@ public:
      */
     void update(float dt);
 
+    /** Enables or disables the timer queue, disabled by default.
+     When enabled, the timers of the custom selectors wait in a min-heap ordered by deadline, so update() only touches
+     the timers that are due instead of updating every timer each frame. The timers keep their time left while their
+     target is paused. Script timers are always updated each frame.
+     @param enabled Whether the custom selectors use the timer queue.
+     */
+    void setTimerQueueEnabled(bool enabled);
+
+    /** Whether the custom selectors use the timer queue. */
+    bool isTimerQueueEnabled() const { return _timerQueueEnabled; }
+
     /////////////////////////////////////
 
     // schedule
@@ -511,6 +542,18 @@ protected:
 
     void unscheduleAllForTarget(std::unordered_map<void*, TimerHandle>::iterator& timerIt);
 
+    // timer queue specific
+
+    void queueTimer(Timer* timer, bool paused);
+    void dequeueTimer(Timer* timer);
+    void pauseQueuedTimers(TimerHandle& timerHandle);
+    void resumeQueuedTimers(TimerHandle& timerHandle);
+    void updateTimerQueue();
+    void pushTimer(Timer* timer);
+    void removeTimerAt(int index);
+    void siftTimerUp(int index);
+    void siftTimerDown(int index);
+
     float _timeScale;
 
     axstd::pod_vector<SchedHandle*> _waitList; // list wait active
@@ -534,6 +577,13 @@ protected:
     // If true unschedule will not remove anything from a hash. Elements will only be marked for deletion.
     bool _indexMapLocked;
 
+    // Used for the timer queue of "selectors with interval"
+    bool _timerQueueEnabled = false;
+    double _timerClock      = 0.0;
+    std::vector<Timer*> _timerQueue;     // min-heap by deadline, weak ref
+    std::vector<Timer*> _timersToStart;  // pending timers, retained
+    std::vector<Timer*> _dueTimers;      // timers firing in the current update, retained
+
 #if AX_ENABLE_SCRIPT_BINDING
     Vector<SchedulerScriptHandlerEntry*> _scriptHandlerEntries;
 #endif
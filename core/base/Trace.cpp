@@ -0,0 +1,253 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+
+#include "base/Trace.h"
+
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "base/format.h"
+#include "platform/FileUtils.h"
+
+NS_AX_BEGIN
+
+namespace
+{
+struct TraceEvent
+{
+    const char* name;
+    uint64_t begin;
+    uint64_t duration;
+};
+
+// Written by its thread only, the head is published with release semantics so the exporter can read
+// the events behind it.
+struct ThreadTrace
+{
+    uint32_t tid;
+    std::string name;
+    bool exited = false;  // guarded by the registry mutex
+    std::atomic<uint64_t> head{0};
+    TraceEvent events[TraceRecorder::EVENTS_PER_THREAD];
+};
+
+struct TraceRegistry
+{
+    std::mutex mutex;
+    // the traces of the threads which exited are kept until they're exported, then reused by new threads
+    std::vector<std::unique_ptr<ThreadTrace>> threads;
+    std::vector<std::unique_ptr<ThreadTrace>> freeTraces;
+    uint32_t lastTid = 0;
+
+    // the mutex must be held
+    void release(std::vector<std::unique_ptr<ThreadTrace>>::iterator it)
+    {
+        freeTraces.emplace_back(std::move(*it));
+        threads.erase(it);
+    }
+
+    void releaseExited()
+    {
+        for (auto i = threads.size(); i-- > 0;)
+        {
+            if (threads[i]->exited)
+                release(threads.begin() + i);
+        }
+    }
+};
+
+TraceRegistry& getRegistry()
+{
+    static TraceRegistry registry;
+    return registry;
+}
+
+thread_local ThreadTrace* t_threadTrace = nullptr;
+// name given before the thread recorded anything
+thread_local std::string t_threadName;
+// set when the thread exits, it doesn't record anymore
+thread_local bool t_threadExited = false;
+
+// Hands the trace of the thread back to the registry when the thread exits.
+struct ThreadTraceOwner
+{
+    ThreadTrace* trace = nullptr;
+
+    ~ThreadTraceOwner()
+    {
+        t_threadExited = true;
+        if (!trace)
+            return;
+        t_threadTrace = nullptr;
+
+        auto& registry = getRegistry();
+        std::lock_guard<std::mutex> lock(registry.mutex);
+        trace->exited = true;
+        // nothing to export
+        if (trace->head.load(std::memory_order_relaxed) == 0)
+        {
+            registry.release(std::find_if(registry.threads.begin(), registry.threads.end(),
+                                          [this](const auto& t) { return t.get() == trace; }));
+        }
+    }
+};
+
+thread_local ThreadTraceOwner t_threadTraceOwner;
+
+ThreadTrace* getThreadTrace()
+{
+    if (!t_threadTrace && !t_threadExited)
+    {
+        auto& registry = getRegistry();
+        std::lock_guard<std::mutex> lock(registry.mutex);
+        std::unique_ptr<ThreadTrace> trace;
+        if (!registry.freeTraces.empty())
+        {
+            trace = std::move(registry.freeTraces.back());
+            registry.freeTraces.pop_back();
+            trace->exited = false;
+            trace->head.store(0, std::memory_order_relaxed);
+        }
+        else
+        {
+            trace = std::make_unique<ThreadTrace>();
+        }
+        trace->tid  = ++registry.lastTid;
+        trace->name = t_threadName.empty() ? fmt::format("thread {}", trace->tid) : std::move(t_threadName);
+        t_threadTrace = t_threadTraceOwner.trace = trace.get();
+        registry.threads.emplace_back(std::move(trace));
+    }
+    return t_threadTrace;
+}
+
+void appendEscaped(std::string& out, std::string_view str)
+{
+    for (auto c : str)
+    {
+        if (c == '"' || c == '\\')
+            out += '\\';
+        out += c;
+    }
+}
+}  // namespace
+
+static_assert((TraceRecorder::EVENTS_PER_THREAD & (TraceRecorder::EVENTS_PER_THREAD - 1)) == 0,
+              "EVENTS_PER_THREAD must be a power of two");
+
+std::atomic<bool> TraceRecorder::s_enabled{false};
+
+uint64_t TraceRecorder::now()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+
+void TraceRecorder::record(const char* name, uint64_t begin, uint64_t end)
+{
+    auto trace = getThreadTrace();
+    if (!trace)
+        return;
+    auto head   = trace->head.load(std::memory_order_relaxed);
+    auto& event = trace->events[head & (EVENTS_PER_THREAD - 1)];
+    event.name     = name;
+    event.begin    = begin;
+    event.duration = end - begin;
+    trace->head.store(head + 1, std::memory_order_release);
+}
+
+void TraceRecorder::setThreadName(std::string_view name)
+{
+    // don't allocate the ring buffer of threads which never record
+    if (!t_threadTrace)
+    {
+        t_threadName = name;
+        return;
+    }
+    std::lock_guard<std::mutex> lock(getRegistry().mutex);
+    t_threadTrace->name = name;
+}
+
+void TraceRecorder::clear()
+{
+    auto& registry = getRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    for (auto& trace : registry.threads)
+        trace->head.store(0, std::memory_order_relaxed);
+    registry.releaseExited();
+}
+
+std::string TraceRecorder::exportChromeTrace()
+{
+    auto& registry = getRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+
+    std::string out = R"({"displayTimeUnit":"ms","traceEvents":[)";
+    bool first      = true;
+    std::vector<TraceEvent> events;
+    for (auto& trace : registry.threads)
+    {
+        // copy the ring, then drop the events the thread may have overwritten meanwhile
+        auto head  = trace->head.load(std::memory_order_acquire);
+        auto begin = head > EVENTS_PER_THREAD ? head - EVENTS_PER_THREAD : 0;
+        events.clear();
+        for (auto i = begin; i < head; ++i)
+            events.emplace_back(trace->events[i & (EVENTS_PER_THREAD - 1)]);
+        auto newHead = trace->head.load(std::memory_order_acquire);
+        auto skip    = newHead >= EVENTS_PER_THREAD ? (std::min)(newHead - EVENTS_PER_THREAD + 1, head) : begin;
+        if (skip < begin)
+            skip = begin;
+
+        if (!first)
+            out += ',';
+        first = false;
+        out += fmt::format(R"({{"name":"thread_name","ph":"M","pid":1,"tid":{},"args":{{"name":")", trace->tid);
+        appendEscaped(out, trace->name);
+        out += "\"}}";
+
+        for (auto i = skip - begin; i < events.size(); ++i)
+        {
+            auto& event = events[i];
+            out += R"(,{"name":")";
+            appendEscaped(out, event.name);
+            fmt::format_to(std::back_inserter(out), R"(","ph":"X","pid":1,"tid":{},"ts":{:.3f},"dur":{:.3f}}})",
+                           trace->tid, event.begin / 1000.0, event.duration / 1000.0);
+        }
+    }
+    out += "]}";
+
+    registry.releaseExited();
+    return out;
+}
+
+bool TraceRecorder::saveChromeTrace(std::string_view path)
+{
+    return FileUtils::getInstance()->writeStringToFile(exportChromeTrace(), path);
+}
+
+NS_AX_END
@@ -0,0 +1,121 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+
+#pragma once
+
+#include <stdint.h>
+#include <atomic>
+#include <string>
+#include <string_view>
+
+#include "base/Config.h"
+#include "platform/PlatformMacros.h"
+
+NS_AX_BEGIN
+
+/**
+ * @addtogroup base
+ * @{
+ */
+
+/**
+ A low overhead trace recorder, scopes instrumented with `AX_TRACE_SCOPE` are recorded while tracing is
+ started and can be exported to the Chrome trace event format (chrome://tracing, https://ui.perfetto.dev).
+
+ Each thread records into its own ring buffer without locking, so only the latest `EVENTS_PER_THREAD`
+ events of each thread are kept. The ring buffer of a thread which exited is kept until the next export,
+ then reused by a new thread. Scope names must be string literals, only their pointers are stored.
+ When tracing is stopped a scope costs one relaxed atomic load.
+ */
+class AX_DLL TraceRecorder
+{
+public:
+    /** The number of events kept per thread, a power of two. */
+    static const uint32_t EVENTS_PER_THREAD = 16384;
+
+    /** Start recording, the recorded events are kept. */
+    static void start() { s_enabled.store(true, std::memory_order_relaxed); }
+    /** Stop recording. */
+    static void stop() { s_enabled.store(false, std::memory_order_relaxed); }
+    /** Whether scopes are recorded. */
+    static bool isEnabled() { return s_enabled.load(std::memory_order_relaxed); }
+
+    /** Get the current time of the trace clock, in nanoseconds. */
+    static uint64_t now();
+
+    /** Record a scope of the calling thread, name must be a string literal. */
+    static void record(const char* name, uint64_t begin, uint64_t end);
+
+    /** Name the calling thread in exported traces, it doesn't allocate the thread ring buffer. */
+    static void setThreadName(std::string_view name);
+
+    /** Discard the recorded events. Don't call it while other threads are recording. */
+    static void clear();
+
+    /** Export the recorded events in the Chrome trace event JSON format, the events of the threads which exited
+     * are discarded. */
+    static std::string exportChromeTrace();
+    /** Export the recorded events to a file in the Chrome trace event JSON format. */
+    static bool saveChromeTrace(std::string_view path);
+
+private:
+    static std::atomic<bool> s_enabled;
+};
+
+/** Records the lifetime of the scope, see `AX_TRACE_SCOPE`. */
+class TraceScope
+{
+public:
+    explicit TraceScope(const char* name)
+        : _name(TraceRecorder::isEnabled() ? name : nullptr), _begin(_name ? TraceRecorder::now() : 0)
+    {}
+    ~TraceScope()
+    {
+        if (_name)
+            TraceRecorder::record(_name, _begin, TraceRecorder::now());
+    }
+
+    TraceScope(const TraceScope&)            = delete;
+    TraceScope& operator=(const TraceScope&) = delete;
+
+private:
+    const char* _name;
+    uint64_t _begin;
+};
+
+// end of base group
+/** @} */
+
+NS_AX_END
+
+#define AX_TRACE_CONCAT_(a, b) a##b
+#define AX_TRACE_CONCAT(a, b)  AX_TRACE_CONCAT_(a, b)
+
+/** Trace the enclosing scope, name must be a string literal. */
+#if AX_ENABLE_TRACE
+#    define AX_TRACE_SCOPE(name) ax::TraceScope AX_TRACE_CONCAT(__axTraceScope, __LINE__)("" name)
+#else
+#    define AX_TRACE_SCOPE(name) (void)0
+#endif
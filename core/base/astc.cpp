@@ -96,9 +96,10 @@ public:
 
         auto jobSystem = ax::Director::getInstance()->getJobSystem();
 
-        const int PARALLELS = std::clamp(std::thread::hardware_concurrency(), 2u, ASTCDEC_MAX_PARALLELS);
-        for (int i = 0; i < PARALLELS; ++i)
-            jobSystem->enqueue([task] { execute(task); });
+        // every participant decodes blocks until none left, the calling thread included
+        const size_t PARALLELS =
+            std::clamp(static_cast<unsigned int>(jobSystem->getWorkerCount()) + 1, 1u, ASTCDEC_MAX_PARALLELS);
+        jobSystem->parallel_for(0, PARALLELS, 1, [&task](size_t, size_t) { execute(task); });
 
         task->wait_done();
 
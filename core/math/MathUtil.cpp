@@ -20,7 +20,9 @@ This file was modified to fit the cocos2d-x project
 */
 
 #include "math/MathUtil.h"
+#include "math/Mat4.h"
 #include "base/Macros.h"
+#include "base/Types.h"
 
 #if (AX_TARGET_PLATFORM == AX_PLATFORM_ANDROID)
 #    include <cpu-features.h>
@@ -298,4 +300,26 @@ void MathUtil::crossVec3(const float* v1, const float* v2, float* dst)
 #endif
 }
 
+void MathUtil::transformVertices(V3F_C4B_T2F* dst, const V3F_C4B_T2F* src, size_t count, const Mat4& transform)
+{
+#ifdef USE_SSE
+    transformVertices(dst, src, count, transform.col);
+#elif defined(USE_NEON64)
+    MathUtilNeon64::transformVertices(dst, src, count, transform.m);
+#else
+    MathUtilC::transformVertices(dst, src, count, transform.m);
+#endif
+}
+
+void MathUtil::transformIndices(uint16_t* dst, const uint16_t* src, size_t count, uint16_t offset)
+{
+#ifdef USE_SSE
+    transformIndices(dst, src, count, _mm_set1_epi16(static_cast<short>(offset)));
+#elif defined(USE_NEON64)
+    MathUtilNeon64::transformIndices(dst, src, count, offset);
+#else
+    MathUtilC::transformIndices(dst, src, count, offset);
+#endif
+}
+
 NS_AX_MATH_END
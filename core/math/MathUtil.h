@@ -25,8 +25,10 @@
 
 #ifdef AX_USE_SSE
 #    include <xmmintrin.h>
+#    include <emmintrin.h>
 #endif
 
+#include <stdint.h>
 #include "math/MathBase.h"
 
 /**
@@ -36,6 +38,9 @@
 
 NS_AX_MATH_BEGIN
 
+class Mat4;
+struct V3F_C4B_T2F;
+
 /**
  * Defines a math utility class.
  *
@@ -88,6 +93,27 @@ public:
      */
     static float lerp(float from, float to, float alpha);
 
+    /**
+     * Transforms the positions of a batch of vertices by the given matrix (w = 1),
+     * colors and texture coordinates are copied as is.
+     *
+     * @param dst the destination vertices, must not overlap with src.
+     * @param src the source vertices.
+     * @param count the number of vertices to transform.
+     * @param transform the transform matrix.
+     */
+    static void transformVertices(V3F_C4B_T2F* dst, const V3F_C4B_T2F* src, size_t count, const Mat4& transform);
+
+    /**
+     * Adds offset to a batch of indices.
+     *
+     * @param dst the destination indices.
+     * @param src the source indices.
+     * @param count the number of indices.
+     * @param offset the value to add to each index.
+     */
+    static void transformIndices(uint16_t* dst, const uint16_t* src, size_t count, uint16_t offset);
+
 private:
     // Indicates that if neon is enabled
     static bool isNeon32Enabled();
@@ -110,6 +136,10 @@ private:
     static void transposeMatrix(const __m128 m[4], __m128 dst[4]);
 
     static void transformVec4(const __m128 m[4], const __m128& v, __m128& dst);
+
+    static void transformVertices(V3F_C4B_T2F* dst, const V3F_C4B_T2F* src, size_t count, const __m128 m[4]);
+
+    static void transformIndices(uint16_t* dst, const uint16_t* src, size_t count, const __m128i& offset);
 #endif
     static void addMatrix(const float* m, float scalar, float* dst);
 
@@ -42,6 +42,10 @@ public:
     inline static void transformVec4(const float* m, const float* v, float* dst);
     
     inline static void crossVec3(const float* v1, const float* v2, float* dst);
+
+    inline static void transformVertices(V3F_C4B_T2F* dst, const V3F_C4B_T2F* src, size_t count, const float* m);
+
+    inline static void transformIndices(uint16_t* dst, const uint16_t* src, size_t count, uint16_t offset);
 };
 
 inline void MathUtilC::addMatrix(const float* m, float scalar, float* dst)
@@ -215,4 +219,25 @@ inline void MathUtilC::crossVec3(const float* v1, const float* v2, float* dst)
     dst[2] = z;
 }
 
+inline void MathUtilC::transformVertices(V3F_C4B_T2F* dst, const V3F_C4B_T2F* src, size_t count, const float* m)
+{
+    auto end = dst + count;
+    for (; dst < end; ++dst, ++src)
+    {
+        auto& v = src->vertices;
+        dst->vertices.x = v.x * m[0] + v.y * m[4] + v.z * m[8] + m[12];
+        dst->vertices.y = v.x * m[1] + v.y * m[5] + v.z * m[9] + m[13];
+        dst->vertices.z = v.x * m[2] + v.y * m[6] + v.z * m[10] + m[14];
+        dst->colors     = src->colors;
+        dst->texCoords  = src->texCoords;
+    }
+}
+
+inline void MathUtilC::transformIndices(uint16_t* dst, const uint16_t* src, size_t count, uint16_t offset)
+{
+    auto end = dst + count;
+    for (; dst < end; ++dst, ++src)
+        *dst = *src + offset;
+}
+
 NS_AX_MATH_END
@@ -42,6 +42,10 @@ public:
     inline static void transformVec4(const float* m, const float* v, float* dst);
     
     inline static void crossVec3(const float* v1, const float* v2, float* dst);
+
+    inline static void transformVertices(V3F_C4B_T2F* dst, const V3F_C4B_T2F* src, size_t count, const float* m);
+
+    inline static void transformIndices(uint16_t* dst, const uint16_t* src, size_t count, uint16_t offset);
 };
 
 inline void MathUtilNeon64::addMatrix(const float* m, float scalar, float* dst)
@@ -262,4 +266,58 @@ inline void MathUtilNeon64::crossVec3(const float* v1, const float* v2, float* d
     );
 }
 
+inline void MathUtilNeon64::transformVertices(V3F_C4B_T2F* dst, const V3F_C4B_T2F* src, size_t count, const float* m)
+{
+    asm volatile(
+        "ld1    {v0.4s, v1.4s, v2.4s, v3.4s}, [%3]   \n\t"   // M[m0-m7] M[m8-m15]
+        "cbz    %2, 2f                              \n\t"
+
+        "1:                                         \n\t"
+        "ld1    {v4.4s}, [%1]                       \n\t"   // V[x, y, z, colors]
+        "ldr    d5, [%1, 16]                        \n\t"   // V[u, v]
+        "add    %1, %1, 24                          \n\t"
+
+        "fmul   v6.4s, v0.4s, v4.s[0]               \n\t"   // DST->V = M[m0-m3] * V[x]
+        "fmla   v6.4s, v1.4s, v4.s[1]               \n\t"   // DST->V += M[m4-m7] * V[y]
+        "fmla   v6.4s, v2.4s, v4.s[2]               \n\t"   // DST->V += M[m8-m11] * V[z]
+        "fadd   v6.4s, v6.4s, v3.4s                 \n\t"   // DST->V += M[m12-m15]
+        "mov    v6.s[3], v4.s[3]                    \n\t"   // DST->V[colors] = V[colors]
+
+        "st1    {v6.4s}, [%0]                       \n\t"   // DST->V[x, y, z, colors]
+        "str    d5, [%0, 16]                        \n\t"   // DST->V[u, v]
+        "add    %0, %0, 24                          \n\t"
+
+        "subs   %2, %2, 1                           \n\t"
+        "b.ne   1b                                  \n\t"
+        "2:                                         \n\t"
+        : "+r"(dst), "+r"(src), "+r"(count)
+        : "r"(m)
+        : "v0", "v1", "v2", "v3", "v4", "v5", "v6", "cc", "memory"
+    );
+}
+
+inline void MathUtilNeon64::transformIndices(uint16_t* dst, const uint16_t* src, size_t count, uint16_t offset)
+{
+    uint32_t offset32 = offset;
+    asm volatile(
+        "dup    v0.8h, %w3                          \n\t"   // offset x 8
+        "1:                                         \n\t"
+        "cmp    %2, 8                               \n\t"
+        "b.lo   2f                                  \n\t"
+        "ld1    {v1.8h}, [%1], 16                   \n\t"   // I[0-7]
+        "add    v1.8h, v1.8h, v0.8h                 \n\t"   // DST->I = I + offset
+        "st1    {v1.8h}, [%0], 16                   \n\t"
+        "sub    %2, %2, 8                           \n\t"
+        "b      1b                                  \n\t"
+        "2:                                         \n\t"
+        : "+r"(dst), "+r"(src), "+r"(count)
+        : "r"(offset32)
+        : "v0", "v1", "cc", "memory"
+    );
+
+    // remaining indices
+    for (size_t i = 0; i < count; ++i)
+        dst[i] = src[i] + offset;
+}
+
 NS_AX_MATH_END
@@ -151,6 +151,43 @@ void MathUtil::transformVec4(const __m128 m[4], const __m128& v, __m128& dst)
                      );
 }
 
+void MathUtil::transformVertices(V3F_C4B_T2F* dst, const V3F_C4B_T2F* src, size_t count, const __m128 m[4])
+{
+    auto end = dst + count;
+    for (; dst < end; ++dst, ++src)
+    {
+        // x, y, z, colors
+        __m128 v = _mm_loadu_ps(&src->vertices.x);
+
+        __m128 r = _mm_add_ps(
+            _mm_add_ps(_mm_mul_ps(m[0], _mm_shuffle_ps(v, v, _MM_SHUFFLE(0, 0, 0, 0))),
+                       _mm_mul_ps(m[1], _mm_shuffle_ps(v, v, _MM_SHUFFLE(1, 1, 1, 1)))),
+            _mm_add_ps(_mm_mul_ps(m[2], _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 2, 2, 2))), m[3]));
+
+        // keep colors in the last lane: (r.x, r.y, r.z, v.w)
+        __m128 t = _mm_shuffle_ps(r, v, _MM_SHUFFLE(3, 3, 2, 2));
+        r        = _mm_shuffle_ps(r, t, _MM_SHUFFLE(2, 0, 1, 0));
+
+        _mm_storeu_ps(&dst->vertices.x, r);
+        dst->texCoords = src->texCoords;
+    }
+}
+
+void MathUtil::transformIndices(uint16_t* dst, const uint16_t* src, size_t count, const __m128i& offset)
+{
+    auto end = dst + (count & ~(size_t)7);
+    for (; dst < end; dst += 8, src += 8)
+    {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst), _mm_add_epi16(v, offset));
+    }
+
+    // remaining indices
+    const uint16_t off = static_cast<uint16_t>(_mm_cvtsi128_si32(offset));
+    for (size_t i = 0, n = count & 7; i < n; ++i)
+        dst[i] = src[i] + off;
+}
+
 #endif
 
 
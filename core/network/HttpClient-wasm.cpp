@@ -248,7 +248,11 @@ namespace network
         // get response
         response->setResponseCode(fetch->status);
         // response->setErrorBuffer(fetch->statusText);
-        response->getResponseData()->assign(reinterpret_cast<const char *>(fetch->data), reinterpret_cast<const char *>(fetch->data) + fetch->numBytes);
+        auto& dataCallback = request->getResponseDataCallback();
+        if (dataCallback) // the browser already decoded the body, it arrives in one piece
+            dataCallback(response, reinterpret_cast<const char *>(fetch->data), fetch->numBytes);
+        else
+            response->getResponseData()->assign(reinterpret_cast<const char *>(fetch->data), reinterpret_cast<const char *>(fetch->data) + fetch->numBytes);
         emscripten_fetch_close(fetch);
 
         // write cookie back
@@ -117,6 +117,9 @@ HttpClient::HttpClient()
     , _dispatchOnWorkThread(false)
     , _timeoutForConnect(30)
     , _timeoutForRead(60)
+    , _keepAliveEnabled(true)
+    , _keepAliveTimeout(30)
+    , _decompressionEnabled(true)
     , _cookie(nullptr)
     , _clearResponsePredicate(nullptr)
 {
@@ -181,6 +184,11 @@ void HttpClient::tickInput()
 void HttpClient::handleNetworkStatusChanged()
 {
     _service->set_option(YOPT_S_DNS_DIRTY, 1);
+    // connections made over the previous network are likely dead
+    _service->schedule(std::chrono::microseconds(0), [this](io_service&) {
+        closeAllIdleChannels();
+        return true;
+    });
 }
 
 void HttpClient::setNameServers(std::string_view servers)
@@ -198,10 +206,14 @@ void HttpClient::send(HttpRequest* request)
     if (!request)
         return;
 
-    auto response = new HttpResponse(request);
+    RefPtr<HttpResponse> response{ReferencedObject<HttpResponse>{new HttpResponse(request)}};
     response->setLocation(request->getUrl(), false);
-    processResponse(response, -1);
-    response->release();
+
+    // the idle channels and the channel states are only touched on the service thread
+    _service->schedule(std::chrono::microseconds(0), [this, response = std::move(response)](io_service&) {
+        processResponse(response.get(), -1);
+        return true;
+    });
 }
 
 int HttpClient::tryTakeAvailChannel()
@@ -216,6 +228,39 @@ int HttpClient::tryTakeAvailChannel()
     return -1;
 }
 
+int HttpClient::tryTakeIdleChannel(const Uri& uri)
+{
+    for (auto it = _idleChannels.rbegin(); it != _idleChannels.rend(); ++it)
+    {
+        int channelIndex = *it;
+        if (_channelStates[channelIndex].matches(uri) && _service->is_open(channelIndex))
+        {
+            _idleChannels.erase(std::next(it).base());
+            _service->channel_at(channelIndex)->get_user_timer().cancel();
+            return channelIndex;
+        }
+    }
+    return -1;
+}
+
+bool HttpClient::closeIdleChannel()
+{
+    if (_idleChannels.empty())
+        return false;
+
+    int channelIndex = _idleChannels.front();
+    _idleChannels.erase(_idleChannels.begin());
+
+    _service->close(channelIndex);
+    return true;
+}
+
+void HttpClient::closeAllIdleChannels()
+{
+    while (closeIdleChannel())
+        ;
+}
+
 void HttpClient::processResponse(HttpResponse* response, int channelIndex)
 {
     response->retain();
@@ -223,33 +268,69 @@ void HttpClient::processResponse(HttpResponse* response, int channelIndex)
     if (response->validateUri())
     {
         if (channelIndex == -1)
+        {
+            channelIndex = tryTakeIdleChannel(response->getRequestUri());
+            if (channelIndex != -1)
+            {
+                _service->channel_at(channelIndex)->ud_.ptr = response;
+                _channelStates[channelIndex].reused         = true;
+                sendRequest(response, channelIndex);
+                return;
+            }
             channelIndex = tryTakeAvailChannel();
+        }
 
         if (channelIndex != -1)
-        {
-            auto channelHandle = _service->channel_at(channelIndex);
-            auto& requestUri = response->getRequestUri();
-            channelHandle->ud_.ptr = response;
-            _service->set_option(YOPT_C_REMOTE_ENDPOINT, channelIndex, requestUri.getHost().data(),
-                                 (int)requestUri.getPort());
-            if (requestUri.isSecure())
-                _service->open(channelIndex, YCK_SSL_CLIENT);
-            else
-                _service->open(channelIndex, YCK_TCP_CLIENT);
-        }
+            openChannel(response, channelIndex);
         else
+        {
             _pendingResponseQueue.emplace_back(response);
+            // the channel of an idle connection to another host takes the pending response once closed
+            closeIdleChannel();
+        }
     }
     else
         finishResponse(response);
 }
 
+void HttpClient::openChannel(HttpResponse* response, int channelIndex)
+{
+    auto channelHandle = _service->channel_at(channelIndex);
+    auto& requestUri   = response->getRequestUri();
+    channelHandle->ud_.ptr = response;
+    _channelStates[channelIndex].reused = false;
+    _service->set_option(YOPT_C_REMOTE_ENDPOINT, channelIndex, requestUri.getHost().data(),
+                         (int)requestUri.getPort());
+    if (requestUri.isSecure())
+        _service->open(channelIndex, YCK_SSL_CLIENT);
+    else
+        _service->open(channelIndex, YCK_TCP_CLIENT);
+}
+
 void HttpClient::handleNetworkEvent(yasio::io_event* event)
 {
     int channelIndex       = event->cindex();
     auto channel           = _service->channel_at(event->cindex());
     HttpResponse* response = (HttpResponse*)channel->ud_.ptr;
-    assert(response);
+    auto& state            = _channelStates[channelIndex];
+
+    if (event->kind() == YEK_ON_CLOSE)
+    {
+        auto it = std::find(_idleChannels.begin(), _idleChannels.end(), channelIndex);
+        if (it != _idleChannels.end())
+            _idleChannels.erase(it);
+        state.transport = nullptr;
+    }
+
+    if (!response)
+    {
+        // an idle connection was closed, or the server sent data nobody asked for
+        if (event->kind() == YEK_ON_CLOSE)
+            recycleChannel(channelIndex, false);
+        else if (event->kind() == YEK_ON_PACKET)
+            _service->close(channelIndex);
+        return;
+    }
 
     bool responseFinished = response->isFinished();
     switch (event->kind())
@@ -263,135 +344,174 @@ void HttpClient::handleNetworkEvent(yasio::io_event* event)
         if (response->isFinished())
         {
             response->updateInternalCode(yasio::errc::eof);
-            _service->close(event->cindex());
+            auto responseCode = response->getResponseCode();
+            bool redirect     = responseCode == 301 || responseCode == 302 || responseCode == 307;
+            if (_keepAliveEnabled && response->isKeepAlive() && !redirect)
+                handleResponseComplete(response, channel);
+            else
+                _service->close(event->cindex());
         }
         break;
     case YEK_ON_OPEN:
         if (event->status() == 0)
         {
-            obstream obs;
-            bool usePostData = false;
-            auto request     = response->getHttpRequest();
-            switch (request->getRequestType())
-            {
-            case HttpRequest::Type::GET:
-                obs.write_bytes("GET");
-                break;
-            case HttpRequest::Type::PATCH:
-                obs.write_bytes("PATCH");
-                usePostData = true;
-                break;
-            case HttpRequest::Type::POST:
-                obs.write_bytes("POST");
-                usePostData = true;
-                break;
-            case HttpRequest::Type::DELETE:
-                obs.write_bytes("DELETE");
-                break;
-            case HttpRequest::Type::PUT:
-                obs.write_bytes("PUT");
-                usePostData = true;
-                break;
-            default:
-                obs.write_bytes("GET");
-                break;
-            }
-            obs.write_bytes(" ");
+            auto& uri       = response->getRequestUri();
+            state.transport = event->transport();
+            state.host      = uri.getHost();
+            state.port      = uri.getPort();
+            state.secure    = uri.isSecure();
+            sendRequest(response, channelIndex);
+        }
+        else
+        {
+            handleNetworkEOF(response, channel, event->status());
+        }
+        break;
+    case YEK_ON_CLOSE:
+        if (state.reused && response->getReceivedBytes() == 0 && response->getInternalCode() == 0 &&
+            response->getHttpRequest()->getRequestType() == HttpRequest::Type::GET)
+        {
+            // the server likely dropped the idle connection before it got the request, retry on a new connection.
+            // Only GET is sent twice, the other requests may have been processed without a response sent back.
+            channel->get_user_timer().cancel();
+            openChannel(response, channelIndex);
+            break;
+        }
+        handleNetworkEOF(response, channel, event->status());
+        break;
+    }
+}
 
-            auto& uri = response->getRequestUri();
-            obs.write_bytes(uri.getPathEtc());
+void HttpClient::sendRequest(HttpResponse* response, int channelIndex)
+{
+    auto channel = _service->channel_at(channelIndex);
 
-            obs.write_bytes(" HTTP/1.1\r\n");
+    obstream obs;
+    bool usePostData = false;
+    auto request     = response->getHttpRequest();
+    switch (request->getRequestType())
+    {
+    case HttpRequest::Type::GET:
+        obs.write_bytes("GET");
+        break;
+    case HttpRequest::Type::PATCH:
+        obs.write_bytes("PATCH");
+        usePostData = true;
+        break;
+    case HttpRequest::Type::POST:
+        obs.write_bytes("POST");
+        usePostData = true;
+        break;
+    case HttpRequest::Type::DELETE:
+        obs.write_bytes("DELETE");
+        break;
+    case HttpRequest::Type::PUT:
+        obs.write_bytes("PUT");
+        usePostData = true;
+        break;
+    default:
+        obs.write_bytes("GET");
+        break;
+    }
+    obs.write_bytes(" ");
+
+    auto& uri = response->getRequestUri();
+    obs.write_bytes(uri.getPathEtc());
+
+    obs.write_bytes(" HTTP/1.1\r\n");
 
-            obs.write_bytes("Host: ");
-            obs.write_bytes(uri.getHost());
+    obs.write_bytes("Host: ");
+    obs.write_bytes(uri.getHost());
+    obs.write_bytes("\r\n");
+
+    // process custom headers
+    struct HeaderFlag
+    {
+        enum
+        {
+            UESR_AGENT   = 1,
+            CONTENT_TYPE = 1 << 1,
+            ACCEPT       = 1 << 2,
+            CONNECTION   = 1 << 3,
+            ENCODING     = 1 << 4,
+        };
+    };
+    int headerFlags = 0;
+    auto& headers   = request->getHeaders();
+    if (!headers.empty())
+    {
+        using namespace cxx17;  // for string_view literal
+        for (auto&& header : headers)
+        {
+            obs.write_bytes(header);
             obs.write_bytes("\r\n");
 
-            // process custom headers
-            struct HeaderFlag
-            {
-                enum
-                {
-                    UESR_AGENT   = 1,
-                    CONTENT_TYPE = 1 << 1,
-                    ACCEPT       = 1 << 2,
-                };
-            };
-            int headerFlags = 0;
-            auto& headers   = request->getHeaders();
-            if (!headers.empty())
-            {
-                using namespace cxx17;  // for string_view literal
-                for (auto&& header : headers)
-                {
-                    obs.write_bytes(header);
-                    obs.write_bytes("\r\n");
-
-                    if (cxx20::ic::starts_with(cxx17::string_view{header}, "User-Agent:"_sv))
-                        headerFlags |= HeaderFlag::UESR_AGENT;
-                    else if (cxx20::ic::starts_with(cxx17::string_view{header}, "Content-Type:"_sv))
-                        headerFlags |= HeaderFlag::CONTENT_TYPE;
-                    else if (cxx20::ic::starts_with(cxx17::string_view{header}, "Accept:"_sv))
-                        headerFlags |= HeaderFlag::ACCEPT;
-                }
-            }
+            if (cxx20::ic::starts_with(cxx17::string_view{header}, "User-Agent:"_sv))
+                headerFlags |= HeaderFlag::UESR_AGENT;
+            else if (cxx20::ic::starts_with(cxx17::string_view{header}, "Content-Type:"_sv))
+                headerFlags |= HeaderFlag::CONTENT_TYPE;
+            else if (cxx20::ic::starts_with(cxx17::string_view{header}, "Accept:"_sv))
+                headerFlags |= HeaderFlag::ACCEPT;
+            else if (cxx20::ic::starts_with(cxx17::string_view{header}, "Connection:"_sv))
+                headerFlags |= HeaderFlag::CONNECTION;
+            else if (cxx20::ic::starts_with(cxx17::string_view{header}, "Accept-Encoding:"_sv))
+                headerFlags |= HeaderFlag::ENCODING;
+        }
+    }
 
-            if (_cookie)
-            {
-                auto cookies = _cookie->checkAndGetFormatedMatchCookies(uri);
-                if (!cookies.empty())
-                {
-                    obs.write_bytes("Cookie: ");
-                    obs.write_bytes(cookies);
-                }
-            }
+    if (_cookie)
+    {
+        auto cookies = _cookie->checkAndGetFormatedMatchCookies(uri);
+        if (!cookies.empty())
+        {
+            obs.write_bytes("Cookie: ");
+            obs.write_bytes(cookies);
+        }
+    }
 
-            if (!(headerFlags & HeaderFlag::UESR_AGENT))
-                obs.write_bytes("User-Agent: yasio-http\r\n");
+    if (!(headerFlags & HeaderFlag::UESR_AGENT))
+        obs.write_bytes("User-Agent: yasio-http\r\n");
 
-            if (!(headerFlags & HeaderFlag::ACCEPT))
-                obs.write_bytes("Accept: */*;q=0.8\r\n");
+    if (!(headerFlags & HeaderFlag::ACCEPT))
+        obs.write_bytes("Accept: */*;q=0.8\r\n");
 
-            if (usePostData)
-            {
-                if (!(headerFlags & HeaderFlag::CONTENT_TYPE))
-                    obs.write_bytes("Content-Type: application/x-www-form-urlencoded;charset=UTF-8\r\n");
-
-                char strContentLength[128] = {0};
-                auto requestData           = request->getRequestData();
-                auto requestDataSize       = request->getRequestDataSize();
-                snprintf(strContentLength, sizeof(strContentLength), "Content-Length: %d\r\n\r\n",
-                         static_cast<int>(requestDataSize));
-                obs.write_bytes(strContentLength);
-
-                if (requestData && requestDataSize > 0)
-                    obs.write_bytes(cxx17::string_view{requestData, static_cast<size_t>(requestDataSize)});
-            }
-            else
-            {
-                obs.write_bytes("\r\n");
-            }
+    if (!(headerFlags & HeaderFlag::CONNECTION))
+        obs.write_bytes(_keepAliveEnabled ? "Connection: keep-alive\r\n" : "Connection: close\r\n");
 
-            _service->write(event->transport(), std::move(obs.buffer()));
+    response->_decodeContent = _decompressionEnabled && !(headerFlags & HeaderFlag::ENCODING);
+    if (response->_decodeContent)
+        obs.write_bytes("Accept-Encoding: gzip, deflate\r\n");
 
-            auto& timerForRead = channel->get_user_timer();
-            timerForRead.cancel();
-            timerForRead.expires_from_now(std::chrono::seconds(this->_timeoutForRead));
-            timerForRead.async_wait([=](io_service& s) {
-                response->updateInternalCode(yasio::errc::read_timeout);
-                s.close(channelIndex);  // timeout
-                return true;
-            });
-        }
-        else
-        {
-            handleNetworkEOF(response, channel, event->status());
-        }
-        break;
-    case YEK_ON_CLOSE:
-        handleNetworkEOF(response, channel, event->status());
-        break;
+    if (usePostData)
+    {
+        if (!(headerFlags & HeaderFlag::CONTENT_TYPE))
+            obs.write_bytes("Content-Type: application/x-www-form-urlencoded;charset=UTF-8\r\n");
+
+        char strContentLength[128] = {0};
+        auto requestData           = request->getRequestData();
+        auto requestDataSize       = request->getRequestDataSize();
+        snprintf(strContentLength, sizeof(strContentLength), "Content-Length: %d\r\n\r\n",
+                 static_cast<int>(requestDataSize));
+        obs.write_bytes(strContentLength);
+
+        if (requestData && requestDataSize > 0)
+            obs.write_bytes(cxx17::string_view{requestData, static_cast<size_t>(requestDataSize)});
+    }
+    else
+    {
+        obs.write_bytes("\r\n");
     }
+
+    _service->write(_channelStates[channelIndex].transport, std::move(obs.buffer()));
+
+    auto& timerForRead = channel->get_user_timer();
+    timerForRead.cancel();
+    timerForRead.expires_from_now(std::chrono::seconds(this->_timeoutForRead));
+    timerForRead.async_wait([=](io_service& s) {
+        response->updateInternalCode(yasio::errc::read_timeout);
+        s.close(channelIndex);  // timeout
+        return true;
+    });
 }
 
 void HttpClient::handleNetworkEOF(HttpResponse* response, yasio::io_channel* channel, int internalErrorCode)
@@ -414,22 +534,81 @@ void HttpClient::handleNetworkEOF(HttpResponse* response, yasio::io_channel* cha
         }
     default:
         finishResponse(response);
+        recycleChannel(channel->index(), false);
+    }
+}
 
-        // try process pending response
-        auto lck = _pendingResponseQueue.get_lock();
-        if (!_pendingResponseQueue.unsafe_empty())
+void HttpClient::handleResponseComplete(HttpResponse* response, yasio::io_channel* channel)
+{
+    // the connection stays open, hand it to the next request
+    channel->ud_.ptr = nullptr;
+    channel->get_user_timer().cancel();
+    finishResponse(response);
+    recycleChannel(channel->index(), true);
+}
+
+void HttpClient::recycleChannel(int channelIndex, bool connected)
+{
+    auto lck = _pendingResponseQueue.get_lock();
+    if (connected)
+    {
+        // prefer a pending request to the same endpoint, it can be sent right away
+        auto& state = _channelStates[channelIndex];
+        for (auto it = _pendingResponseQueue.unsafe_begin(); it != _pendingResponseQueue.unsafe_end(); ++it)
         {
-            auto pendingResponse = _pendingResponseQueue.unsafe_front();
-            _pendingResponseQueue.unsafe_pop_front();
-            lck.unlock();
+            auto pendingResponse = *it;
+            if (state.matches(pendingResponse->getRequestUri()))
+            {
+                _pendingResponseQueue.unsafe_erase(it);
+                lck.unlock();
 
-            processResponse(pendingResponse, channel->index());
-            pendingResponse->release();
+                _service->channel_at(channelIndex)->ud_.ptr = pendingResponse;
+                state.reused                                = true;
+                sendRequest(pendingResponse, channelIndex);
+                return;
+            }
         }
-        else
-        {  // recycle channel
-            _availChannelQueue.push_front(channel->index());
+
+        if (!_pendingResponseQueue.unsafe_empty())
+        {
+            // pending requests go elsewhere, the channel is recycled once closed
+            lck.unlock();
+            _service->close(channelIndex);
+            return;
         }
+        lck.unlock();
+
+        // keep the connection until it is reused or times out
+        _idleChannels.push_back(channelIndex);
+
+        auto& timerForIdle = _service->channel_at(channelIndex)->get_user_timer();
+        timerForIdle.cancel();
+        timerForIdle.expires_from_now(std::chrono::seconds(this->_keepAliveTimeout));
+        timerForIdle.async_wait([this, channelIndex](io_service& s) {
+            auto it = std::find(_idleChannels.begin(), _idleChannels.end(), channelIndex);
+            if (it != _idleChannels.end())
+            {
+                _idleChannels.erase(it);
+                s.close(channelIndex);  // idle timeout
+            }
+            return true;
+        });
+        return;
+    }
+
+    // try process pending response
+    if (!_pendingResponseQueue.unsafe_empty())
+    {
+        auto pendingResponse = _pendingResponseQueue.unsafe_front();
+        _pendingResponseQueue.unsafe_pop_front();
+        lck.unlock();
+
+        processResponse(pendingResponse, channelIndex);
+        pendingResponse->release();
+    }
+    else
+    {  // recycle channel
+        _availChannelQueue.push_front(channelIndex);
     }
 }
 
@@ -512,6 +691,21 @@ int HttpClient::getTimeoutForRead()
     return _timeoutForRead;
 }
 
+void HttpClient::setKeepAliveEnabled(bool enabled)
+{
+    _keepAliveEnabled = enabled;
+    if (!enabled)
+        _service->schedule(std::chrono::microseconds(0), [this](io_service&) {
+            closeAllIdleChannels();
+            return true;
+        });
+}
+
+void HttpClient::setKeepAliveTimeout(int value)
+{
+    _keepAliveTimeout = value;
+}
+
 std::string_view HttpClient::getCookieFilename()
 {
     std::lock_guard<std::recursive_mutex> lock(_cookieFileMutex);
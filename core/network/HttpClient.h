@@ -32,6 +32,8 @@
 #include <thread>
 #include <condition_variable>
 #include <deque>
+#include <array>
+#include <vector>
 
 #include "base/Scheduler.h"
 #include "network/HttpRequest.h"
@@ -149,6 +151,47 @@ public:
      */
     int getTimeoutForRead();
 
+    /**
+     * Enable/disable keeping connections open after a response. Following requests to the same
+     * host and port reuse an idle connection and skip the TCP and TLS handshakes.
+     * A GET request is sent again on a new connection if the server closes the reused one without any response,
+     * the other requests fail then since the server may have run them already.
+     *
+     * @param enabled true to reuse connections (default), false to close the connection after each response.
+     */
+    void setKeepAliveEnabled(bool enabled);
+
+    /**
+     * Whether connections are kept open for following requests.
+     */
+    bool isKeepAliveEnabled() const { return _keepAliveEnabled; }
+
+    /**
+     * Set how long an idle connection is kept open before it is closed.
+     *
+     * @param value the idle timeout in seconds, default 30.
+     */
+    void setKeepAliveTimeout(int value);
+
+    /**
+     * Get how long an idle connection is kept open, in seconds.
+     */
+    int getKeepAliveTimeout() const { return _keepAliveTimeout; }
+
+    /**
+     * Enable/disable asking servers for gzip or deflate compressed responses. Compressed bodies are
+     * inflated while they arrive, before they reach HttpResponse::getResponseData or the data callback.
+     * Requests with their own Accept-Encoding header are sent and delivered as they are.
+     *
+     * @param enabled true to negotiate compression (default), false to always receive uncompressed bodies.
+     */
+    void setDecompressionEnabled(bool enabled) { _decompressionEnabled = enabled; }
+
+    /**
+     * Whether compressed responses are negotiated and decoded.
+     */
+    bool isDecompressionEnabled() const { return _decompressionEnabled; }
+
     HttpCookie* getCookie() const { return _cookie; }
 
     std::recursive_mutex& getCookieFileMutex() { return _cookieFileMutex; }
@@ -204,8 +247,22 @@ private:
 
     int tryTakeAvailChannel();
 
+    int tryTakeIdleChannel(const Uri& uri);
+
+    bool closeIdleChannel();
+
+    void closeAllIdleChannels();
+
+    void openChannel(HttpResponse* response, int channelIndex);
+
+    void sendRequest(HttpResponse* response, int channelIndex);
+
     void handleNetworkEvent(yasio::io_event* event);
 
+    void handleResponseComplete(HttpResponse* response, yasio::io_channel* channel);
+
+    void recycleChannel(int channelIndex, bool connected);
+
     void handleNetworkEOF(HttpResponse* response, yasio::io_channel* channel, int internalErrorCode);
 
     void tickInput();
@@ -234,6 +291,29 @@ private:
 
     ConcurrentDeque<int> _availChannelQueue;
 
+    // the endpoint a channel is connected to, for keep-alive
+    struct ChannelState
+    {
+        yasio::transport_handle_t transport = nullptr;
+        std::string host;
+        uint16_t port = 0;
+        bool secure   = false;
+        bool reused   = false;  // the current request was sent on a kept-alive connection
+
+        bool matches(const Uri& uri) const
+        {
+            return transport && port == uri.getPort() && secure == uri.isSecure() && host == uri.getHost();
+        }
+    };
+    // only accessed on the service thread
+    std::array<ChannelState, MAX_CHANNELS> _channelStates;
+    std::vector<int> _idleChannels;  // connected channels without a request, oldest first
+
+    bool _keepAliveEnabled;
+    int _keepAliveTimeout;
+
+    bool _decompressionEnabled;
+
     std::string _cookieFilename;
     std::recursive_mutex _cookieFileMutex;
 
@@ -51,6 +51,7 @@ class HttpClient;
 class HttpResponse;
 
 typedef std::function<void(HttpClient* client, HttpResponse* response)> ccHttpRequestCallback;
+typedef std::function<void(HttpResponse* response, const char* data, size_t size)> ccHttpRequestDataCallback;
 
 /**
  * Defines the object which users must packed for HttpClient::send(HttpRequest*) method.
@@ -213,6 +214,22 @@ public:
      */
     const ccHttpRequestCallback& getCallback() const { return _pCallback; }
 
+    /**
+     * Set a callback receiving the response body in chunks as they arrive, already decoded
+     * if the server compressed it. The body isn't kept in the HttpResponse then.
+     * The response callback is still invoked once the response is finished.
+     *
+     * @param callback the ccHttpRequestDataCallback function, invoked on the network thread.
+     */
+    void setResponseDataCallback(const ccHttpRequestDataCallback& callback) { _pDataCallback = callback; }
+
+    /**
+     * Get ccHttpRequestDataCallback callback function.
+     *
+     * @return const ccHttpRequestDataCallback& ccHttpRequestDataCallback callback function.
+     */
+    const ccHttpRequestDataCallback& getResponseDataCallback() const { return _pDataCallback; }
+
     /**
      * Set custom-defined headers.
      *
@@ -255,6 +272,7 @@ protected:
     yasio::sbyte_buffer _requestData;   /// used for POST
     std::string _tag;                   /// user defined tag, to identify different requests in response callback
     ccHttpRequestCallback _pCallback;   /// C++11 style callbacks
+    ccHttpRequestDataCallback _pDataCallback;  /// streams the response body
     void* _pUserData;                   /// You can add your customed data here
     std::vector<std::string> _headers;  /// custom http headers
     std::vector<std::string> _hosts;
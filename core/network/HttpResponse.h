@@ -33,6 +33,8 @@
 #include "network/HttpRequest.h"
 #include "network/Uri.h"
 #include "llhttp.h"
+#include "zlib.h"
+#include "yasio/string_view.hpp"
 
 /**
  * @addtogroup network
@@ -76,6 +78,7 @@ public:
      */
     virtual ~HttpResponse()
     {
+        resetInflater();
         if (_pHttpRequest)
         {
             _pHttpRequest->release();
@@ -129,7 +132,7 @@ public:
 
     const ResponseHeaderMap& getResponseHeaders() const { return _responseHeaders; }
 
-private:
+protected:
     void setResponseCode(int value) { _responseCode = value; }
 
     void updateInternalCode(int value)
@@ -143,8 +146,19 @@ private:
      */
     bool isFinished() const { return _finished; }
 
+    /**
+     * Whether the connection can be reused for another request once the response is finished.
+     */
+    bool isKeepAlive() const { return _keepAlive; }
+
+    /**
+     * The number of bytes received from the server for the current location.
+     */
+    size_t getReceivedBytes() const { return _receivedBytes; }
+
     void handleInput(const char* d, size_t n)
     {
+        _receivedBytes += n;
         enum llhttp_errno err = llhttp_execute(&_context, d, n);
         if (err != HPE_OK)
         {
@@ -191,7 +205,10 @@ private:
 
             /* Resets response status */
             _responseHeaders.clear();
-            _finished = false;
+            _finished      = false;
+            _keepAlive     = false;
+            _receivedBytes = 0;
+            resetInflater();
             _responseData.clear();
             _currentHeader.clear();
             _responseCode = -1;
@@ -213,6 +230,7 @@ private:
             _contextSettings.on_header_field_complete = on_header_field_complete;
             _contextSettings.on_header_value          = on_header_value;
             _contextSettings.on_header_value_complete = on_header_value_complete;
+            _contextSettings.on_headers_complete      = on_headers_complete;
             _contextSettings.on_body                  = on_body;
             _contextSettings.on_message_complete      = on_complete;
         }
@@ -249,20 +267,103 @@ private:
         thiz->_responseHeaders.emplace(std::move(thiz->_currentHeader), std::move(thiz->_currentHeaderValue));
         return 0;
     }
-    static int on_body(llhttp_t* context, const char* at, size_t length)
+    static int on_headers_complete(llhttp_t* context)
     {
         auto thiz = (HttpResponse*)context->data;
-        thiz->_responseData.insert(thiz->_responseData.end(), at, at + length);
+        if (thiz->_decodeContent)
+        {
+            auto iter = thiz->_responseHeaders.find("content-encoding");
+            if (iter != thiz->_responseHeaders.end() &&
+                (cxx20::ic::iequals(iter->second, "gzip") || cxx20::ic::iequals(iter->second, "deflate")))
+            {
+                thiz->_inflater = new z_stream{};
+                // +32: detect the zlib or gzip header
+                if (inflateInit2(thiz->_inflater, 15 + 32) != Z_OK)
+                {
+                    delete thiz->_inflater;
+                    thiz->_inflater = nullptr;
+                    return -1;
+                }
+            }
+        }
         return 0;
     }
+    static int on_body(llhttp_t* context, const char* at, size_t length)
+    {
+        auto thiz = (HttpResponse*)context->data;
+        return thiz->_inflater ? thiz->inflateBody(at, length) : thiz->deliverBody(at, length);
+    }
     static int on_complete(llhttp_t* context)
     {
         auto thiz           = (HttpResponse*)context->data;
         thiz->_responseCode = context->status_code;
         thiz->_finished     = true;
+        thiz->_keepAlive    = llhttp_should_keep_alive(context) != 0;
         return 0;
     }
 
+    int inflateBody(const char* at, size_t length)
+    {
+        char buffer[16384];
+        // keep the input until the header is known to be right, it may be split across several calls
+        if (!_rawInflate && _inflater->total_out == 0)
+            _inflateHead.insert(_inflateHead.end(), at, at + length);
+        else
+            _inflateHead.clear();
+
+        _inflater->next_in  = (Bytef*)at;
+        _inflater->avail_in = static_cast<uInt>(length);
+        // a full output buffer may leave decoded bytes in zlib, drain them even if the input is used up
+        while (_inflater->avail_in > 0 || _inflater->avail_out == 0)
+        {
+            _inflater->next_out  = (Bytef*)buffer;
+            _inflater->avail_out = sizeof(buffer);
+            int err              = inflate(_inflater, Z_NO_FLUSH);
+            if (err == Z_DATA_ERROR && !_rawInflate && _inflater->total_out == 0)
+            {
+                // some servers send "deflate" without the zlib header
+                _rawInflate = true;
+                inflateReset2(_inflater, -15);
+                _inflater->next_in  = (Bytef*)_inflateHead.data();
+                _inflater->avail_in = static_cast<uInt>(_inflateHead.size());
+                continue;
+            }
+            if (err != Z_OK && err != Z_STREAM_END && err != Z_BUF_ERROR)
+                return -1;
+
+            size_t size = sizeof(buffer) - _inflater->avail_out;
+            if (size > 0 && deliverBody(buffer, size) != 0)
+                return -1;
+            if (err == Z_STREAM_END || (err == Z_BUF_ERROR && size == 0))
+                break;
+        }
+        return 0;
+    }
+
+    int deliverBody(const char* data, size_t size)
+    {
+        auto& callback = _pHttpRequest->getResponseDataCallback();
+        // bodies of redirects aren't the requested content
+        auto status = _context.status_code;
+        if (callback && status != 301 && status != 302 && status != 307)
+            callback(this, data, size);
+        else
+            _responseData.insert(_responseData.end(), data, data + size);
+        return 0;
+    }
+
+    void resetInflater()
+    {
+        if (_inflater)
+        {
+            inflateEnd(_inflater);
+            delete _inflater;
+            _inflater = nullptr;
+        }
+        _rawInflate = false;
+        _inflateHead.clear();
+    }
+
 protected:
     // properties
     HttpRequest* _pHttpRequest;  /// the corresponding HttpRequest pointer who leads to this response
@@ -270,6 +371,12 @@ protected:
 
     Uri _requestUri;
     bool _finished = false;             /// to indicate if the http request is successful simply
+    bool _keepAlive = false;            /// the server allows to reuse the connection
+    size_t _receivedBytes = 0;          /// bytes received for the current location
+    bool _decodeContent = false;        /// the client asked for a compressed body and decodes it
+    bool _rawInflate = false;
+    z_stream* _inflater = nullptr;
+    yasio::sbyte_buffer _inflateHead;   /// the compressed bytes read before the first decoded one
     yasio::sbyte_buffer _responseData;  /// the returned raw data. You can also dump it as a string
     std::string _currentHeader;
     std::string _currentHeaderValue;
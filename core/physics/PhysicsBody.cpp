@@ -110,6 +110,10 @@ PhysicsBody::PhysicsBody()
     , _recordedAngle(0.0)
     , _recordScaleX(1.f)
     , _recordScaleY(1.f)
+    , _prevRotation(0.f)
+    , _interpolatedRotation(0.f)
+    , _hasPrevState(false)
+    , _interpolated(false)
     , _fixedUpdate(false)
 {
     _name = COMPONENT_NAME;
@@ -930,7 +934,16 @@ void PhysicsBody::beforeSimulation(const Mat4& parentToWorldTransform,
     }
 
     // set rotation
-    if (_recordedRotation != rotation)
+    if (_interpolated)
+    {
+        // the node shows an interpolated state, the body only follows the node when it was moved by the user
+        if (std::abs(_interpolatedRotation - rotation) > 0.001f)
+        {
+            setRotation(rotation);
+            _hasPrevState = false;
+        }
+    }
+    else if (_recordedRotation != rotation)
     {
         setRotation(rotation);
     }
@@ -938,7 +951,16 @@ void PhysicsBody::beforeSimulation(const Mat4& parentToWorldTransform,
     // set position
     auto worldPosition = _ownerCenterOffset;
     nodeToWorldTransform.transformVector(worldPosition.x, worldPosition.y, worldPosition.z, 1.f, &worldPosition);
-    setPosition(worldPosition.x, worldPosition.y);
+    if (!_interpolated)
+    {
+        setPosition(worldPosition.x, worldPosition.y);
+    }
+    else if (std::abs(_interpolatedPosition.x - worldPosition.x) > 0.001f ||
+             std::abs(_interpolatedPosition.y - worldPosition.y) > 0.001f)
+    {
+        setPosition(worldPosition.x, worldPosition.y);
+        _hasPrevState = false;
+    }
 
     _recordPosX = worldPosition.x;
     _recordPosY = worldPosition.y;
@@ -952,12 +974,26 @@ void PhysicsBody::beforeSimulation(const Mat4& parentToWorldTransform,
     }
 }
 
-void PhysicsBody::afterSimulation(const Mat4& parentToWorldTransform, float parentRotation)
+void PhysicsBody::afterSimulation(const Mat4& parentToWorldTransform, float parentRotation, float alpha)
 {
+    auto tmp      = getPosition();
+    auto rotation = getRotation();
+
+    _interpolated = alpha >= 0.f;
+    if (_interpolated)
+    {
+        if (_hasPrevState)
+        {
+            tmp      = _prevPosition.lerp(tmp, alpha);
+            rotation = _prevRotation + (rotation - _prevRotation) * alpha;
+        }
+        _interpolatedPosition = tmp;
+        _interpolatedRotation = rotation;
+    }
+
     // set Node position
-    auto tmp = getPosition();
     Vec3 positionInParent(tmp.x, tmp.y, 0.f);
-    if (_recordPosX != positionInParent.x || _recordPosY != positionInParent.y)
+    if (_interpolated || _recordPosX != positionInParent.x || _recordPosY != positionInParent.y)
     {
         parentToWorldTransform.getInversed().transformVector(positionInParent.x, positionInParent.y, positionInParent.z,
                                                              1.f, &positionInParent);
@@ -965,7 +1001,14 @@ void PhysicsBody::afterSimulation(const Mat4& parentToWorldTransform, float pare
     }
 
     // set Node rotation
-    _owner->setRotation(getRotation() - parentRotation);
+    _owner->setRotation(rotation - parentRotation);
+}
+
+void PhysicsBody::recordPreviousState()
+{
+    _prevPosition = getPosition();
+    _prevRotation = getRotation();
+    _hasPrevState = true;
 }
 
 void PhysicsBody::onEnter()
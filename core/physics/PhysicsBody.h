@@ -567,7 +567,9 @@ protected:
                           float scaleX,
                           float scaleY,
                           float rotation);
-    void afterSimulation(const Mat4& parentToWorldTransform, float parentRotation);
+    // alpha is the interpolation factor between the previous and the current state, negative when not interpolating
+    void afterSimulation(const Mat4& parentToWorldTransform, float parentRotation, float alpha);
+    void recordPreviousState();
 
 protected:
     std::vector<PhysicsJoint*> _joints;
@@ -612,6 +614,14 @@ protected:
     float _recordPosX;
     float _recordPosY;
 
+    // interpolation state, see PhysicsWorld::setInterpolationEnabled
+    Vec2 _prevPosition;
+    float _prevRotation;
+    Vec2 _interpolatedPosition;
+    float _interpolatedRotation;
+    bool _hasPrevState;
+    bool _interpolated;
+
     // fixed update state
     bool _fixedUpdate;
 
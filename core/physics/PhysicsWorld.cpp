@@ -52,6 +52,13 @@ const int PhysicsWorld::DEBUGDRAW_JOINT   = 0x02;
 const int PhysicsWorld::DEBUGDRAW_CONTACT = 0x04;
 const int PhysicsWorld::DEBUGDRAW_ALL     = DEBUGDRAW_SHAPE | DEBUGDRAW_JOINT | DEBUGDRAW_CONTACT;
 
+const int PhysicsWorld::CONTACT_EVENT_BEGIN     = 0x01;
+const int PhysicsWorld::CONTACT_EVENT_PRESOLVE  = 0x02;
+const int PhysicsWorld::CONTACT_EVENT_POSTSOLVE = 0x04;
+const int PhysicsWorld::CONTACT_EVENT_SEPARATE  = 0x08;
+const int PhysicsWorld::CONTACT_EVENT_ALL =
+    CONTACT_EVENT_BEGIN | CONTACT_EVENT_PRESOLVE | CONTACT_EVENT_POSTSOLVE | CONTACT_EVENT_SEPARATE;
+
 const float _debugDrawThickness = 0.5f;  // thickness of the DebugDraw lines, circles, dots, polygons
 
 namespace
@@ -398,9 +405,7 @@ bool PhysicsWorld::collisionBeginCallback(PhysicsContact& contact)
 
     if (contact.isNotificationEnabled())
     {
-        contact.setEventCode(PhysicsContact::EventCode::BEGIN);
-        contact.setWorld(this);
-        _eventDispatcher->dispatchEvent(&contact);
+        dispatchContact(contact, PhysicsContact::EventCode::BEGIN, CONTACT_EVENT_BEGIN);
     }
 
     return ret ? contact.resetResult() : false;
@@ -413,9 +418,7 @@ bool PhysicsWorld::collisionPreSolveCallback(PhysicsContact& contact)
         return true;
     }
 
-    contact.setEventCode(PhysicsContact::EventCode::PRESOLVE);
-    contact.setWorld(this);
-    _eventDispatcher->dispatchEvent(&contact);
+    dispatchContact(contact, PhysicsContact::EventCode::PRESOLVE, CONTACT_EVENT_PRESOLVE);
 
     return contact.resetResult();
 }
@@ -427,9 +430,7 @@ void PhysicsWorld::collisionPostSolveCallback(PhysicsContact& contact)
         return;
     }
 
-    contact.setEventCode(PhysicsContact::EventCode::POSTSOLVE);
-    contact.setWorld(this);
-    _eventDispatcher->dispatchEvent(&contact);
+    dispatchContact(contact, PhysicsContact::EventCode::POSTSOLVE, CONTACT_EVENT_POSTSOLVE);
 }
 
 void PhysicsWorld::collisionSeparateCallback(PhysicsContact& contact)
@@ -439,9 +440,107 @@ void PhysicsWorld::collisionSeparateCallback(PhysicsContact& contact)
         return;
     }
 
-    contact.setEventCode(PhysicsContact::EventCode::SEPARATE);
-    contact.setWorld(this);
-    _eventDispatcher->dispatchEvent(&contact);
+    dispatchContact(contact, PhysicsContact::EventCode::SEPARATE, CONTACT_EVENT_SEPARATE);
+}
+
+void PhysicsWorld::dispatchContact(PhysicsContact& contact, PhysicsContact::EventCode eventCode, int eventFlag)
+{
+    if (_contactRecordMask & eventFlag)
+    {
+        auto& record     = _contactRecords.emplace_back();
+        record.eventCode = eventCode;
+        record.shapeA    = contact.getShapeA();
+        record.shapeB    = contact.getShapeB();
+        record.shapeA->retain();
+        record.shapeB->retain();
+
+        if (eventCode != PhysicsContact::EventCode::SEPARATE)
+        {
+            auto arb          = static_cast<cpArbiter*>(contact._contactInfo);
+            record.data.count = (std::min)(cpArbiterGetCount(arb), PhysicsContactData::POINT_MAX);
+            for (int i = 0; i < record.data.count; ++i)
+                record.data.points[i] = PhysicsHelper::cpv2vec2(cpArbiterGetPointA(arb, i));
+            record.data.normal = record.data.count > 0 ? PhysicsHelper::cpv2vec2(cpArbiterGetNormal(arb)) : Vec2::ZERO;
+        }
+    }
+
+    if (_contactEventDispatchEnabled)
+    {
+        contact.setEventCode(eventCode);
+        contact.setWorld(this);
+        _eventDispatcher->dispatchEvent(&contact);
+    }
+}
+
+int PhysicsWorld::addContactBatchHandler(const PhysicsContactBatchFunc& handler, int eventMask, int categoryBitmask)
+{
+    AXASSERT(handler != nullptr, "handler shouldn't be nullptr");
+
+    _contactBatchHandlers.push_back({++_contactBatchHandlerId, eventMask, categoryBitmask, handler});
+    _contactRecordMask |= eventMask;
+    return _contactBatchHandlerId;
+}
+
+void PhysicsWorld::removeContactBatchHandler(int handlerId)
+{
+    auto it = std::find_if(_contactBatchHandlers.begin(), _contactBatchHandlers.end(),
+                           [handlerId](const ContactBatchHandler& handler) { return handler.id == handlerId; });
+    if (it == _contactBatchHandlers.end())
+        return;
+
+    _contactBatchHandlers.erase(it);
+    _contactRecordMask = 0;
+    for (auto&& handler : _contactBatchHandlers)
+        _contactRecordMask |= handler.eventMask;
+}
+
+void PhysicsWorld::flushContactRecords()
+{
+    if (_contactRecords.empty())
+        return;
+
+    // handlers may add or remove handlers and bodies, deliver from a copy of the current state
+    auto records  = std::move(_contactRecords);
+    auto handlers = _contactBatchHandlers;
+    _contactRecords.clear();
+
+    for (auto&& handler : handlers)
+    {
+        // skip a handler removed by an earlier one, its captures may be gone already
+        auto handlerId = handler.id;
+        if (std::none_of(_contactBatchHandlers.begin(), _contactBatchHandlers.end(),
+                         [handlerId](const ContactBatchHandler& other) { return other.id == handlerId; }))
+            continue;
+
+        const int eventMask = handler.eventMask;
+        const int category  = handler.categoryBitmask;
+        if (eventMask == _contactRecordMask && category == (int)UINT_MAX)
+        {
+            handler.func(*this, records.data(), records.size());
+            continue;
+        }
+
+        _filteredContactRecords.clear();
+        for (auto&& record : records)
+        {
+            if ((eventMask & (1 << ((int)record.eventCode - 1))) &&
+                ((record.shapeA->getCategoryBitmask() & category) || (record.shapeB->getCategoryBitmask() & category)))
+                _filteredContactRecords.emplace_back(record);
+        }
+        if (!_filteredContactRecords.empty())
+            handler.func(*this, _filteredContactRecords.data(), _filteredContactRecords.size());
+    }
+
+    for (auto&& record : records)
+    {
+        record.shapeA->release();
+        record.shapeB->release();
+    }
+
+    // keep the capacity for the next step
+    records.clear();
+    if (_contactRecords.empty())
+        _contactRecords.swap(records);
 }
 
 void PhysicsWorld::rayCast(PhysicsRayCastCallbackFunc func, const Vec2& point1, const Vec2& point2, void* data)
@@ -523,7 +622,7 @@ bool PhysicsWorld::init()
         _cpSpace = cpSpaceNew();
 #    else
         _cpSpace = cpHastySpaceNew();
-        cpHastySpaceSetThreads(_cpSpace, 0);
+        cpHastySpaceSetThreads(_cpSpace, _deterministic ? 1 : _solverThreads);
 #    endif
         AX_BREAK_IF(_cpSpace == nullptr);
 
@@ -945,13 +1044,10 @@ void PhysicsWorld::update(float delta, bool userCall /* = false*/)
         return;
     }
 
+    _interpolationAlpha = -1.f;
     if (userCall)
     {
-#    if AX_TARGET_PLATFORM == AX_PLATFORM_WIN32
-        cpSpaceStep(_cpSpace, delta);
-#    else
-        cpHastySpaceStep(_cpSpace, delta);
-#    endif
+        stepSpace(delta);
     }
     else
     {
@@ -960,21 +1056,33 @@ void PhysicsWorld::update(float delta, bool userCall /* = false*/)
         {
             const float step = 1.0f / _fixedRate;
             const float dt   = step * _speed;
+            int steps        = 0;
             while (_updateTime > step)
             {
                 _updateTime -= step;
+                ++steps;
+            }
+
+            for (int i = 0; i < steps; ++i)
+            {
+                // nodes are interpolated from the state before the last step of this update
+                if (_interpolationEnabled && i == steps - 1)
+                {
+                    for (auto&& body : _bodies)
+                        body->recordPreviousState();
+                }
+
                 for (auto&& body : _bodies)
                 {
                     body->fixedUpdate(dt);
                 }
                 _scene->fixedUpdate(dt);
 
-#    if AX_TARGET_PLATFORM == AX_PLATFORM_WIN32
-                cpSpaceStep(_cpSpace, dt);
-#    else
-                cpHastySpaceStep(_cpSpace, dt);
-#    endif                
+                stepSpace(dt);
             }
+
+            if (_interpolationEnabled)
+                _interpolationAlpha = _updateTime / step;
         }
         else
         {
@@ -983,11 +1091,7 @@ void PhysicsWorld::update(float delta, bool userCall /* = false*/)
                 const float dt = _updateTime * _speed / _substeps;
                 for (int i = 0; i < _substeps; ++i)
                 {
-#    if AX_TARGET_PLATFORM == AX_PLATFORM_WIN32
-                    cpSpaceStep(_cpSpace, dt);
-#    else
-                    cpHastySpaceStep(_cpSpace, dt);
-#    endif
+                    stepSpace(dt);
                 }
                 _updateRateCount = 0;
                 _updateTime      = 0.0f;
@@ -1004,10 +1108,41 @@ void PhysicsWorld::update(float delta, bool userCall /* = false*/)
     // PhysicsWorld::afterSimulation() will depend on the sequence.
     afterSimulation(_scene, sceneToWorldTransform, 0.f);
 
+    flushContactRecords();
+
     if (_postUpdateCallback)
         _postUpdateCallback();  // fix #11154
 }
 
+void PhysicsWorld::stepSpace(float dt)
+{
+#    if AX_TARGET_PLATFORM == AX_PLATFORM_WIN32
+    cpSpaceStep(_cpSpace, dt);
+#    else
+    cpHastySpaceStep(_cpSpace, dt);
+#    endif
+}
+
+void PhysicsWorld::setSolverThreads(int threads)
+{
+    _solverThreads = (std::max)(threads, 0);
+#    if AX_TARGET_PLATFORM != AX_PLATFORM_WIN32
+    if (_cpSpace && !_deterministic)
+        cpHastySpaceSetThreads(_cpSpace, _solverThreads);
+#    endif
+}
+
+void PhysicsWorld::setDeterministic(bool deterministic)
+{
+    _deterministic = deterministic;
+#    if AX_TARGET_PLATFORM != AX_PLATFORM_WIN32
+    if (_cpSpace)
+        cpHastySpaceSetThreads(_cpSpace, deterministic ? 1 : _solverThreads);
+#    endif
+    if (deterministic && _fixedRate == 0)
+        setFixedUpdateRate(60);
+}
+
 PhysicsWorld* PhysicsWorld::construct(Scene* scene)
 {
     PhysicsWorld* world = new PhysicsWorld();
@@ -1037,6 +1172,13 @@ PhysicsWorld::PhysicsWorld()
     , _debugDraw(nullptr)
     , _debugDrawMask(DEBUGDRAW_NONE)
     , _eventDispatcher(nullptr)
+    , _contactRecordMask(0)
+    , _contactBatchHandlerId(0)
+    , _contactEventDispatchEnabled(true)
+    , _solverThreads(0)
+    , _interpolationAlpha(-1.f)
+    , _interpolationEnabled(false)
+    , _deterministic(false)
 {}
 
 PhysicsWorld::~PhysicsWorld()
@@ -1052,6 +1194,12 @@ PhysicsWorld::~PhysicsWorld()
 #    endif
     }
     AX_SAFE_RELEASE_NULL(_debugDraw);
+
+    for (auto&& record : _contactRecords)
+    {
+        record.shapeA->release();
+        record.shapeB->release();
+    }
 }
 
 void PhysicsWorld::beforeSimulation(Node* node,
@@ -1084,7 +1232,7 @@ void PhysicsWorld::afterSimulation(Node* node, const Mat4& parentToWorldTransfor
     auto physicsBody = node->getPhysicsBody();
     if (physicsBody)
     {
-        physicsBody->afterSimulation(parentToWorldTransform, parentRotation);
+        physicsBody->afterSimulation(parentToWorldTransform, parentRotation, _interpolationAlpha);
     }
 
     for (auto&& child : node->getChildren())
@@ -34,6 +34,7 @@
 #    include "base/Vector.h"
 #    include "math/Math.h"
 #    include "physics/PhysicsBody.h"
+#    include "physics/PhysicsContact.h"
 
 struct cpSpace;
 
@@ -86,6 +87,22 @@ typedef std::function<bool(PhysicsWorld& world, const PhysicsRayCastInfo& info,
 typedef std::function<bool(PhysicsWorld&, PhysicsShape&, void*)> PhysicsQueryRectCallbackFunc;
 typedef PhysicsQueryRectCallbackFunc PhysicsQueryPointCallbackFunc;
 
+/**
+ * @brief A contact event recorded during a step, delivered in batch by PhysicsWorld::addContactBatchHandler.
+ *
+ * The shapes are retained until the batch was delivered. The contact data is empty for SEPARATE events.
+ */
+typedef struct PhysicsContactRecord
+{
+    PhysicsContact::EventCode eventCode;
+    PhysicsShape* shapeA;
+    PhysicsShape* shapeB;
+    PhysicsContactData data;
+} PhysicsContactRecord;
+
+typedef std::function<void(PhysicsWorld& world, const PhysicsContactRecord* records, size_t count)>
+    PhysicsContactBatchFunc;
+
 /**
  * @addtogroup physics
  * @{
@@ -107,6 +124,12 @@ public:
     static const int DEBUGDRAW_CONTACT;  ///< draw contact
     static const int DEBUGDRAW_ALL;      ///< draw all
 
+    static const int CONTACT_EVENT_BEGIN;      ///< contact begin
+    static const int CONTACT_EVENT_PRESOLVE;   ///< contact pre solve
+    static const int CONTACT_EVENT_POSTSOLVE;  ///< contact post solve
+    static const int CONTACT_EVENT_SEPARATE;   ///< contact separate
+    static const int CONTACT_EVENT_ALL;        ///< all contact events
+
 public:
     /**
      * Adds a joint to this physics world.
@@ -341,6 +364,35 @@ public:
     /** get the number of substeps */
     int getFixedUpdateRate() const { return _fixedRate; }
 
+    /**
+     * Set the number of threads used by the solver.
+     *
+     * 0 uses one thread per CPU core (default), 1 solves on the calling thread only.
+     * @attention Ignored on win32, and while the world is deterministic.
+     */
+    void setSolverThreads(int threads);
+    /** Get the number of solver threads requested by setSolverThreads. */
+    int getSolverThreads() const { return _solverThreads; }
+
+    /**
+     * Set whether node transforms are interpolated between the last two fixed steps.
+     *
+     * With a fixed update rate the simulation time lags up to one step behind the frame time, interpolating hides the
+     * resulting stutter when the frame rate doesn't match the fixed rate. Moving a node still moves its body.
+     * @attention Only takes effect with setFixedUpdateRate or in deterministic mode.
+     */
+    void setInterpolationEnabled(bool enabled) { _interpolationEnabled = enabled; }
+    bool isInterpolationEnabled() const { return _interpolationEnabled; }
+
+    /**
+     * Set whether the simulation is deterministic, e.g. for replays.
+     *
+     * A deterministic world solves on a single thread and is only stepped with the fixed update rate, it's set to 60
+     * if none was set. The same inputs then give the same results on the same build.
+     */
+    void setDeterministic(bool deterministic);
+    bool isDeterministic() const { return _deterministic; }
+
     /**
      * Set the debug draw mask of this physics world.
      *
@@ -385,6 +437,31 @@ public:
      */
     bool isAutoStep() { return _autoStep; }
 
+    /**
+     * Registers a handler which receives the contacts of a world update at once, after the bodies were synchronized
+     * with their nodes, instead of one EventListenerPhysicsContact dispatch per contact.
+     *
+     * Contacts are only recorded when the shapes' contact test bitmasks match, like for the event listeners. Batched
+     * contacts are delivered after the step, so they can't reject a collision or change its presolve values.
+     * @param handler The handler receiving a contiguous array of records, ordered as they happened.
+     * @param eventMask CONTACT_EVENT_* flags of the events to record, BEGIN and SEPARATE by default.
+     * @param categoryBitmask Only contacts where either shape's category bitmask matches are delivered.
+     * @return An id for removeContactBatchHandler.
+     */
+    int addContactBatchHandler(const PhysicsContactBatchFunc& handler,
+                               int eventMask       = CONTACT_EVENT_BEGIN | CONTACT_EVENT_SEPARATE,
+                               int categoryBitmask = UINT_MAX);
+
+    /** Removes a handler added with addContactBatchHandler. */
+    void removeContactBatchHandler(int handlerId);
+
+    /**
+     * Sets whether contacts are dispatched to EventListenerPhysicsContact listeners, default is true.
+     * Disable it when all contacts are handled in batch to skip walking the listeners per contact.
+     */
+    void setContactEventDispatchEnabled(bool enabled) { _contactEventDispatchEnabled = enabled; }
+    bool isContactEventDispatchEnabled() const { return _contactEventDispatchEnabled; }
+
     /**
      * The step for physics world.
      *
@@ -418,6 +495,10 @@ protected:
     virtual void updateBodies();
     virtual void updateJoints();
 
+    void dispatchContact(PhysicsContact& contact, PhysicsContact::EventCode eventCode, int eventFlag);
+    void flushContactRecords();
+    void stepSpace(float dt);
+
 protected:
     Vec2 _gravity;
     float _speed;
@@ -447,6 +528,25 @@ protected:
     std::function<void()> _preUpdateCallback;
     std::function<void()> _postUpdateCallback;
 
+    struct ContactBatchHandler
+    {
+        int id;
+        int eventMask;
+        int categoryBitmask;
+        PhysicsContactBatchFunc func;
+    };
+    std::vector<ContactBatchHandler> _contactBatchHandlers;
+    std::vector<PhysicsContactRecord> _contactRecords;
+    std::vector<PhysicsContactRecord> _filteredContactRecords;
+    int _contactRecordMask;  // union of the handlers' event masks
+    int _contactBatchHandlerId;
+    bool _contactEventDispatchEnabled;
+
+    int _solverThreads;
+    float _interpolationAlpha;  // negative when node transforms aren't interpolated
+    bool _interpolationEnabled;
+    bool _deterministic;
+
 protected:
     PhysicsWorld();
     virtual ~PhysicsWorld();
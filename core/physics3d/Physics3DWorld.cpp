@@ -26,27 +26,104 @@
 
 #include "physics3d/Physics3D.h"
 #include "renderer/Renderer.h"
+#include "base/Director.h"
+#include "base/EventDispatcher.h"
+#include "base/EventListenerCustom.h"
+#include <mutex>
 
 #if defined(AX_ENABLE_3D_PHYSICS)
 
 #    if (AX_ENABLE_BULLET_INTEGRATION)
 
+#        include "bullet/BulletCollision/CollisionDispatch/btCollisionDispatcherMt.h"
+#        include "bullet/BulletDynamics/ConstraintSolver/btSequentialImpulseConstraintSolverMt.h"
+#        include "bullet/BulletDynamics/Dynamics/btDiscreteDynamicsWorldMt.h"
+
+#        if BT_THREADSAFE
+// defined in LinearMath/btThreads.cpp, bullet's own task schedulers wrap their loops in them
+void btPushThreadsAreRunning();
+void btPopThreadsAreRunning();
+#        endif
+
 NS_AX_BEGIN
 
+#        if BT_THREADSAFE
+namespace
+{
+/** Runs the parallel loops of bullet on the job system, the calling thread takes part in them. */
+class JobSystemTaskScheduler : public btITaskScheduler
+{
+public:
+    JobSystemTaskScheduler() : btITaskScheduler("axmol") {}
+
+    int getMaxNumThreads() const override { return BT_MAX_THREAD_COUNT; }
+
+    // bullet indexes per thread data by the thread index, which is unique among the main thread and the workers
+    int getNumThreads() const override
+    {
+        return std::min(Director::getInstance()->getJobSystem()->getWorkerCount() + 1, (int)BT_MAX_THREAD_COUNT);
+    }
+
+    void setNumThreads(int /*numThreads*/) override {}
+
+    // btThreadsAreRunning() must be true inside the loops, bullet locks its shared state only then
+    void parallelFor(int iBegin, int iEnd, int grainSize, const btIParallelForBody& body) override
+    {
+        btPushThreadsAreRunning();
+        Director::getInstance()->getJobSystem()->parallel_for(
+            iBegin, iEnd, std::max(grainSize, 1),
+            [&body](size_t begin, size_t end) { body.forLoop(int(begin), int(end)); });
+        btPopThreadsAreRunning();
+    }
+
+    btScalar parallelSum(int iBegin, int iEnd, int grainSize, const btIParallelSumBody& body) override
+    {
+        std::mutex mutex;
+        btScalar sum = 0;
+        btPushThreadsAreRunning();
+        Director::getInstance()->getJobSystem()->parallel_for(iBegin, iEnd, std::max(grainSize, 1),
+                                                              [&](size_t begin, size_t end) {
+            auto partial = body.sumLoop(int(begin), int(end));
+            std::lock_guard<std::mutex> lck(mutex);
+            sum += partial;
+        });
+        btPopThreadsAreRunning();
+        return sum;
+    }
+};
+
+void installTaskScheduler()
+{
+    // must be done on the main thread, so that it gets the thread index 0
+    static JobSystemTaskScheduler scheduler;
+    if (btGetTaskScheduler() != &scheduler)
+        btSetTaskScheduler(&scheduler);
+}
+}  // namespace
+#        endif
+
 Physics3DWorld::Physics3DWorld()
     : _needCollisionChecking(false)
     , _collisionCheckingFlag(false)
     , _needGhostPairCallbackChecking(false)
+    , _multiThreadingEnabled(false)
+    , _asyncStepEnabled(false)
+    , _asyncStepPending(false)
+    , _afterDrawListener(nullptr)
     , _btPhyiscsWorld(nullptr)
     , _collisionConfiguration(nullptr)
     , _dispatcher(nullptr)
     , _broadphase(nullptr)
     , _solver(nullptr)
+    , _solverPool(nullptr)
     , _ghostCallback(nullptr)
     , _debugDrawer(nullptr)
 {}
 Physics3DWorld::~Physics3DWorld()
 {
+    waitForStep();
+    if (_afterDrawListener)
+        Director::getInstance()->getEventDispatcher()->removeEventListener(_afterDrawListener);
     removeAllPhysics3DConstraints();
     removeAllPhysics3DObjects();
 
@@ -56,6 +133,7 @@ Physics3DWorld::~Physics3DWorld()
     AX_SAFE_DELETE(_ghostCallback);
     AX_SAFE_DELETE(_solver);
     AX_SAFE_DELETE(_btPhyiscsWorld);
+    AX_SAFE_DELETE(_solverPool);
     AX_SAFE_DELETE(_debugDrawer);
     for (auto&& it : _physicsComponents)
         it->setPhysics3DObject(nullptr);
@@ -72,6 +150,7 @@ Physics3DWorld* Physics3DWorld::create(Physics3DWorldDes* info)
 
 void Physics3DWorld::setGravity(const Vec3& gravity)
 {
+    waitForStep();
     _btPhyiscsWorld->setGravity(convertVec3TobtVector3(gravity));
 }
 
@@ -86,21 +165,44 @@ bool Physics3DWorld::init(Physics3DWorldDes* info)
     _collisionConfiguration = new btDefaultCollisionConfiguration();
     //_collisionConfiguration->setConvexConvexMultipointIterations();
 
-    /// use the default collision dispatcher. For parallel processing you can use a different dispatcher (see
-    /// Extras/BulletMultiThreaded)
-    _dispatcher = new btCollisionDispatcher(_collisionConfiguration);
-
     _broadphase = new btDbvtBroadphase();
 
-    /// the default constraint solver. For parallel processing you can use a different solver (see
-    /// Extras/BulletMultiThreaded)
-    btSequentialImpulseConstraintSolver* sol = new btSequentialImpulseConstraintSolver();
-    _solver                                  = sol;
-
     btGhostPairCallback* ghostCallback = new btGhostPairCallback();
     _ghostCallback                     = ghostCallback;
 
-    _btPhyiscsWorld = new btDiscreteDynamicsWorld(_dispatcher, _broadphase, _solver, _collisionConfiguration);
+    if (info->isMultiThreadingEnabled)
+    {
+#        if BT_THREADSAFE
+        _multiThreadingEnabled = true;
+#        else
+        AXLOGW("Physics3DWorld: bullet isn't built with BT_THREADSAFE, use the single threaded world");
+#        endif
+    }
+
+#        if BT_THREADSAFE
+    if (_multiThreadingEnabled)
+    {
+        installTaskScheduler();
+
+        /// the narrowphase, the islands solving and the integration run in parallel on the job system,
+        /// large islands are solved by the multithreaded solver
+        _dispatcher     = new btCollisionDispatcherMt(_collisionConfiguration);
+        _solver         = new btSequentialImpulseConstraintSolverMt();
+        _solverPool     = new btConstraintSolverPoolMt(btGetTaskScheduler()->getNumThreads());
+        _btPhyiscsWorld = new btDiscreteDynamicsWorldMt(_dispatcher, _broadphase, _solverPool, _solver,
+                                                        _collisionConfiguration);
+    }
+    else
+#        endif
+    {
+        /// use the default collision dispatcher
+        _dispatcher = new btCollisionDispatcher(_collisionConfiguration);
+
+        /// the default constraint solver
+        _solver = new btSequentialImpulseConstraintSolver();
+
+        _btPhyiscsWorld = new btDiscreteDynamicsWorld(_dispatcher, _broadphase, _solver, _collisionConfiguration);
+    }
     _btPhyiscsWorld->setGravity(convertVec3TobtVector3(info->gravity));
     if (info->isDebugDrawEnabled)
     {
@@ -113,6 +215,7 @@ bool Physics3DWorld::init(Physics3DWorldDes* info)
 
 void Physics3DWorld::setDebugDrawEnable(bool enableDebugDraw)
 {
+    waitForStep();
     if (enableDebugDraw && _btPhyiscsWorld->getDebugDrawer() == nullptr)
     {
         _debugDrawer = new Physics3DDebugDrawer();
@@ -127,6 +230,7 @@ bool Physics3DWorld::isDebugDrawEnabled() const
 
 void Physics3DWorld::addPhysics3DObject(Physics3DObject* physicsObj)
 {
+    waitForStep();
     auto it = std::find(_objects.begin(), _objects.end(), physicsObj);
     if (it == _objects.end())
     {
@@ -147,6 +251,7 @@ void Physics3DWorld::addPhysics3DObject(Physics3DObject* physicsObj)
 
 void Physics3DWorld::removePhysics3DObject(Physics3DObject* physicsObj)
 {
+    waitForStep();
     auto it = std::find(_objects.begin(), _objects.end(), physicsObj);
     if (it != _objects.end())
     {
@@ -167,6 +272,7 @@ void Physics3DWorld::removePhysics3DObject(Physics3DObject* physicsObj)
 
 void Physics3DWorld::removeAllPhysics3DObjects()
 {
+    waitForStep();
     for (auto&& it : _objects)
     {
         if (it->getObjType() == Physics3DObject::PhysicsObjType::RIGID_BODY)
@@ -186,6 +292,7 @@ void Physics3DWorld::removeAllPhysics3DObjects()
 
 void Physics3DWorld::addPhysics3DConstraint(Physics3DConstraint* constraint, bool disableCollisionsBetweenLinkedObjs)
 {
+    waitForStep();
     auto it = std::find(_constraints.begin(), _constraints.end(), constraint);
     if (it != _constraints.end())
         return;
@@ -207,6 +314,7 @@ void Physics3DWorld::addPhysics3DConstraint(Physics3DConstraint* constraint, boo
 
 void Physics3DWorld::removePhysics3DConstraint(Physics3DConstraint* constraint)
 {
+    waitForStep();
     auto it = std::find(_constraints.begin(), _constraints.end(), constraint);
 
     if (it != _constraints.end())
@@ -220,6 +328,7 @@ void Physics3DWorld::removePhysics3DConstraint(Physics3DConstraint* constraint)
 
 void Physics3DWorld::removeAllPhysics3DConstraints()
 {
+    waitForStep();
     for (auto&& it : _objects)
     {
         auto type = it->getObjType();
@@ -259,12 +368,25 @@ void Physics3DWorld::stepSimulate(float dt)
 {
     if (_btPhyiscsWorld)
     {
+        // sync the step of the previous frame first, the nodes may have moved since then
+        syncAsyncStep();
+
         setGhostPairCallback();
         // should sync kinematic node before simulation
         for (auto&& it : _physicsComponents)
         {
             it->preSimulate();
         }
+
+        if (_asyncStepEnabled)
+        {
+            auto world        = _btPhyiscsWorld;
+            _asyncStepPending = true;
+            _stepJob          = Director::getInstance()->getJobSystem()->schedule(
+                [world, dt]() { world->stepSimulation(dt, 3); });
+            return;
+        }
+
         _btPhyiscsWorld->stepSimulation(dt, 3);
         // sync dynamic node after simulation
         for (auto&& it : _physicsComponents)
@@ -276,10 +398,56 @@ void Physics3DWorld::stepSimulate(float dt)
     }
 }
 
+void Physics3DWorld::setAsyncStepEnabled(bool enabled)
+{
+    if (_asyncStepEnabled == enabled)
+        return;
+
+    auto eventDispatcher = Director::getInstance()->getEventDispatcher();
+    if (enabled)
+    {
+        // the step overlaps with rendering and must be done before the next frame runs its updates
+        _afterDrawListener = eventDispatcher->addCustomEventListener(Director::EVENT_AFTER_DRAW,
+                                                                     [this](EventCustom* /*event*/) { waitForStep(); });
+    }
+    else
+    {
+        syncAsyncStep();
+        eventDispatcher->removeEventListener(_afterDrawListener);
+        _afterDrawListener = nullptr;
+    }
+    _asyncStepEnabled = enabled;
+}
+
+void Physics3DWorld::waitForStep()
+{
+    if (_stepJob.isValid())
+    {
+        _stepJob.wait();
+        _stepJob = JobHandle();
+    }
+}
+
+void Physics3DWorld::syncAsyncStep()
+{
+    waitForStep();
+    if (_asyncStepPending)
+    {
+        _asyncStepPending = false;
+        for (auto&& it : _physicsComponents)
+        {
+            it->postSimulate();
+        }
+        if (needCollisionChecking())
+            collisionChecking();
+    }
+}
+
 void Physics3DWorld::debugDraw(Renderer* renderer)
 {
     if (_debugDrawer)
     {
+        waitForStep();
         _debugDrawer->clear();
         _btPhyiscsWorld->debugDrawWorld();
         _debugDrawer->draw(renderer);
@@ -290,6 +458,7 @@ bool Physics3DWorld::rayCast(const ax::Vec3& startPos,
                              const ax::Vec3& endPos,
                              Physics3DWorld::HitResult* result)
 {
+    waitForStep();
     auto btStart = convertVec3TobtVector3(startPos);
     auto btEnd   = convertVec3TobtVector3(endPos);
     btCollisionWorld::ClosestRayResultCallback btResult(btStart, btEnd);
@@ -312,6 +481,7 @@ bool Physics3DWorld::sweepShape(Physics3DShape* shape,
 {
     AX_ASSERT(shape->getShapeType() != Physics3DShape::ShapeType::HEIGHT_FIELD &&
               shape->getShapeType() != Physics3DShape::ShapeType::MESH);
+    waitForStep();
     auto btStart = convertMat4TobtTransform(startTransform);
     auto btEnd   = convertMat4TobtTransform(endTransform);
     btCollisionWorld::ClosestConvexResultCallback btResult(btStart.getOrigin(), btEnd.getOrigin());
@@ -30,6 +30,7 @@
 #include "math/Math.h"
 #include "base/Object.h"
 #include "base/Config.h"
+#include "base/JobSystem.h"
 
 #if defined(AX_ENABLE_3D_PHYSICS)
 
@@ -40,6 +41,7 @@ class btDefaultCollisionConfiguration;
 class btCollisionDispatcher;
 struct btDbvtBroadphase;
 class btSequentialImpulseConstraintSolver;
+class btConstraintSolverPoolMt;
 class btGhostPairCallback;
 class btRigidBody;
 class btCollisionObject;
@@ -56,18 +58,21 @@ class Physics3DDebugDrawer;
 class Physics3DComponent;
 class Physics3DShape;
 class Renderer;
+class EventListenerCustom;
 
 /**
  * @brief The description of Physics3DWorld.
  */
 struct AX_DLL Physics3DWorldDes
 {
-    bool isDebugDrawEnabled;  // using physics debug draw?, false by default
-    ax::Vec3 gravity;    // gravity, (0, -9.8, 0)
+    bool isDebugDrawEnabled;       // using physics debug draw?, false by default
+    bool isMultiThreadingEnabled;  // using bullet's multithreaded world on the job system?, false by default
+    ax::Vec3 gravity;              // gravity, (0, -9.8, 0)
     Physics3DWorldDes()
     {
-        isDebugDrawEnabled = false;
-        gravity            = ax::Vec3(0.f, -9.8f, 0.f);
+        isDebugDrawEnabled      = false;
+        isMultiThreadingEnabled = false;
+        gravity                 = ax::Vec3(0.f, -9.8f, 0.f);
     }
 };
 
@@ -121,6 +126,28 @@ public:
     /** Simulate one frame. */
     void stepSimulate(float dt);
 
+    /**
+     * Check the world uses bullet's multithreaded dynamics world. It needs bullet built with BT_THREADSAFE
+     * (AX_ENABLE_3D_PHYSICS_MT, off by default since it changes the whole bullet library), otherwise the world
+     * falls back to the single threaded one.
+     */
+    bool isMultiThreadingEnabled() const { return _multiThreadingEnabled; }
+
+    /**
+     * Enable or disable asynchronous stepping, false by default.
+     * When enabled, stepSimulate() schedules the step on the job system so that it overlaps with rendering, the
+     * step is waited for after the frame is drawn and its result is synced to the Physics3DComponents at the start
+     * of the next stepSimulate(). Nodes show the physics state one frame late.
+     * Don't touch the bullet objects of the world while the step runs, call waitForStep() first.
+     */
+    void setAsyncStepEnabled(bool enabled);
+
+    /** Check asynchronous stepping is enabled. */
+    bool isAsyncStepEnabled() const { return _asyncStepEnabled; }
+
+    /** Block until the step scheduled by stepSimulate() has finished, returns at once if no step is running. */
+    void waitForStep();
+
     /** Enable or disable debug drawing. */
     void setDebugDrawEnable(bool enableDebugDraw);
 
@@ -160,6 +187,7 @@ public:
 
 protected:
     void removePhysics3DConstraintFromBullet(Physics3DConstraint* constraint);
+    void syncAsyncStep();
 
     std::vector<Physics3DObject*> _objects;
     std::vector<Physics3DConstraint*> _constraints;
@@ -167,6 +195,11 @@ protected:
     bool _needCollisionChecking;
     bool _collisionCheckingFlag;
     bool _needGhostPairCallbackChecking;
+    bool _multiThreadingEnabled;
+    bool _asyncStepEnabled;
+    bool _asyncStepPending;  // a finished step isn't synced to the components yet
+    JobHandle _stepJob;
+    EventListenerCustom* _afterDrawListener;
 
 #        if (AX_ENABLE_BULLET_INTEGRATION)
     btDynamicsWorld* _btPhyiscsWorld;
@@ -174,6 +207,7 @@ protected:
     btCollisionDispatcher* _dispatcher;
     btDbvtBroadphase* _broadphase;
     btSequentialImpulseConstraintSolver* _solver;
+    btConstraintSolverPoolMt* _solverPool;
     btGhostPairCallback* _ghostCallback;
     Physics3DDebugDrawer* _debugDrawer;
 #        endif  // AX_ENABLE_BULLET_INTEGRATION
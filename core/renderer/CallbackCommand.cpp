@@ -51,11 +51,16 @@ void CallbackCommand::reset()
     _skipBatching = false;
     _is3D = false;
     _depth = 0.0f;
+    func = nullptr;
+    _invoke = nullptr;
+    _callable = nullptr;
 }
 
 void CallbackCommand::execute()
 {
-    if (func)
+    if (_invoke)
+        _invoke(_callable);
+    else if (func)
         func();
 }
 
@@ -69,6 +69,11 @@ public:
     void execute();
     /**Callback function.*/
     std::function<void()> func;
+
+private:
+    /**Callable allocated from the renderer frame allocator, used instead of func when set.*/
+    void (*_invoke)(void*) = nullptr;
+    void* _callable        = nullptr;
 };
 
 NS_AX_END
@@ -0,0 +1,119 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+
+#include "renderer/FrameAllocator.h"
+
+#include <stdlib.h>
+#include <algorithm>
+
+#include "base/Macros.h"
+
+NS_AX_BEGIN
+
+static inline uint8_t* alignPointer(uint8_t* p, size_t alignment)
+{
+    return reinterpret_cast<uint8_t*>((reinterpret_cast<uintptr_t>(p) + alignment - 1) & ~(uintptr_t)(alignment - 1));
+}
+
+FrameAllocator::FrameAllocator(size_t blockSize) : _blockSize(blockSize) {}
+
+FrameAllocator::~FrameAllocator()
+{
+    reset();
+    releaseBlocks(_block);
+}
+
+void* FrameAllocator::allocate(size_t size, size_t alignment)
+{
+    AXASSERT(alignment && (alignment & (alignment - 1)) == 0, "alignment must be a power of two");
+
+    ++_stats.allocations;
+    _stats.bytes += size;
+
+    auto p = alignPointer(_current, alignment);
+    if (_current && p + size <= _end)
+    {
+        _current = p + size;
+        return p;
+    }
+    return allocateFromNewBlock(size, alignment);
+}
+
+void* FrameAllocator::allocateFromNewBlock(size_t size, size_t alignment)
+{
+    const size_t blockSize = (std::max)(_blockSize, size + alignment);
+    auto block             = static_cast<Block*>(malloc(sizeof(Block) + blockSize));
+    AXASSERT(block, "FrameAllocator: out of memory");
+    block->next = _block;
+    block->size = blockSize;
+    _block      = block;
+    _capacity += blockSize;
+    ++_stats.systemAllocations;
+
+    auto data = reinterpret_cast<uint8_t*>(block + 1);
+    auto p    = alignPointer(data, alignment);
+    _current  = p + size;
+    _end      = data + blockSize;
+    return p;
+}
+
+void FrameAllocator::reset()
+{
+    for (auto node = _destructors; node; node = node->next)
+        node->destroy(node->object);
+    _destructors = nullptr;
+
+    // a frame didn't fit in one block: replace the blocks by a single one large enough
+    if (_block && _block->next)
+    {
+        const size_t capacity = _capacity;
+        releaseBlocks(_block);
+        _block    = nullptr;
+        _capacity = 0;
+        _blockSize = (std::max)(_blockSize, capacity);
+        allocateFromNewBlock(0, 1);
+    }
+
+    if (_block)
+    {
+        _current = reinterpret_cast<uint8_t*>(_block + 1);
+        _end     = _current + _block->size;
+    }
+
+    _frameStats = _stats;
+    _stats      = Stats();
+}
+
+void FrameAllocator::releaseBlocks(Block* block)
+{
+    while (block)
+    {
+        auto next = block->next;
+        free(block);
+        block = next;
+    }
+}
+
+NS_AX_END
@@ -0,0 +1,138 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+
+#pragma once
+
+#include <cstddef>
+#include <stdint.h>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "platform/PlatformMacros.h"
+
+NS_AX_BEGIN
+
+/**
+ A linear allocator for memory that only lives for one frame, such as callback closures or transient
+ vertex data of render commands. Allocating is a pointer bump, everything is released at once by `reset()`,
+ which the `Renderer` calls in `Renderer::endFrame()`, once every camera is rendered.
+ Memory comes from blocks which are kept between frames, once the blocks are large enough for a frame
+ no system allocation is made anymore.
+ */
+class AX_DLL FrameAllocator
+{
+public:
+    /** Allocation counters, see getStats and getFrameStats. */
+    struct Stats
+    {
+        /** The number of allocations. */
+        size_t allocations = 0;
+        /** The number of bytes allocated, without alignment padding. */
+        size_t bytes = 0;
+        /** The number of blocks allocated from the system. */
+        size_t systemAllocations = 0;
+    };
+
+    static const size_t DEFAULT_BLOCK_SIZE = 64 * 1024;
+
+    explicit FrameAllocator(size_t blockSize = DEFAULT_BLOCK_SIZE);
+    ~FrameAllocator();
+
+    FrameAllocator(const FrameAllocator&)            = delete;
+    FrameAllocator& operator=(const FrameAllocator&) = delete;
+
+    /** Allocate uninitialized memory, valid until the next reset. */
+    void* allocate(size_t size, size_t alignment = alignof(std::max_align_t));
+
+    /** Allocate an uninitialized array of trivial objects, valid until the next reset. */
+    template <typename T>
+    T* allocateArray(size_t count)
+    {
+        static_assert(std::is_trivially_destructible<T>::value, "use construct for non trivial types");
+        return static_cast<T*>(allocate(sizeof(T) * count, alignof(T)));
+    }
+
+    /** Construct an object, its destructor is called by the next reset. */
+    template <typename T, typename... Args>
+    T* construct(Args&&... args)
+    {
+        if constexpr (std::is_trivially_destructible<T>::value)
+        {
+            return new (allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+        }
+        else
+        {
+            auto object   = new (allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+            auto node     = static_cast<Destructor*>(allocate(sizeof(Destructor), alignof(Destructor)));
+            node->destroy = [](void* p) { static_cast<T*>(p)->~T(); };
+            node->object  = object;
+            node->next    = _destructors;
+            _destructors  = node;
+            return object;
+        }
+    }
+
+    /** Destroy the constructed objects and release all the allocations, the memory is kept for the next frame. */
+    void reset();
+
+    /** Get the counters since the last reset. */
+    const Stats& getStats() const { return _stats; }
+    /** Get the counters of the last frame, taken by the last reset. */
+    const Stats& getFrameStats() const { return _frameStats; }
+    /** Get the number of bytes of the allocated blocks. */
+    size_t getCapacity() const { return _capacity; }
+
+private:
+    struct Block
+    {
+        Block* next;
+        size_t size;
+    };
+
+    struct Destructor
+    {
+        void (*destroy)(void*);
+        void* object;
+        Destructor* next;
+    };
+
+    void* allocateFromNewBlock(size_t size, size_t alignment);
+    void releaseBlocks(Block* block);
+
+    size_t _blockSize;
+    /** The block allocations are made from, the previous blocks are chained by Block::next. */
+    Block* _block     = nullptr;
+    uint8_t* _current = nullptr;
+    uint8_t* _end     = nullptr;
+    size_t _capacity  = 0;
+
+    Destructor* _destructors = nullptr;
+
+    Stats _stats;
+    Stats _frameStats;
+};
+
+NS_AX_END
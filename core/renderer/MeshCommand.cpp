@@ -73,6 +73,12 @@ void MeshCommand::init(float globalZOrder, const Mat4& transform)
     _mv = transform;
 }
 
+void MeshCommand::setInstancingKey(uint64_t key, backend::ProgramState* programState)
+{
+    _instancingKey          = programState ? key : 0;
+    _instancingProgramState = programState;
+}
+
 MeshCommand::~MeshCommand()
 {
 #if AX_ENABLE_CACHE_TEXTURE_DATA
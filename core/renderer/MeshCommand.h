@@ -73,11 +73,25 @@ public:
 
     void init(float globalZOrder, const Mat4& transform);
 
+    /**
+    Marks the command as a candidate for automatic instancing, see `Renderer::setAutoInstancingEnabled`.
+    Opaque commands with the same key are drawn in one instanced draw call.
+    @param key Hash of everything the draw depends on except the model view matrix, 0 if the command can't be instanced.
+    @param programState Program state of an instancing variant of the program, reading the model view matrix
+    from the instance buffer. Must stay valid until the frame is rendered.
+    */
+    void setInstancingKey(uint64_t key, backend::ProgramState* programState);
+    uint64_t getInstancingKey() const { return _instancingKey; }
+    backend::ProgramState* getInstancingProgramState() const { return _instancingProgramState; }
+
 #if AX_ENABLE_CACHE_TEXTURE_DATA
     void listenRendererRecreated(EventCustom* event);
 #endif
 
 protected:
+    uint64_t _instancingKey                        = 0;
+    backend::ProgramState* _instancingProgramState = nullptr;
+
 #if AX_ENABLE_CACHE_TEXTURE_DATA
     EventListenerCustom* _rendererRecreatedListener;
 #endif
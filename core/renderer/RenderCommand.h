@@ -101,7 +101,16 @@ public:
 
     const Mat4& getMV() const { return _mv; }
 
+    /**
+     Get the packed sort key, which is updated when the command is queued into a `RenderQueue`.
+     The high 32 bits are the global Z order (or the reversed depth for transparent 3D commands) mapped to
+     an unsigned integer, the low 32 bits are the submission order, so keys are unique within a queue.
+     */
+    uint64_t getSortKey() const { return _sortKey; }
+
 protected:
+    friend class RenderQueue;
+
     /**Constructor.*/
     RenderCommand();
     /**Destructor.*/
@@ -135,6 +144,9 @@ protected:
 
     Mat4 _mv;
 
+    /** Packed sort key, see getSortKey. */
+    uint64_t _sortKey = 0;
+
     PipelineDescriptor _pipelineDescriptor;
 };
 
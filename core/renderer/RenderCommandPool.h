@@ -28,6 +28,7 @@
 /// @cond DO_NOT_SHOW
 
 #include <list>
+#include <vector>
 
 #include "platform/PlatformMacros.h"
 
@@ -60,8 +61,8 @@ public:
         {
             AllocateCommands();
         }
-        result = _freePool.front();
-        _freePool.pop_front();
+        result = _freePool.back();
+        _freePool.pop_back();
         //_usedPool.insert(result);
         return result;
     }
@@ -91,7 +92,8 @@ private:
     }
 
     std::list<T*> _allocatedPoolBlocks;
-    std::list<T*> _freePool;
+    // a vector doesn't allocate a node for each command pushed back every frame
+    std::vector<T*> _freePool;
     // std::set<T*> _usedPool;
 };
 
@@ -26,6 +26,7 @@
 #include "renderer/Renderer.h"
 
 #include <algorithm>
+#include <limits>
 
 #include "renderer/TrianglesCommand.h"
 #include "renderer/CustomCommand.h"
@@ -37,8 +38,12 @@
 #include "renderer/Pass.h"
 #include "renderer/Texture2D.h"
 
+#include "math/MathUtil.h"
+
 #include "base/Configuration.h"
 #include "base/Director.h"
+#include "base/JobSystem.h"
+#include "base/Trace.h"
 #include "base/EventDispatcher.h"
 #include "base/EventListenerCustom.h"
 #include "base/EventType.h"
@@ -52,14 +57,17 @@
 NS_AX_BEGIN
 
 // helper
-static bool compareRenderCommand(RenderCommand* a, RenderCommand* b)
+static bool compareSortKey(RenderCommand* a, RenderCommand* b)
 {
-    return a->getGlobalOrder() < b->getGlobalOrder();
+    return a->getSortKey() < b->getSortKey();
 }
 
-static bool compare3DCommand(RenderCommand* a, RenderCommand* b)
+// maps a float to an unsigned integer with the same order
+static uint32_t floatToSortKey(float value)
 {
-    return a->getDepth() > b->getDepth();
+    uint32_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    return (bits & 0x80000000u) ? ~bits : (bits | 0x80000000u);
 }
 
 // queue
@@ -67,14 +75,16 @@ RenderQueue::RenderQueue() {}
 
 void RenderQueue::emplace_back(RenderCommand* command)
 {
-    float z = command->getGlobalOrder();
+    float z     = command->getGlobalOrder();
+    auto group  = QUEUE_GROUP::GLOBALZ_ZERO;
+    uint32_t key = floatToSortKey(z);
     if (z < 0)
     {
-        _commands[QUEUE_GROUP::GLOBALZ_NEG].emplace_back(command);
+        group = QUEUE_GROUP::GLOBALZ_NEG;
     }
     else if (z > 0)
     {
-        _commands[QUEUE_GROUP::GLOBALZ_POS].emplace_back(command);
+        group = QUEUE_GROUP::GLOBALZ_POS;
     }
     else
     {
@@ -82,18 +92,20 @@ void RenderQueue::emplace_back(RenderCommand* command)
         {
             if (command->isTransparent())
             {
-                _commands[QUEUE_GROUP::TRANSPARENT_3D].emplace_back(command);
+                // back to front
+                group = QUEUE_GROUP::TRANSPARENT_3D;
+                key   = ~floatToSortKey(command->getDepth());
             }
             else
             {
-                _commands[QUEUE_GROUP::OPAQUE_3D].emplace_back(command);
+                group = QUEUE_GROUP::OPAQUE_3D;
             }
         }
-        else
-        {
-            _commands[QUEUE_GROUP::GLOBALZ_ZERO].emplace_back(command);
-        }
     }
+
+    auto& commands     = _commands[group];
+    command->_sortKey = (static_cast<uint64_t>(key) << 32) | static_cast<uint32_t>(commands.size());
+    commands.emplace_back(command);
 }
 
 ssize_t RenderQueue::size() const
@@ -110,12 +122,187 @@ ssize_t RenderQueue::size() const
 void RenderQueue::sort()
 {
     // Don't sort _queue0, it already comes sorted
-    std::stable_sort(std::begin(_commands[QUEUE_GROUP::TRANSPARENT_3D]),
-                     std::end(_commands[QUEUE_GROUP::TRANSPARENT_3D]), compare3DCommand);
-    std::stable_sort(std::begin(_commands[QUEUE_GROUP::GLOBALZ_NEG]), std::end(_commands[QUEUE_GROUP::GLOBALZ_NEG]),
-                     compareRenderCommand);
-    std::stable_sort(std::begin(_commands[QUEUE_GROUP::GLOBALZ_POS]), std::end(_commands[QUEUE_GROUP::GLOBALZ_POS]),
-                     compareRenderCommand);
+    sortSubQueue(_commands[QUEUE_GROUP::TRANSPARENT_3D]);
+    sortSubQueue(_commands[QUEUE_GROUP::GLOBALZ_NEG]);
+    sortSubQueue(_commands[QUEUE_GROUP::GLOBALZ_POS]);
+}
+
+void RenderQueue::sortSubQueue(std::vector<RenderCommand*>& commands)
+{
+    const size_t count = commands.size();
+    if (count < 2)
+        return;
+
+    // sort keys are unique, so the result is the same as a stable sort by global Z (or depth)
+    if (count < RADIX_SORT_THRESHOLD)
+    {
+        std::sort(commands.begin(), commands.end(), compareSortKey);
+        return;
+    }
+
+    // LSD radix sort on the high 32 bits of the sort keys, which keeps the submission order of equal keys
+    auto& src = _sortBuffers[0];
+    auto& dst = _sortBuffers[1];
+    src.resize(count);
+    dst.resize(count);
+
+    uint32_t histograms[4][256] = {};
+    for (size_t i = 0; i < count; ++i)
+    {
+        auto key = static_cast<uint32_t>(commands[i]->getSortKey() >> 32);
+        src[i]   = {key, commands[i]};
+        ++histograms[0][key & 0xff];
+        ++histograms[1][(key >> 8) & 0xff];
+        ++histograms[2][(key >> 16) & 0xff];
+        ++histograms[3][key >> 24];
+    }
+
+    bool sorted = false;
+    for (int pass = 0; pass < 4; ++pass)
+    {
+        auto& histogram  = histograms[pass];
+        const int shift  = pass * 8;
+
+        // skip the pass if all keys have the same digit, common for a few distinct global Z values
+        if (histogram[(src[0].key >> shift) & 0xff] == count)
+            continue;
+
+        uint32_t offset = 0;
+        for (auto& bucket : histogram)
+        {
+            auto n = bucket;
+            bucket = offset;
+            offset += n;
+        }
+
+        for (auto& item : src)
+            dst[histogram[(item.key >> shift) & 0xff]++] = item;
+
+        src.swap(dst);
+        sorted = true;
+    }
+
+    if (sorted)
+    {
+        for (size_t i = 0; i < count; ++i)
+            commands[i] = src[i].command;
+    }
+}
+
+static bool isReorderable(const RenderCommand* command)
+{
+    return command->getType() == RenderCommand::Type::TRIANGLES_COMMAND && !command->is3D();
+}
+
+void RenderQueue::reorderByMaterial(unsigned int window)
+{
+    for (auto group : {QUEUE_GROUP::GLOBALZ_NEG, QUEUE_GROUP::GLOBALZ_ZERO, QUEUE_GROUP::GLOBALZ_POS})
+    {
+        auto& commands     = _commands[group];
+        const size_t count = commands.size();
+        size_t begin       = 0;
+        while (begin < count)
+        {
+            if (!isReorderable(commands[begin]))
+            {
+                ++begin;
+                continue;
+            }
+
+            const float z     = commands[begin]->getGlobalOrder();
+            const auto material = static_cast<TrianglesCommand*>(commands[begin])->getMaterialID();
+            bool mixed        = false;
+            size_t end        = begin + 1;
+            for (; end < count && isReorderable(commands[end]) && commands[end]->getGlobalOrder() == z; ++end)
+                mixed |= static_cast<TrianglesCommand*>(commands[end])->getMaterialID() != material;
+
+            if (mixed && end - begin > 2)
+                reorderRun(commands.data() + begin, end - begin, window);
+            begin = end;
+        }
+    }
+}
+
+void RenderQueue::reorderRun(RenderCommand** commands, size_t count, unsigned int window)
+{
+    // bounding boxes in view space, commands which aren't flat in z or aren't batched stay in place
+    _reorderItems.resize(count);
+    float planeZ = 0;
+    for (size_t i = 0; i < count; ++i)
+    {
+        auto cmd   = static_cast<TrianglesCommand*>(commands[i]);
+        auto& item = _reorderItems[i];
+        item.command    = cmd;
+        item.materialID = cmd->getMaterialID();
+        item.movable    = !cmd->isSkipBatching() && cmd->getVertexCount() > 0;
+        if (!item.movable)
+            continue;
+
+        const float* m = cmd->getModelView().m;
+        auto verts     = cmd->getVertices();
+        item.minX = item.minY = std::numeric_limits<float>::max();
+        item.maxX = item.maxY = -std::numeric_limits<float>::max();
+        for (size_t v = 0, n = cmd->getVertexCount(); v < n && item.movable; ++v)
+        {
+            const auto& p = verts[v].vertices;
+            float x       = m[0] * p.x + m[4] * p.y + m[8] * p.z + m[12];
+            float y       = m[1] * p.x + m[5] * p.y + m[9] * p.z + m[13];
+            float z       = m[2] * p.x + m[6] * p.y + m[10] * p.z + m[14];
+            if (i == 0 && v == 0)
+                planeZ = z;
+            item.movable = z == planeZ;
+            item.minX    = std::min(item.minX, x);
+            item.minY    = std::min(item.minY, y);
+            item.maxX    = std::max(item.maxX, x);
+            item.maxY    = std::max(item.maxY, y);
+        }
+    }
+
+    auto overlaps = [](const ReorderItem* a, const ReorderItem* b) {
+        return !a->movable || !b->movable ||
+               (a->minX < b->maxX && b->minX < a->maxX && a->minY < b->maxY && b->minY < a->maxY);
+    };
+
+    // Emit the first pending command, then every command with its material found in the window
+    // which doesn't overlap any command it would jump over. Once a command of the material is held back,
+    // the following ones are too, so that commands sharing a material keep their order. The first pending
+    // command is always emitted, so each round makes progress.
+    size_t head   = 0;
+    size_t output = 0;
+    while (head < count)
+    {
+        const size_t windowEnd = std::min(count, head + window);
+        const auto material    = _reorderItems[head].materialID;
+        bool materialHeld      = false;
+        _reorderBlockers.clear();
+        for (size_t i = head; i < windowEnd; ++i)
+        {
+            auto& item = _reorderItems[i];
+            bool emit  = item.movable || i == head ? item.materialID == material && !materialHeld : false;
+            for (size_t b = 0; emit && b < _reorderBlockers.size(); ++b)
+                emit = !overlaps(&item, _reorderBlockers[b]);
+
+            if (emit)
+            {
+                commands[output++] = item.command;
+                item.command       = nullptr;
+            }
+            else
+            {
+                materialHeld |= item.materialID == material;
+                _reorderBlockers.emplace_back(&item);
+            }
+        }
+
+        // keep the remaining commands of the window in order, right before the rest of the run
+        size_t kept = windowEnd;
+        for (size_t i = windowEnd; i-- > head;)
+        {
+            if (_reorderItems[i].command)
+                _reorderItems[--kept] = _reorderItems[i];
+        }
+        head = kept;
+    }
 }
 
 RenderCommand* RenderQueue::operator[](ssize_t index) const
@@ -184,6 +371,14 @@ Renderer::~Renderer()
         delete clearCommand;
     _groupCommandPool.clear();
 
+    for (auto&& batch : _instancedMeshBatches)
+    {
+        delete batch->command;
+        AX_SAFE_RELEASE(batch->instanceBuffer);
+        delete batch;
+    }
+    _instancedMeshBatches.clear();
+
     _groupCommandManager->release();
 
     free(_triBatchesToDraw);
@@ -228,6 +423,15 @@ void Renderer::addCallbackCommand(std::function<void()> func, float globalZOrder
     addCommand(cmd);
 }
 
+void Renderer::addCallbackCommand(void (*invoke)(void*), void* callable, float globalZOrder)
+{
+    auto cmd = nextCallbackCommand();
+    cmd->init(globalZOrder);
+    cmd->_invoke   = invoke;
+    cmd->_callable = callable;
+    addCommand(cmd);
+}
+
 void Renderer::addCommand(RenderCommand* command)
 {
     int renderQueueID = _commandGroupStack.top();
@@ -403,6 +607,8 @@ void Renderer::doVisitRenderQueue(const std::vector<RenderCommand*>& renderComma
 
 void Renderer::render()
 {
+    AX_TRACE_SCOPE("Renderer::render");
+
     // TODO: setup camera or MVP
     _isRendering = true;
     //    if (_glViewAssigned)
@@ -412,6 +618,10 @@ void Renderer::render()
         for (auto&& renderqueue : _renderGroups)
         {
             renderqueue.sort();
+            if (_batchReorderEnabled)
+                renderqueue.reorderByMaterial();
+            if (_autoInstancingEnabled)
+                instanceMeshCommands(renderqueue.getSubQueue(RenderQueue::QUEUE_GROUP::OPAQUE_3D));
         }
         visitRenderQueue(_renderGroups[0]);
     }
@@ -435,6 +645,12 @@ void Renderer::endFrame()
 #endif
     _queuedTotalIndexCount  = 0;
     _queuedTotalVertexCount = 0;
+
+    // the instance buffers are rewritten when reused, so that each render pass of the frame has its own ones
+    _usedInstancedMeshBatches = 0;
+
+    // the callback commands of all the render passes are executed, release their callables
+    _frameAllocator.reset();
 }
 
 void Renderer::clean()
@@ -589,26 +805,76 @@ void Renderer::setViewPort(int x, int y, unsigned int w, unsigned int h)
 
 void Renderer::fillVerticesAndIndices(const TrianglesCommand* cmd, unsigned int vertexBufferOffset)
 {
+    // fill vertex, and convert them to world coordinates
     size_t vertexCount = cmd->getVertexCount();
-    memcpy(&_verts[_filledVertex], cmd->getVertices(), sizeof(V3F_C4B_T2F) * vertexCount);
+    MathUtil::transformVertices(&_verts[_filledVertex], cmd->getVertices(), vertexCount, cmd->getModelView());
 
-    // fill vertex, and convert them to world coordinates
-    const Mat4& modelView = cmd->getModelView();
-    for (size_t i = 0; i < vertexCount; ++i)
+    // fill index
+    size_t indexCount = cmd->getIndexCount();
+    MathUtil::transformIndices(&_indices[_filledIndex], cmd->getIndices(), indexCount,
+                               static_cast<uint16_t>(vertexBufferOffset + _filledVertex));
+
+    _filledVertex += vertexCount;
+    _filledIndex += indexCount;
+}
+
+void Renderer::fillVerticesAndIndicesParallel(unsigned int vertexBufferOffset)
+{
+    // compute the fill offsets of every command up front, so ranges can be filled independently
+    const size_t count = _queuedTriangleCommands.size();
+    _queuedFillOffsets.resize(count + 1);
+    unsigned int vertexCount = 0, indexCount = 0;
+    for (size_t i = 0; i < count; ++i)
     {
-        modelView.transformPoint(&(_verts[i + _filledVertex].vertices));
+        _queuedFillOffsets[i].vertex = vertexCount;
+        _queuedFillOffsets[i].index  = indexCount;
+        vertexCount += static_cast<unsigned int>(_queuedTriangleCommands[i]->getVertexCount());
+        indexCount += static_cast<unsigned int>(_queuedTriangleCommands[i]->getIndexCount());
     }
+    _queuedFillOffsets[count].vertex = vertexCount;
+    _queuedFillOffsets[count].index  = indexCount;
 
-    // fill index
-    const unsigned short* indices = cmd->getIndices();
-    size_t indexCount             = cmd->getIndexCount();
-    for (size_t i = 0; i < indexCount; ++i)
+    // not worth dispatching small batches
+    if (count < 2 || vertexCount < PARALLEL_FILL_MIN_VERTICES * 2)
     {
-        _indices[_filledIndex + i] = vertexBufferOffset + _filledVertex + indices[i];
+        for (auto cmd : _queuedTriangleCommands)
+            fillVerticesAndIndices(cmd, vertexBufferOffset);
+        return;
     }
 
-    _filledVertex += vertexCount;
-    _filledIndex += indexCount;
+    // split the commands into contiguous ranges with roughly the same number of vertices,
+    // range i is [ranges[i], ranges[i + 1])
+    auto jobSystem         = Director::getInstance()->getJobSystem();
+    const size_t parallels = std::clamp<size_t>(jobSystem->getWorkerCount() + 1, 1,
+                                                vertexCount / PARALLEL_FILL_MIN_VERTICES);
+    auto& ranges = _queuedFillRanges;
+    ranges.clear();
+    ranges.reserve(parallels + 1);
+    ranges.emplace_back(0);
+    for (size_t i = 1; i < count && ranges.size() < parallels; ++i)
+    {
+        if (_queuedFillOffsets[i].vertex >= vertexCount / parallels * ranges.size())
+            ranges.emplace_back(i);
+    }
+    ranges.emplace_back(count);
+    const size_t numRanges = ranges.size() - 1;
+
+    auto commands = _queuedTriangleCommands.data();
+    auto offsets  = _queuedFillOffsets.data();
+    jobSystem->parallel_for(0, numRanges, 1, [&](size_t firstRange, size_t lastRange) {
+        for (size_t i = ranges[firstRange], last = ranges[lastRange]; i < last; ++i)
+        {
+            auto cmd     = commands[i];
+            auto& offset = offsets[i];
+            MathUtil::transformVertices(&_verts[offset.vertex], cmd->getVertices(), cmd->getVertexCount(),
+                                        cmd->getModelView());
+            MathUtil::transformIndices(&_indices[offset.index], cmd->getIndices(), cmd->getIndexCount(),
+                                       static_cast<uint16_t>(vertexBufferOffset + offset.vertex));
+        }
+    });
+
+    _filledVertex = vertexCount;
+    _filledIndex  = indexCount;
 }
 
 void Renderer::drawBatchedTriangles()
@@ -636,12 +902,16 @@ void Renderer::drawBatchedTriangles()
     _filledVertex = 0;
     _filledIndex  = 0;
 
+    if (_parallelFillEnabled)
+        fillVerticesAndIndicesParallel(vertexBufferFillOffset);
+
     for (const auto& cmd : _queuedTriangleCommands)
     {
         auto currentMaterialID = cmd->getMaterialID();
         const bool batchable   = !cmd->isSkipBatching();
 
-        fillVerticesAndIndices(cmd, vertexBufferFillOffset);
+        if (!_parallelFillEnabled)
+            fillVerticesAndIndices(cmd, vertexBufferFillOffset);
 
         // in the same batch ?
         if (batchable && (prevMaterialID == currentMaterialID || firstCommand))
@@ -768,6 +1038,96 @@ void Renderer::drawMeshCommand(RenderCommand* command)
     drawCustomCommand(command);
 }
 
+void Renderer::instanceMeshCommands(std::vector<RenderCommand*>& commands)
+{
+    _instancingItems.clear();
+    for (size_t i = 0, count = commands.size(); i < count; ++i)
+    {
+        if (commands[i]->getType() != RenderCommand::Type::MESH_COMMAND)
+            continue;
+        auto cmd = static_cast<MeshCommand*>(commands[i]);
+        if (cmd->getInstancingKey() != 0 && cmd->getDrawType() == CustomCommand::DrawType::ELEMENT)
+            _instancingItems.push_back({cmd->getInstancingKey(), static_cast<uint32_t>(i)});
+    }
+    if (_instancingItems.size() < 2)
+        return;
+
+    // group equal keys, a group is drawn where its first command was queued
+    std::sort(_instancingItems.begin(), _instancingItems.end(), [](const InstancingItem& a, const InstancingItem& b) {
+        return a.key < b.key || (a.key == b.key && a.index < b.index);
+    });
+
+    bool merged       = false;
+    const size_t size = _instancingItems.size();
+    for (size_t begin = 0, end = 0; begin < size; begin = end)
+    {
+        const auto key = _instancingItems[begin].key;
+        for (end = begin + 1; end < size && _instancingItems[end].key == key; ++end)
+            ;
+        const size_t instanceCount = end - begin;
+        if (instanceCount < 2)
+            continue;
+
+        _instanceTransforms.resize(instanceCount);
+        for (size_t i = 0; i < instanceCount; ++i)
+        {
+            auto& slot             = commands[_instancingItems[begin + i].index];
+            _instanceTransforms[i] = slot->getMV();
+            if (i > 0)
+                slot = nullptr;
+        }
+
+        if (_usedInstancedMeshBatches == _instancedMeshBatches.size())
+        {
+            auto batch     = new InstancedMeshBatch();
+            batch->command = new MeshCommand();
+            batch->command->setDrawType(CustomCommand::DrawType::ELEMENT_INSTANCE);
+            batch->command->setBeforeCallback([batch]() {
+                batch->first->getBeforeCallback()();
+                // the merged command's pass has applied its render state, the transforms come from the instances
+                auto command      = batch->command;
+                auto programState = command->getPipelineDescriptor().programState;
+                auto& matrixP     = Director::getInstance()->getMatrix(MATRIX_STACK_TYPE::MATRIX_STACK_PROJECTION);
+                command->getPipelineDescriptor().blendDescriptor = batch->first->getPipelineDescriptor().blendDescriptor;
+                programState->setUniform(programState->getUniformLocation(backend::UNIFORM_NAME_MVP_MATRIX), matrixP.m,
+                                         sizeof(matrixP.m));
+            });
+            batch->command->setAfterCallback([batch]() { batch->first->getAfterCallback()(); });
+            _instancedMeshBatches.push_back(batch);
+        }
+        auto batch = _instancedMeshBatches[_usedInstancedMeshBatches++];
+
+        if (batch->capacity < instanceCount)
+        {
+            AX_SAFE_RELEASE(batch->instanceBuffer);
+            batch->capacity       = (std::max)(instanceCount, batch->capacity * 2);
+            batch->instanceBuffer = backend::DriverBase::getInstance()->newBuffer(
+                batch->capacity * sizeof(Mat4), backend::BufferType::VERTEX, backend::BufferUsage::DYNAMIC);
+        }
+        batch->instanceBuffer->updateSubData(_instanceTransforms.data(), 0, instanceCount * sizeof(Mat4));
+
+        auto first   = static_cast<MeshCommand*>(commands[_instancingItems[begin].index]);
+        auto command = batch->command;
+        batch->first = first;
+        command->init(first->getGlobalOrder());
+        command->set3D(true);
+        command->setTransparent(false);
+        command->setWireframe(first->isWireframe());
+        command->setPrimitiveType(first->getPrimitiveType());
+        command->setVertexBuffer(first->getVertexBuffer());
+        command->setIndexBuffer(first->getIndexBuffer(), first->getIndexFormat());
+        const size_t indexSize = first->getIndexFormat() == backend::IndexFormat::U_SHORT ? 2 : 4;
+        command->setIndexDrawInfo(first->getIndexDrawOffset() / indexSize, first->getIndexDrawCount());
+        command->setInstanceBuffer(batch->instanceBuffer, static_cast<int>(instanceCount));
+        command->getPipelineDescriptor().programState = first->getInstancingProgramState();
+        commands[_instancingItems[begin].index]       = command;
+        merged                                        = true;
+    }
+
+    if (merged)
+        commands.erase(std::remove(commands.begin(), commands.end(), nullptr), commands.end());
+}
+
 void Renderer::flush()
 {
     flush2D();
@@ -825,6 +1185,33 @@ bool Renderer::checkVisibility(const Mat4& transform, const Vec2& size)
     return ret;
 }
 
+bool Renderer::checkVisibility(const Mat4& transform, const Rect& bounds)
+{
+    auto director = Director::getInstance();
+    auto scene    = director->getRunningScene();
+
+    //  only cull the default camera. The culling algorithm is valid for default camera.
+    if (!scene || scene->_defaultCamera != Camera::getVisitingCamera())
+        return true;
+
+    // project the corners to screen space
+    auto camera = Camera::getVisitingCamera();
+    Vec2 minPoint(FLT_MAX, FLT_MAX), maxPoint(-FLT_MAX, -FLT_MAX);
+    const Vec3 corners[] = {Vec3(bounds.getMinX(), bounds.getMinY(), 0), Vec3(bounds.getMaxX(), bounds.getMinY(), 0),
+                            Vec3(bounds.getMinX(), bounds.getMaxY(), 0), Vec3(bounds.getMaxX(), bounds.getMaxY(), 0)};
+    for (auto corner : corners)
+    {
+        transform.transformPoint(&corner);
+        Vec2 point = camera->projectGL(corner);
+        minPoint.set(std::min(minPoint.x, point.x), std::min(minPoint.y, point.y));
+        maxPoint.set(std::max(maxPoint.x, point.x), std::max(maxPoint.y, point.y));
+    }
+
+    Rect visibleRect(director->getVisibleOrigin(), director->getVisibleSize());
+    return maxPoint.x >= visibleRect.getMinX() && minPoint.x <= visibleRect.getMaxX() &&
+           maxPoint.y >= visibleRect.getMinY() && minPoint.y <= visibleRect.getMaxY();
+}
+
 void Renderer::readPixels(backend::RenderTarget* rt,
                           std::function<void(const backend::PixelBufferDescriptor&)> callback)
 {
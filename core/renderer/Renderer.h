@@ -33,6 +33,7 @@
 
 #include "platform/PlatformMacros.h"
 #include "renderer/RenderCommand.h"
+#include "renderer/FrameAllocator.h"
 #include "renderer/backend/Types.h"
 #include "renderer/backend/ProgramManager.h"
 
@@ -70,9 +71,14 @@ class Texture2D;
  the correct order, the only `RenderCommand` objects that need to be sorted,
  are the ones that have `z < 0` and `z > 0`.
 */
-class RenderQueue
+class AX_DLL RenderQueue
 {
 public:
+    /**Sub queues with at least this number of commands are sorted with a radix sort.*/
+    static const int RADIX_SORT_THRESHOLD = 512;
+    /**How many pending commands reorderByMaterial looks ahead for a command with the current material.*/
+    static const int REORDER_WINDOW = 32;
+
     /**
     RenderCommand will be divided into Queue Groups.
     */
@@ -100,6 +106,14 @@ public:
     ssize_t size() const;
     /**Sort the render commands.*/
     void sort();
+    /**
+     Group the sorted triangles commands by material ID, so that more of them are batched together.
+     Only runs of 2D triangles commands sharing the same global Z are reordered, and a command is only moved
+     ahead of commands its bounding box doesn't overlap, so the rendered result is unchanged. Commands sharing a
+     material keep their order.
+     @param window How many pending commands are searched for the current material.
+     */
+    void reorderByMaterial(unsigned int window = REORDER_WINDOW);
     /**Treat sorted commands as an array, access them one by one.*/
     RenderCommand* operator[](ssize_t index) const;
     /**Clear all rendered commands.*/
@@ -112,9 +126,35 @@ public:
     ssize_t getSubQueueSize(QUEUE_GROUP group) const { return _commands[group].size(); }
 
 protected:
+    /**Sort a sub queue by the commands sort key.*/
+    void sortSubQueue(std::vector<RenderCommand*>& commands);
+
     /**The commands in the render queue.*/
     std::vector<RenderCommand*> _commands[QUEUE_COUNT];
 
+    /**Scratch buffers of the radix sort.*/
+    struct SortItem
+    {
+        uint32_t key;
+        RenderCommand* command;
+    };
+    std::vector<SortItem> _sortBuffers[2];
+
+    /**Reorder a run of triangles commands sharing the same global Z.*/
+    void reorderRun(RenderCommand** commands, size_t count, unsigned int window);
+
+    /**Scratch buffers of reorderByMaterial.*/
+    struct ReorderItem
+    {
+        RenderCommand* command;
+        uint32_t materialID;
+        /**Whether the command may be moved, if not it overlaps everything.*/
+        bool movable;
+        float minX, minY, maxX, maxY;
+    };
+    std::vector<ReorderItem> _reorderItems;
+    std::vector<const ReorderItem*> _reorderBlockers;
+
     /**Cull state.*/
     bool _isCullEnabled;
     /**Depth test enable state.*/
@@ -140,6 +180,8 @@ public:
     static const int BATCH_TRIAGCOMMAND_RESERVED_SIZE = 64;
     /**Reserved for material id, which means that the command could not be batched.*/
     static const int MATERIAL_ID_DO_NOT_BATCH = 0;
+    /**The min number of vertices filled by each job when parallel fill is enabled.*/
+    static const int PARALLEL_FILL_MIN_VERTICES = 4096;
     /**Constructor.*/
     Renderer();
     /**Destructor.*/
@@ -150,6 +192,21 @@ public:
 
     void addCallbackCommand(std::function<void()> func, float globalZOrder = 0.0f);
 
+    /**
+     * Adds a callback command, the callable is stored in the frame allocator instead of a `std::function`,
+     * so no heap allocation is made once the frame allocator is warmed up.
+     */
+    template <typename F>
+    void addCallbackCommand(F&& func, float globalZOrder = 0.0f)
+    {
+        using Callable = std::decay_t<F>;
+        auto callable  = _frameAllocator.construct<Callable>(std::forward<F>(func));
+        addCallbackCommand([](void* p) { (*static_cast<Callable*>(p))(); }, callable, globalZOrder);
+    }
+
+    /** Get the allocator for memory which lives until the end of the frame, it is reset by `endFrame()`. */
+    FrameAllocator& getFrameAllocator() { return _frameAllocator; }
+
     /** Adds a `RenderComamnd` into the renderer */
     void addCommand(RenderCommand* command);
 
@@ -182,8 +239,42 @@ public:
     ssize_t getDrawnVertices() const { return _drawnVertices; }
     /* RenderCommands (except) TrianglesCommand should update this value */
     void addDrawnVertices(ssize_t number) { _drawnVertices += number; };
+    /* returns the number of visited nodes in the last frame */
+    size_t getVisitedNodes() const { return _visitedNodes; }
+    void addVisitedNodes(size_t number) { _visitedNodes += number; }
+    /* returns the number of nodes skipped by subtree culling in the last frame, see Node::setSubtreeCullingEnabled */
+    size_t getCulledNodes() const { return _culledNodes; }
+    void addCulledNodes(size_t number) { _culledNodes += number; }
     /* clear draw stats */
-    void clearDrawStats() { _drawnBatches = _drawnVertices = 0; }
+    void clearDrawStats() { _drawnBatches = _drawnVertices = _visitedNodes = _culledNodes = 0; }
+
+    /**
+     * Enable/disable filling the vertices and indices of queued `TrianglesCommand`s on JobSystem workers.
+     * Large batches are split into contiguous ranges of commands, batching is still done in submission order.
+     * @param enabled true to fill in parallel, false to fill on the render thread only (default).
+     */
+    void setParallelFillEnabled(bool enabled) { _parallelFillEnabled = enabled; }
+    /** Whether triangles are filled on JobSystem workers. */
+    bool isParallelFillEnabled() const { return _parallelFillEnabled; }
+
+    /**
+     * Enable/disable grouping the queued `TrianglesCommand`s by material before batching, see `RenderQueue::reorderByMaterial`.
+     * Useful when sprites from several atlases are interleaved at the same global Z, compare `getDrawnBatches()`.
+     * @param enabled true to reorder, false to draw in submission order (default).
+     */
+    void setBatchReorderEnabled(bool enabled) { _batchReorderEnabled = enabled; }
+    /** Whether queued commands are grouped by material before batching. */
+    bool isBatchReorderEnabled() const { return _batchReorderEnabled; }
+
+    /**
+     * Enable/disable drawing opaque `MeshCommand`s which only differ by their transform in one instanced draw call.
+     * Only meshes whose material has an instancing variant (the built-in unlit material) take part,
+     * see `MeshCommand::setInstancingKey`. Compare `getDrawnBatches()`.
+     * @param enabled true to merge identical meshes, false to draw every mesh on its own (default).
+     */
+    void setAutoInstancingEnabled(bool enabled) { _autoInstancingEnabled = enabled; }
+    /** Whether identical opaque meshes are merged into instanced draw calls. */
+    bool isAutoInstancingEnabled() const { return _autoInstancingEnabled; }
 
     /**
      Set render targets. If not set, will use default render targets. It will effect all commands.
@@ -410,6 +501,8 @@ public:
 
     /** returns whether or not a rectangle is visible or not */
     bool checkVisibility(const Mat4& transform, const Vec2& size);
+    /** Whether the bounds, in the coordinates of the transform, overlap the visible rect of the default camera. */
+    bool checkVisibility(const Mat4& transform, const Rect& bounds);
 
     /** read pixels from RenderTarget or screen framebuffer */
     void readPixels(backend::RenderTarget* rt, std::function<void(const backend::PixelBufferDescriptor&)> callback);
@@ -420,6 +513,8 @@ public:
     CallbackCommand* nextCallbackCommand();
 
 protected:
+    void addCallbackCommand(void (*invoke)(void*), void* callable, float globalZOrder);
+
     friend class Director;
     friend class GroupCommand;
 
@@ -484,7 +579,10 @@ protected:
     void visitRenderQueue(RenderQueue& queue);
     void doVisitRenderQueue(const std::vector<RenderCommand*>&);
 
+    void instanceMeshCommands(std::vector<RenderCommand*>& commands);
+
     void fillVerticesAndIndices(const TrianglesCommand* cmd, unsigned int vertexBufferOffset);
+    void fillVerticesAndIndicesParallel(unsigned int vertexBufferOffset);
 
     void pushStateBlock();
 
@@ -507,6 +605,8 @@ protected:
 
     std::vector<GroupCommand*> _groupCommandPool;
 
+    FrameAllocator _frameAllocator;
+
     // for TrianglesCommand
     V3F_C4B_T2F _verts[VBO_SIZE];
     unsigned short _indices[INDEX_VBO_SIZE];
@@ -539,9 +639,41 @@ protected:
     unsigned int _filledIndex            = 0;
     unsigned int _filledVertex           = 0;
 
+    // the offsets of each queued TrianglesCommand in _verts/_indices, for parallel fill
+    struct FillOffset
+    {
+        unsigned int vertex = 0;
+        unsigned int index  = 0;
+    };
+    std::vector<FillOffset> _queuedFillOffsets;
+    std::vector<size_t> _queuedFillRanges;
+    bool _parallelFillEnabled = false;
+    bool _batchReorderEnabled = false;
+
+    // for automatic instancing of MeshCommands
+    struct InstancedMeshBatch
+    {
+        MeshCommand* command            = nullptr;  // the instanced draw, owned by the batch
+        MeshCommand* first              = nullptr;  // the merged command providing callbacks and render state
+        backend::Buffer* instanceBuffer = nullptr;
+        std::size_t capacity            = 0;  // in instances
+    };
+    struct InstancingItem
+    {
+        uint64_t key;
+        uint32_t index;
+    };
+    std::vector<InstancedMeshBatch*> _instancedMeshBatches;
+    size_t _usedInstancedMeshBatches = 0;  // reset by endFrame, each render pass of a frame gets its own batches
+    std::vector<InstancingItem> _instancingItems;
+    std::vector<Mat4> _instanceTransforms;
+    bool _autoInstancingEnabled = false;
+
     // stats
     size_t _drawnBatches  = 0;
     size_t _drawnVertices = 0;
+    size_t _visitedNodes  = 0;
+    size_t _culledNodes   = 0;
     // the flag for checking whether renderer is rendering
     bool _isRendering      = false;
     bool _isDepthTestFor2D = false;
@@ -187,36 +187,8 @@ bool Texture2D::initWithMipmaps(MipmapInfo* mipmaps,
     return true;
 }
 
-bool Texture2D::updateWithImage(Image* image, backend::PixelFormat format, int index)
+backend::PixelFormat Texture2D::getSupportedRenderFormat(backend::PixelFormat renderFormat)
 {
-    if (image == nullptr)
-    {
-        __AXLOGWITHFUNCTION("axmol: Texture2D. Can't create Texture. UIImage is nil");
-        return false;
-    }
-
-    if (this->_filePath.empty())
-        this->_filePath = image->getFilePath();
-
-    int imageWidth  = image->getWidth();
-    int imageHeight = image->getHeight();
-
-    Configuration* conf = Configuration::getInstance();
-
-    int maxTextureSize = conf->getMaxTextureSize();
-    if (imageWidth > maxTextureSize || imageHeight > maxTextureSize)
-    {
-        AXLOGW("axmol: WARNING: Image ({} x {}) is bigger than the supported {} x {}", imageWidth, imageHeight,
-              maxTextureSize, maxTextureSize);
-        return false;
-    }
-
-    unsigned char* tempData               = image->getData();
-    // Vec2 imageSize                        = Vec2((float)imageWidth, (float)imageHeight);
-    backend::PixelFormat renderFormat     = (PixelFormat::NONE == format) ? image->getPixelFormat() : format;
-    backend::PixelFormat imagePixelFormat = image->getPixelFormat();
-    size_t tempDataLen                    = image->getDataLen();
-
 #ifdef AX_USE_METAL
     //! override renderFormat, since some render format is not supported by metal
     switch (renderFormat)
@@ -248,6 +220,41 @@ bool Texture2D::updateWithImage(Image* image, backend::PixelFormat format, int i
     }
 #endif
 
+    return renderFormat;
+}
+
+bool Texture2D::updateWithImage(Image* image, backend::PixelFormat format, int index)
+{
+    if (image == nullptr)
+    {
+        __AXLOGWITHFUNCTION("axmol: Texture2D. Can't create Texture. UIImage is nil");
+        return false;
+    }
+
+    if (this->_filePath.empty())
+        this->_filePath = image->getFilePath();
+
+    int imageWidth  = image->getWidth();
+    int imageHeight = image->getHeight();
+
+    Configuration* conf = Configuration::getInstance();
+
+    int maxTextureSize = conf->getMaxTextureSize();
+    if (imageWidth > maxTextureSize || imageHeight > maxTextureSize)
+    {
+        AXLOGW("axmol: WARNING: Image ({} x {}) is bigger than the supported {} x {}", imageWidth, imageHeight,
+              maxTextureSize, maxTextureSize);
+        return false;
+    }
+
+    unsigned char* tempData               = image->getData();
+    // Vec2 imageSize                        = Vec2((float)imageWidth, (float)imageHeight);
+    backend::PixelFormat renderFormat     = (PixelFormat::NONE == format) ? image->getPixelFormat() : format;
+    backend::PixelFormat imagePixelFormat = image->getPixelFormat();
+    size_t tempDataLen                    = image->getDataLen();
+
+    renderFormat = getSupportedRenderFormat(renderFormat);
+
     if (image->getNumberOfMipmaps() > 1)
     {
         if (renderFormat != image->getPixelFormat())
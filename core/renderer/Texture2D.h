@@ -120,6 +120,11 @@ public:
      */
     static backend::PixelFormat getDefaultAlphaPixelFormat();
 
+    /** Returns the format uncompressed image data is converted to when uploaded with the given render format,
+     * which differs when the render format isn't supported by the current backend.
+     */
+    static backend::PixelFormat getSupportedRenderFormat(backend::PixelFormat renderFormat);
+
 public:
     /**
      * @js ctor
@@ -33,16 +33,27 @@ THE SOFTWARE.
 #include <stack>
 #include <cctype>
 #include <list>
+#include <chrono>
 
 #include "renderer/Texture2D.h"
 #include "base/Macros.h"
 #include "base/UTF8.h"
 #include "base/Director.h"
 #include "base/Scheduler.h"
+#include "base/Trace.h"
+#include "base/JobSystem.h"
 #include "platform/FileUtils.h"
 #include "base/Utils.h"
 #include "base/NinePatchImageParser.h"
 #include "renderer/backend/DriverBase.h"
+#include "renderer/backend/PixelFormatUtils.h"
+#include "base/filesystem.h"
+#include "mio/mio.hpp"
+#include "xxhash.h"
+
+#if defined(_WIN32)
+#    include "ntcvt/ntcvt.hpp"
+#endif
 
 using namespace std;
 
@@ -62,6 +73,56 @@ std::string TextureCache::getETC1AlphaFileSuffix()
     return s_etc1AlphaFileSuffix;
 }
 
+// the layout of the files of the disk cache, followed by the pixels
+struct DiskCacheHeader
+{
+    char magic[4];
+    uint32_t version;
+    uint64_t sourceSize;
+    int64_t sourceTime;
+    uint64_t sourceHash;
+    uint32_t width;
+    uint32_t height;
+    uint32_t pixelFormat;
+    uint32_t premultipliedAlpha;
+    uint64_t dataLen;
+};
+
+static const char DISK_CACHE_MAGIC[4]      = {'A', 'X', 'T', 'C'};
+static const uint32_t DISK_CACHE_VERSION = 1;
+
+// fills the source fields of the header, the content is only hashed when the file has no modification time,
+// e.g. the assets packed in an apk
+static void getDiskCacheSource(std::string_view fullpath, DiskCacheHeader& header)
+{
+    auto fileUtils    = FileUtils::getInstance();
+    header.sourceSize = static_cast<uint64_t>(fileUtils->getFileSize(fullpath));
+    header.sourceTime = 0;
+    header.sourceHash = 0;
+
+    std::error_code ec;
+#if defined(_WIN32)
+    auto time = stdfs::last_write_time(stdfs::path{ntcvt::from_chars(fullpath)}, ec);
+#else
+    auto time = stdfs::last_write_time(stdfs::path{fullpath}, ec);
+#endif
+    if (!ec)
+    {
+        header.sourceTime = static_cast<int64_t>(time.time_since_epoch().count());
+    }
+    else
+    {
+        auto data         = fileUtils->getDataFromFile(fullpath);
+        header.sourceHash = XXH64(data.getBytes(), data.getSize(), 0);
+    }
+}
+
+static bool isUploadBudgetExceeded(float budget, std::chrono::steady_clock::time_point start)
+{
+    return budget > 0 &&
+           std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count() >= budget;
+}
+
 TextureCache::TextureCache() : _loadingThread(nullptr), _needQuit(false), _asyncRefCount(0) {}
 
 TextureCache::~TextureCache()
@@ -223,6 +284,138 @@ void TextureCache::addImageAsync(std::string_view path,
     _sleepCondition.notify_one();
 }
 
+/**
+ The preloadImagesAsync logic follow the steps:
+ - add an AsyncStruct to _preloadQueue for each image not cached yet (GL thread)
+ - dispatchPreloads hands queued requests to the background workers of the JobSystem, as long as the decoded
+ images waiting for upload stay below _maxPreloadDecodedBytes (GL thread)
+ - a worker decodes the image and adds the AsyncStruct to _preloadResponses (worker thread)
+ - on schedule callback, convert the decoded images to textures within the upload budget, then dispatch more
+ requests (GL thread)
+ */
+void TextureCache::preloadImagesAsync(const std::vector<std::string>& paths,
+                                      const std::function<void(Texture2D*, size_t, size_t)>& progress)
+{
+    struct Batch
+    {
+        size_t loaded = 0;
+        size_t total  = 0;
+        std::function<void(Texture2D*, size_t, size_t)> progress;
+    };
+    auto batch      = std::make_shared<Batch>();
+    batch->total    = paths.size();
+    batch->progress = progress;
+
+    auto notify = [batch](Texture2D* texture) {
+        ++batch->loaded;
+        if (batch->progress)
+            batch->progress(texture, batch->loaded, batch->total);
+    };
+
+    auto fileUtils = FileUtils::getInstance();
+    for (auto&& path : paths)
+    {
+        std::string fullpath = fileUtils->fullPathForFilename(path);
+
+        auto it = _textures.find(fullpath);
+        if (it != _textures.end())
+        {
+            notify(it->second);
+            continue;
+        }
+
+        if (fullpath.empty() || !fileUtils->isFileExist(fullpath))
+        {
+            notify(nullptr);
+            continue;
+        }
+
+        _preloadQueue.emplace_back(new AsyncStruct(fullpath, notify, fullpath));
+    }
+
+    if (_preloadQueue.empty())
+        return;
+
+    if (!_preloadScheduled)
+    {
+        _preloadScheduled = true;
+        Director::getInstance()->getScheduler()->schedule(AX_SCHEDULE_SELECTOR(TextureCache::preloadImagesCallBack),
+                                                          this, 0, false);
+    }
+
+    dispatchPreloads();
+}
+
+void TextureCache::dispatchPreloads()
+{
+    auto jobSystem     = Director::getInstance()->getJobSystem();
+    const int decoders = (std::max)(jobSystem->getWorkerCount(), 1);
+
+    while (!_preloadQueue.empty())
+    {
+        {
+            std::lock_guard<std::mutex> lck(_preloadMutex);
+            if (_preloadDecoding >= decoders || _preloadDecodedBytes >= _maxPreloadDecodedBytes)
+                break;
+            ++_preloadDecoding;
+        }
+
+        auto asyncStruct = _preloadQueue.front();
+        _preloadQueue.pop_front();
+
+        // not locked, the job runs inline when the job system has no workers
+        jobSystem->enqueue([this, asyncStruct] {
+            decodeAsyncStruct(asyncStruct);
+
+            std::lock_guard<std::mutex> lck(_preloadMutex);
+            _preloadDecodedBytes += asyncStruct->image.getDataLen() + asyncStruct->imageAlpha.getDataLen();
+            _preloadResponses.emplace_back(asyncStruct);
+            --_preloadDecoding;
+            _preloadCondition.notify_all();
+        });
+    }
+}
+
+void TextureCache::preloadImagesCallBack(float /*dt*/)
+{
+    AX_TRACE_SCOPE("TextureCache::preloadImagesCallBack");
+
+    const auto start = std::chrono::steady_clock::now();
+    while (true)
+    {
+        AsyncStruct* asyncStruct = nullptr;
+        {
+            std::lock_guard<std::mutex> lck(_preloadMutex);
+            if (!_preloadResponses.empty())
+            {
+                asyncStruct = _preloadResponses.front();
+                _preloadResponses.pop_front();
+                _preloadDecodedBytes -= asyncStruct->image.getDataLen() + asyncStruct->imageAlpha.getDataLen();
+            }
+        }
+
+        if (nullptr == asyncStruct)
+            break;
+
+        auto texture = uploadAsyncStruct(asyncStruct);
+        asyncStruct->callback(texture);
+        delete asyncStruct;
+
+        if (isUploadBudgetExceeded(_asyncUploadBudget, start))
+            break;
+    }
+
+    dispatchPreloads();
+
+    std::lock_guard<std::mutex> lck(_preloadMutex);
+    if (_preloadQueue.empty() && _preloadResponses.empty() && 0 == _preloadDecoding)
+    {
+        _preloadScheduled = false;
+        Director::getInstance()->getScheduler()->unschedule(AX_SCHEDULE_SELECTOR(TextureCache::preloadImagesCallBack),
+                                                            this);
+    }
+}
+
 void TextureCache::unbindImageAsync(std::string_view callbackKey)
 {
     if (_asyncStructQueue.empty())
@@ -253,6 +446,8 @@ void TextureCache::unbindAllImageAsync()
 
 void TextureCache::loadImage()
 {
+    TraceRecorder::setThreadName("axmol-texture-loader");
+
     AsyncStruct* asyncStruct = nullptr;
     while (!_needQuit)
     {
@@ -280,16 +475,8 @@ void TextureCache::loadImage()
         ul.unlock();
 
         // load image
-        asyncStruct->loadSuccess = asyncStruct->image.initWithImageFileThreadSafe(asyncStruct->filename);
-
-        // ETC1 ALPHA supports.
-        if (asyncStruct->loadSuccess && asyncStruct->image.getFileType() == Image::Format::ETC1 &&
-            !s_etc1AlphaFileSuffix.empty())
-        {  // check whether alpha texture exists & load it
-            auto alphaFile = asyncStruct->filename + s_etc1AlphaFileSuffix;
-            if (FileUtils::getInstance()->isFileExist(alphaFile))
-                asyncStruct->imageAlpha.initWithImageFileThreadSafe(alphaFile);
-        }
+        decodeAsyncStruct(asyncStruct);
+
         // push the asyncStruct to response queue
         _responseMutex.lock();
         _responseQueue.emplace_back(asyncStruct);
@@ -297,8 +484,64 @@ void TextureCache::loadImage()
     }
 }
 
+void TextureCache::decodeAsyncStruct(AsyncStruct* asyncStruct)
+{
+    AX_TRACE_SCOPE("TextureCache::loadImage");
+    asyncStruct->loadSuccess = asyncStruct->image.initWithImageFileThreadSafe(asyncStruct->filename);
+
+    // ETC1 ALPHA supports.
+    if (asyncStruct->loadSuccess && asyncStruct->image.getFileType() == Image::Format::ETC1 &&
+        !s_etc1AlphaFileSuffix.empty())
+    {  // check whether alpha texture exists & load it
+        auto alphaFile = asyncStruct->filename + s_etc1AlphaFileSuffix;
+        if (FileUtils::getInstance()->isFileExist(alphaFile))
+            asyncStruct->imageAlpha.initWithImageFileThreadSafe(alphaFile);
+    }
+}
+
+Texture2D* TextureCache::uploadAsyncStruct(AsyncStruct* asyncStruct)
+{
+    // check the image has been convert to texture or not
+    auto it = _textures.find(asyncStruct->filename);
+    if (it != _textures.end())
+        return it->second;
+
+    // convert image to texture
+    if (!asyncStruct->loadSuccess)
+    {
+        AXLOGW("axmol: failed to call TextureCache::addImageAsync({})", asyncStruct->filename);
+        return nullptr;
+    }
+
+    Image* image = &(asyncStruct->image);
+    // generate texture in render thread
+    auto texture = new Texture2D();
+
+    texture->initWithImage(image, asyncStruct->pixelFormat);
+    // parse 9-patch info
+    this->parseNinePatchImage(image, texture, asyncStruct->filename);
+#if AX_ENABLE_CACHE_TEXTURE_DATA
+    // cache the texture file name
+    VolatileTextureMgr::addImageTexture(texture, asyncStruct->filename);
+#endif
+    // cache the texture. retain it, since it is added in the map
+    _textures.emplace(asyncStruct->filename, texture);
+    texture->retain();
+
+    texture->autorelease();
+    // ETC1 ALPHA supports.
+    if (asyncStruct->imageAlpha.getFileType() == Image::Format::ETC1)
+    {
+        texture->updateWithImage(&asyncStruct->imageAlpha, asyncStruct->pixelFormat, 1);
+    }
+    return texture;
+}
+
 void TextureCache::addImageAsyncCallBack(float /*dt*/)
 {
+    AX_TRACE_SCOPE("TextureCache::addImageAsyncCallBack");
+
+    const auto start         = std::chrono::steady_clock::now();
     Texture2D* texture       = nullptr;
     AsyncStruct* asyncStruct = nullptr;
     while (true)
@@ -325,45 +568,7 @@ void TextureCache::addImageAsyncCallBack(float /*dt*/)
             break;
         }
 
-        // check the image has been convert to texture or not
-        auto it = _textures.find(asyncStruct->filename);
-        if (it != _textures.end())
-        {
-            texture = it->second;
-        }
-        else
-        {
-            // convert image to texture
-            if (asyncStruct->loadSuccess)
-            {
-                Image* image = &(asyncStruct->image);
-                // generate texture in render thread
-                texture = new Texture2D();
-
-                texture->initWithImage(image, asyncStruct->pixelFormat);
-                // parse 9-patch info
-                this->parseNinePatchImage(image, texture, asyncStruct->filename);
-#if AX_ENABLE_CACHE_TEXTURE_DATA
-                // cache the texture file name
-                VolatileTextureMgr::addImageTexture(texture, asyncStruct->filename);
-#endif
-                // cache the texture. retain it, since it is added in the map
-                _textures.emplace(asyncStruct->filename, texture);
-                texture->retain();
-
-                texture->autorelease();
-                // ETC1 ALPHA supports.
-                if (asyncStruct->imageAlpha.getFileType() == Image::Format::ETC1)
-                {
-                    texture->updateWithImage(&asyncStruct->imageAlpha, asyncStruct->pixelFormat, 1);
-                }
-            }
-            else
-            {
-                texture = nullptr;
-                AXLOGW("axmol: failed to call TextureCache::addImageAsync({})", asyncStruct->filename);
-            }
-        }
+        texture = uploadAsyncStruct(asyncStruct);
 
         // call callback function
         if (asyncStruct->callback)
@@ -374,6 +579,10 @@ void TextureCache::addImageAsyncCallBack(float /*dt*/)
         // release the asyncStruct
         delete asyncStruct;
         --_asyncRefCount;
+
+        // the remaining responses are handled in the next frames
+        if (isUploadBudgetExceeded(_asyncUploadBudget, start))
+            break;
     }
 
     if (0 == _asyncRefCount)
@@ -452,6 +661,21 @@ Texture2D* TextureCache::addImage(std::string_view path, PixelFormat format)
     if (it != _textures.end())
         texture = it->second;
 
+    // the nine-patch info is parsed from the decoded image, so those images don't use the disk cache
+    const bool useDiskCache = _diskCacheEnabled && !NinePatchImageParser::isNinePatchImage(path);
+    if (!texture && useDiskCache)
+    {
+        texture = loadFromDiskCache(fullpath, format);
+        if (texture)
+        {
+#if AX_ENABLE_CACHE_TEXTURE_DATA
+            VolatileTextureMgr::addImageTexture(texture, fullpath);
+#endif
+            _textures.emplace(fullpath, texture);
+            return texture;
+        }
+    }
+
     if (!texture)
     {
         // all images are handled by UIImage except PVR extension that is handled by our own handler
@@ -488,6 +712,9 @@ Texture2D* TextureCache::addImage(std::string_view path, PixelFormat format)
 
                 // parse 9-patch info
                 this->parseNinePatchImage(image, texture, path);
+
+                if (useDiskCache)
+                    saveToDiskCache(fullpath, format, image);
             }
             else
             {
@@ -513,6 +740,128 @@ void TextureCache::parseNinePatchImage(ax::Image* image, ax::Texture2D* texture,
     }
 }
 
+void TextureCache::setDiskCachePath(std::string_view path)
+{
+    _diskCachePath = path;
+    if (!_diskCachePath.empty() && _diskCachePath.back() != '/')
+        _diskCachePath.push_back('/');
+}
+
+const std::string& TextureCache::getDiskCachePath()
+{
+    if (_diskCachePath.empty())
+        _diskCachePath = FileUtils::getInstance()->getWritablePath() + "texture-cache/";
+    return _diskCachePath;
+}
+
+void TextureCache::purgeDiskCache()
+{
+    auto fileUtils = FileUtils::getInstance();
+    auto& path     = getDiskCachePath();
+    if (fileUtils->isDirectoryExist(path))
+        fileUtils->removeDirectory(path);
+}
+
+std::string TextureCache::getDiskCacheFile(std::string_view fullpath, PixelFormat format)
+{
+    XXH64_state_t* state = XXH64_createState();
+    XXH64_reset(state, 0);
+    XXH64_update(state, fullpath.data(), fullpath.size());
+    XXH64_update(state, &format, sizeof(format));
+    auto hash = XXH64_digest(state);
+    XXH64_freeState(state);
+
+    return fmt::format("{}{:016x}.tex", getDiskCachePath(), hash);
+}
+
+Texture2D* TextureCache::loadFromDiskCache(std::string_view fullpath, PixelFormat format)
+{
+    AX_TRACE_SCOPE("TextureCache::loadFromDiskCache");
+
+    auto cacheFile = getDiskCacheFile(fullpath, format);
+
+    std::error_code ec;
+    mio::mmap_source mapping;
+    mapping.map(cacheFile, ec);
+    if (ec || mapping.size() < sizeof(DiskCacheHeader))
+        return nullptr;
+
+    DiskCacheHeader header;
+    memcpy(&header, mapping.data(), sizeof(header));
+    if (memcmp(header.magic, DISK_CACHE_MAGIC, sizeof(header.magic)) != 0 || header.version != DISK_CACHE_VERSION ||
+        mapping.size() != sizeof(DiskCacheHeader) + header.dataLen)
+        return nullptr;
+
+    DiskCacheHeader source;
+    getDiskCacheSource(fullpath, source);
+    if (source.sourceSize != header.sourceSize || source.sourceTime != header.sourceTime ||
+        source.sourceHash != header.sourceHash)
+        return nullptr;
+
+    // the pixels are already in their render format, the data is copied by the upload, so the mapping can be
+    // released right after
+    auto pixelFormat = static_cast<PixelFormat>(header.pixelFormat);
+    auto texture     = new Texture2D();
+    if (!texture->initWithData(mapping.data() + sizeof(DiskCacheHeader), static_cast<ssize_t>(header.dataLen),
+                               pixelFormat, pixelFormat, static_cast<int>(header.width),
+                               static_cast<int>(header.height), header.premultipliedAlpha != 0))
+    {
+        AX_SAFE_RELEASE(texture);
+        return nullptr;
+    }
+    texture->_filePath = fullpath;
+
+    return texture;
+}
+
+void TextureCache::saveToDiskCache(std::string_view fullpath, PixelFormat format, Image* image)
+{
+    if (image->isCompressed() || image->getNumberOfMipmaps() > 1)
+        return;
+
+    // convert the pixels like Texture2D::updateWithImage does
+    auto imageFormat  = image->getPixelFormat();
+    auto renderFormat = Texture2D::getSupportedRenderFormat(PixelFormat::NONE == format ? imageFormat : format);
+
+    unsigned char* data = image->getData();
+    size_t dataLen      = image->getDataLen();
+    if (renderFormat != imageFormat)
+    {
+        unsigned char* outData = nullptr;
+        size_t outDataLen      = 0;
+        if (backend::PixelFormatUtils::convertDataToFormat(data, dataLen, imageFormat, renderFormat, &outData,
+                                                           &outDataLen) != renderFormat)
+            return;
+        data    = outData;
+        dataLen = outDataLen;
+    }
+
+    DiskCacheHeader header;
+    memcpy(header.magic, DISK_CACHE_MAGIC, sizeof(header.magic));
+    header.version = DISK_CACHE_VERSION;
+    getDiskCacheSource(fullpath, header);
+    header.width              = static_cast<uint32_t>(image->getWidth());
+    header.height             = static_cast<uint32_t>(image->getHeight());
+    header.pixelFormat        = static_cast<uint32_t>(renderFormat);
+    header.premultipliedAlpha = image->hasPremultipliedAlpha() ? 1 : 0;
+    header.dataLen            = dataLen;
+
+    Data blob;
+    auto bytes = blob.resize(sizeof(DiskCacheHeader) + dataLen);
+    memcpy(bytes, &header, sizeof(header));
+    memcpy(bytes + sizeof(header), data, dataLen);
+    if (data != image->getData())
+        free(data);
+
+    auto fileUtils = FileUtils::getInstance();
+    auto& path     = getDiskCachePath();
+    if (!fileUtils->isDirectoryExist(path))
+        fileUtils->createDirectory(path);
+
+    // written off thread, an interrupted write is detected by the size check of loadFromDiskCache
+    fileUtils->writeDataToFile(std::move(blob), getDiskCacheFile(fullpath, format), [](bool) {});
+}
+
 Texture2D* TextureCache::addImage(Image* image, std::string_view key)
 {
     return addImage(image, key, Texture2D::getDefaultAlphaPixelFormat());
@@ -749,6 +1098,17 @@ void TextureCache::waitForQuit()
     ul.unlock();
     if (_loadingThread)
         _loadingThread->join();
+
+    // drop the pending preloads and wait for the images being decoded by the job system
+    std::unique_lock<std::mutex> lck(_preloadMutex);
+    for (auto&& asyncStruct : _preloadQueue)
+        delete asyncStruct;
+    _preloadQueue.clear();
+    _preloadCondition.wait(lck, [this] { return 0 == _preloadDecoding; });
+    for (auto&& asyncStruct : _preloadResponses)
+        delete asyncStruct;
+    _preloadResponses.clear();
+    _preloadDecodedBytes = 0;
 }
 
 std::string TextureCache::getCachedTextureInfo() const
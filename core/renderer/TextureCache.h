@@ -136,6 +136,44 @@ public:
      */
     virtual void unbindAllImageAsync();
 
+    /** Preloads a batch of images asynchronously.
+     * The images are decoded on the JobSystem background workers, and the textures are created in the GL thread
+     * within the upload budget of each frame, see setAsyncUploadBudget.
+     * Decoding pauses while the decoded images waiting for upload exceed getMaxPreloadDecodedBytes().
+     * @param paths The file paths of the images.
+     * @param progress Called in the GL thread each time an image is loaded, with its texture (nullptr if it failed),
+     * the number of images loaded so far and the total number of images.
+     */
+    void preloadImagesAsync(const std::vector<std::string>& paths,
+                            const std::function<void(Texture2D* texture, size_t loaded, size_t total)>& progress);
+
+    /** Sets how long the GL thread may spend creating the textures of asynchronous loads per frame.
+     * At least one texture is created each frame.
+     * @param milliseconds The budget in milliseconds, 0 for no limit (the default).
+     */
+    void setAsyncUploadBudget(float milliseconds) { _asyncUploadBudget = milliseconds; }
+    float getAsyncUploadBudget() const { return _asyncUploadBudget; }
+
+    /** Sets the maximum bytes of decoded images waiting for upload when preloading, 64MB by default. */
+    void setMaxPreloadDecodedBytes(size_t bytes) { _maxPreloadDecodedBytes = bytes; }
+    size_t getMaxPreloadDecodedBytes() const { return _maxPreloadDecodedBytes; }
+
+    /** Enables the persistent cache of decoded textures, disabled by default.
+     * When enabled, addImage(filepath) stores the decoded, premultiplied and format converted pixels of uncompressed
+     * images in the disk cache directory, and later loads of the same file are uploaded from a memory mapping of the
+     * cached data instead of being decoded again. The entries are invalidated when the size, modification time or,
+     * for files without a modification time, the content hash of the source image changes.
+     */
+    void setDiskCacheEnabled(bool enabled) { _diskCacheEnabled = enabled; }
+    bool isDiskCacheEnabled() const { return _diskCacheEnabled; }
+
+    /** Sets the directory of the disk cache, "texture-cache/" under the writable path by default. */
+    void setDiskCachePath(std::string_view path);
+    const std::string& getDiskCachePath();
+
+    /** Removes all the entries of the disk cache. */
+    void purgeDiskCache();
+
     /** Returns a Texture2D object given an Image.
      * If the image was not previously loaded, it will create a new Texture2D object and it will return it.
      * Otherwise it will return a reference of a previously loaded image.
@@ -226,12 +264,20 @@ public:
 private:
     void addImageAsyncCallBack(float dt);
     void loadImage();
+    void preloadImagesCallBack(float dt);
     void parseNinePatchImage(Image* image, Texture2D* texture, std::string_view path);
+    Texture2D* loadFromDiskCache(std::string_view fullpath, PixelFormat format);
+    void saveToDiskCache(std::string_view fullpath, PixelFormat format, Image* image);
+    std::string getDiskCacheFile(std::string_view fullpath, PixelFormat format);
 
 public:
 protected:
     struct AsyncStruct;
 
+    static void decodeAsyncStruct(AsyncStruct* asyncStruct);
+    Texture2D* uploadAsyncStruct(AsyncStruct* asyncStruct);
+    void dispatchPreloads();
+
     std::thread* _loadingThread;
 
     std::deque<AsyncStruct*> _asyncStructQueue;
@@ -247,6 +293,22 @@ protected:
 
     int _asyncRefCount;
 
+    // preloadImagesAsync requests waiting for a decoder, GL thread only
+    std::deque<AsyncStruct*> _preloadQueue;
+    // decoded preload requests, locked by _preloadMutex like the counters below
+    std::deque<AsyncStruct*> _preloadResponses;
+    std::mutex _preloadMutex;
+    std::condition_variable _preloadCondition;
+    size_t _preloadDecodedBytes = 0;
+    int _preloadDecoding        = 0;
+    bool _preloadScheduled      = false;
+
+    size_t _maxPreloadDecodedBytes = 64 * 1024 * 1024;
+    float _asyncUploadBudget       = 0;
+
+    std::string _diskCachePath;
+    bool _diskCacheEnabled = false;
+
     hlookup::string_map<Texture2D*> _textures;
 
     static std::string s_etc1AlphaFileSuffix;
@@ -244,8 +244,12 @@ void Layout::stencilClippingVisit(Renderer* renderer, const Mat4& parentTransfor
     // IMPORTANT:
     // To ease the migration to v3.0, we still support the Mat4 stack,
     // but it is deprecated and your code should not rely on it
-    _director->pushMatrix(MATRIX_STACK_TYPE::MATRIX_STACK_MODELVIEW);
-    _director->loadMatrix(MATRIX_STACK_TYPE::MATRIX_STACK_MODELVIEW, _modelViewTransform);
+    const bool matrixStackEnabled = _director->isMatrixStackEnabled();
+    if (matrixStackEnabled)
+    {
+        _director->pushMatrix(MATRIX_STACK_TYPE::MATRIX_STACK_MODELVIEW);
+        _director->loadMatrix(MATRIX_STACK_TYPE::MATRIX_STACK_MODELVIEW, _modelViewTransform);
+    }
     // Add group command
 
     auto* groupCommand = renderer->getNextGroupCommand();
@@ -315,7 +319,8 @@ void Layout::stencilClippingVisit(Renderer* renderer, const Mat4& parentTransfor
 
     renderer->popGroup();
 
-    _director->popMatrix(MATRIX_STACK_TYPE::MATRIX_STACK_MODELVIEW);
+    if (matrixStackEnabled)
+        _director->popMatrix(MATRIX_STACK_TYPE::MATRIX_STACK_MODELVIEW);
 }
 
 void Layout::onBeforeVisitScissor()
@@ -366,8 +371,12 @@ void Layout::scissorClippingVisit(Renderer* renderer, const Mat4& parentTransfor
         _clippingRectDirty = true;
     }
 
-    _director->pushMatrix(MATRIX_STACK_TYPE::MATRIX_STACK_MODELVIEW);
-    _director->loadMatrix(MATRIX_STACK_TYPE::MATRIX_STACK_MODELVIEW, _modelViewTransform);
+    const bool matrixStackEnabled = _director->isMatrixStackEnabled();
+    if (matrixStackEnabled)
+    {
+        _director->pushMatrix(MATRIX_STACK_TYPE::MATRIX_STACK_MODELVIEW);
+        _director->loadMatrix(MATRIX_STACK_TYPE::MATRIX_STACK_MODELVIEW, _modelViewTransform);
+    }
 
     auto* groupCommand = renderer->getNextGroupCommand();
     groupCommand->init(_globalZOrder);
@@ -387,7 +396,8 @@ void Layout::scissorClippingVisit(Renderer* renderer, const Mat4& parentTransfor
     renderer->addCommand(afterVisitCmdScissor);
 
     renderer->popGroup();
-    _director->popMatrix(MATRIX_STACK_TYPE::MATRIX_STACK_MODELVIEW);
+    if (matrixStackEnabled)
+        _director->popMatrix(MATRIX_STACK_TYPE::MATRIX_STACK_MODELVIEW);
 }
 
 void Layout::setClippingEnabled(bool able)
@@ -47,6 +47,9 @@ ListView::ListView()
     , _curSelectedIndex(-1)
     , _innerContainerDoLayoutDirty(true)
     , _eventCallback(nullptr)
+    , _virtualized(false)
+    , _virtualizationMargin(0.0f)
+    , _boundItemsDirty(true)
 {
     this->setTouchEnabled(true);
 }
@@ -275,6 +278,7 @@ void ListView::addChild(ax::Node* child, int zOrder, int tag)
     Widget* widget = dynamic_cast<Widget*>(child);
     if (nullptr != widget)
     {
+        AXASSERT(!_virtualized, "ListView: the items of a virtualized ListView come from its data source");
         _items.pushBack(widget);
         onItemListChanged();
     }
@@ -297,6 +301,7 @@ void ListView::addChild(Node* child, int zOrder, std::string_view name)
     Widget* widget = dynamic_cast<Widget*>(child);
     if (nullptr != widget)
     {
+        AXASSERT(!_virtualized, "ListView: the items of a virtualized ListView come from its data source");
         _items.pushBack(widget);
         onItemListChanged();
     }
@@ -337,11 +342,16 @@ void ListView::removeAllChildrenWithCleanup(bool cleanup)
     ScrollView::removeAllChildrenWithCleanup(cleanup);
     _curSelectedIndex = -1;
     _items.clear();
+    _boundItems.clear();
+    _recycledItems.clear();
+    _boundItemsDirty = true;
     onItemListChanged();
 }
 
 void ListView::insertCustomItem(Widget* item, ssize_t index)
 {
+    AXASSERT(!_virtualized, "ListView: the items of a virtualized ListView come from its data source");
+
     if (-1 != _curSelectedIndex)
     {
         if (_curSelectedIndex >= index)
@@ -380,6 +390,11 @@ void ListView::removeAllItems()
 
 Widget* ListView::getItem(ssize_t index) const
 {
+    if (_virtualized)
+    {
+        auto iter = _boundItems.find(index);
+        return iter != _boundItems.end() ? iter->second : nullptr;
+    }
     if (index < 0 || index >= _items.size())
     {
         return nullptr;
@@ -398,9 +413,56 @@ ssize_t ListView::getIndex(Widget* item) const
     {
         return -1;
     }
+    if (_virtualized)
+    {
+        for (auto&& boundItem : _boundItems)
+        {
+            if (boundItem.second == item)
+                return boundItem.first;
+        }
+        return -1;
+    }
     return _items.getIndex(item);
 }
 
+void ListView::setDataSource(DataSource dataSource)
+{
+    AXASSERT(_items.empty(), "ListView: remove the items before setting a data source");
+
+    // the widgets may not suit the new data source
+    recycleVirtualItems();
+    for (auto&& item : _recycledItems)
+    {
+        ScrollView::removeChild(item, true);
+    }
+    _recycledItems.clear();
+    _virtualItemOffsets.clear();
+    _curSelectedIndex = -1;
+
+    _dataSource  = std::move(dataSource);
+    _virtualized = _dataSource.bindItem != nullptr;
+    // the bound items are positioned by the ListView, not by the layout of the inner container
+    setDirection(_direction);
+    requestDoLayout();
+}
+
+void ListView::reloadData()
+{
+    if (!_virtualized)
+    {
+        return;
+    }
+    recycleVirtualItems();
+    requestDoLayout();
+    doLayout();
+}
+
+void ListView::setVirtualizationMargin(float margin)
+{
+    _virtualizationMargin = margin;
+    _boundItemsDirty      = true;
+}
+
 void ListView::setGravity(Gravity gravity)
 {
     if (_gravity == gravity)
@@ -538,6 +600,11 @@ void ListView::setDirection(Direction dir)
         return;
         break;
     }
+    if (_virtualized)
+    {
+        setLayoutType(Type::ABSOLUTE);
+        requestDoLayout();
+    }
     ScrollView::setDirection(dir);
 }
 
@@ -548,6 +615,21 @@ void ListView::requestDoLayout()
 
 void ListView::doLayout()
 {
+    if (_virtualized)
+    {
+        if (_innerContainerDoLayoutDirty)
+        {
+            updateVirtualItemOffsets();
+            _innerContainerDoLayoutDirty = false;
+            _boundItemsDirty             = true;
+        }
+        if (_boundItemsDirty || _boundItemsPosition != _innerContainer->getPosition())
+        {
+            updateVirtualItems();
+        }
+        return;
+    }
+
     if (!_innerContainerDoLayoutDirty)
     {
         return;
@@ -565,6 +647,204 @@ void ListView::doLayout()
     _innerContainerDoLayoutDirty = false;
 }
 
+void ListView::updateVirtualItemOffsets()
+{
+    ssize_t count         = _dataSource.getItemCount ? _dataSource.getItemCount() : 0;
+    bool horizontal       = _direction == Direction::HORIZONTAL;
+    float defaultItemSize = 0.0f;
+    if (!_dataSource.getItemSize && _model)
+    {
+        const auto& modelSize = _model->getBoundingBox().size;
+        defaultItemSize       = horizontal ? modelSize.width : modelSize.height;
+    }
+
+    _virtualItemOffsets.resize(count + 1);
+    float offset = horizontal ? _leftPadding : _topPadding;
+    for (ssize_t i = 0; i < count; ++i)
+    {
+        _virtualItemOffsets[i] = offset;
+        offset += (_dataSource.getItemSize ? _dataSource.getItemSize(i) : defaultItemSize) + _itemsMargin;
+    }
+    _virtualItemOffsets[count] = offset;
+
+    float totalSize = (count == 0) ? 0.0f : offset - _itemsMargin + (horizontal ? _rightPadding : _bottomPadding);
+    if (horizontal)
+    {
+        setInnerContainerSize(Vec2(totalSize, _contentSize.height));
+    }
+    else
+    {
+        setInnerContainerSize(Vec2(_contentSize.width, totalSize));
+    }
+
+    // the sizes or the paddings may have changed
+    for (auto&& boundItem : _boundItems)
+    {
+        if (boundItem.first < count)
+            layoutVirtualItem(boundItem.second, boundItem.first);
+    }
+}
+
+void ListView::updateVirtualItems()
+{
+    _boundItemsPosition = _innerContainer->getPosition();
+    _boundItemsDirty    = false;
+
+    // the bound range, as the distances from the top or the left of the inner container
+    float rangeBegin;
+    if (_direction == Direction::HORIZONTAL)
+    {
+        rangeBegin = -_innerContainer->getLeftBoundary();
+    }
+    else
+    {
+        rangeBegin = _innerContainer->getTopBoundary() - _contentSize.height;
+    }
+    float rangeEnd = rangeBegin + (_direction == Direction::HORIZONTAL ? _contentSize.width : _contentSize.height);
+    rangeBegin -= _virtualizationMargin;
+    rangeEnd += _virtualizationMargin;
+
+    // the items starting before the range end, from the last one starting before the range begin
+    ssize_t count  = static_cast<ssize_t>(_virtualItemOffsets.size()) - 1;
+    ssize_t first  = 0;
+    ssize_t last   = -1;
+    if (count > 0)
+    {
+        auto offsetsBegin = _virtualItemOffsets.begin();
+        auto offsetsEnd   = offsetsBegin + count;
+        first = std::max<ssize_t>(0, std::upper_bound(offsetsBegin, offsetsEnd, rangeBegin) - offsetsBegin - 1);
+        last  = std::lower_bound(offsetsBegin, offsetsEnd, rangeEnd) - offsetsBegin - 1;
+    }
+
+    for (auto iter = _boundItems.begin(); iter != _boundItems.end();)
+    {
+        if (iter->first < first || iter->first > last)
+        {
+            if (_dataSource.unbindItem)
+                _dataSource.unbindItem(iter->second, iter->first);
+            iter->second->setVisible(false);
+            _recycledItems.pushBack(iter->second);
+            iter = _boundItems.erase(iter);
+        }
+        else
+        {
+            ++iter;
+        }
+    }
+
+    for (ssize_t index = first; index <= last; ++index)
+    {
+        if (_boundItems.find(index) != _boundItems.end())
+            continue;
+
+        Widget* item = nullptr;
+        if (!_recycledItems.empty())
+        {
+            // still retained by the inner container
+            item = _recycledItems.back();
+            _recycledItems.popBack();
+            item->setVisible(true);
+        }
+        else
+        {
+            item = _dataSource.createItem ? _dataSource.createItem() : (_model ? _model->clone() : nullptr);
+            AXASSERT(item, "ListView: set an item model or DataSource::createItem to create the items");
+            ScrollView::addChild(item);
+        }
+        _boundItems.emplace(index, item);
+
+        // the item is positioned once bound, its size may depend on the data
+        _dataSource.bindItem(item, index);
+        layoutVirtualItem(item, index);
+    }
+}
+
+void ListView::layoutVirtualItem(Widget* item, ssize_t index)
+{
+    Vec2 layoutSize = _innerContainer->getContentSize();
+    Vec2 ap         = item->getAnchorPoint();
+    Vec2 cs         = item->getBoundingBox().size;
+    float offset    = _virtualItemOffsets[index];
+
+    // the same positions as the linear layouts of the inner container
+    Vec2 position;
+    if (_direction == Direction::HORIZONTAL)
+    {
+        position.x = offset + ap.x * cs.width;
+        switch (_gravity)
+        {
+        case Gravity::BOTTOM:
+            position.y = ap.y * cs.height;
+            break;
+        case Gravity::CENTER_VERTICAL:
+            position.y = layoutSize.height / 2.0f - cs.height * (0.5f - ap.y);
+            break;
+        default:
+            position.y = layoutSize.height - (1.0f - ap.y) * cs.height;
+            break;
+        }
+        position.y -= _topPadding;
+    }
+    else
+    {
+        position.y = layoutSize.height - offset - (1.0f - ap.y) * cs.height;
+        switch (_gravity)
+        {
+        case Gravity::RIGHT:
+            position.x = layoutSize.width - (1.0f - ap.x) * cs.width;
+            break;
+        case Gravity::CENTER_HORIZONTAL:
+            position.x = layoutSize.width / 2.0f - cs.width * (0.5f - ap.x);
+            break;
+        default:
+            position.x = ap.x * cs.width;
+            break;
+        }
+        position.x += _leftPadding;
+    }
+    item->setPosition(position);
+}
+
+void ListView::recycleVirtualItems()
+{
+    for (auto&& boundItem : _boundItems)
+    {
+        if (_dataSource.unbindItem)
+            _dataSource.unbindItem(boundItem.second, boundItem.first);
+        boundItem.second->setVisible(false);
+        _recycledItems.pushBack(boundItem.second);
+    }
+    _boundItems.clear();
+    _boundItemsDirty = true;
+}
+
+Vec2 ListView::calculateVirtualItemDestination(ssize_t index,
+                                               const Vec2& positionRatioInView,
+                                               const Vec2& itemAnchorPoint)
+{
+    const Vec2& innerSize = _innerContainer->getContentSize();
+    float offset          = _virtualItemOffsets[index];
+    float itemSize        = _virtualItemOffsets[index + 1] - offset - _itemsMargin;
+
+    Rect itemRect = _direction == Direction::HORIZONTAL
+                        ? Rect(offset, 0.0f, itemSize, innerSize.height)
+                        : Rect(0.0f, innerSize.height - offset - itemSize, innerSize.width, itemSize);
+    Vec2 itemPosition(itemRect.origin.x + itemRect.size.width * itemAnchorPoint.x,
+                      itemRect.origin.y + itemRect.size.height * itemAnchorPoint.y);
+    Vec2 positionInView(_contentSize.width * positionRatioInView.x, _contentSize.height * positionRatioInView.y);
+    return -(itemPosition - positionInView);
+}
+
+void ListView::moveInnerContainer(const Vec2& deltaMove, bool canStartBounceBack)
+{
+    ScrollView::moveInnerContainer(deltaMove, canStartBounceBack);
+    if (_virtualized && !_innerContainerDoLayoutDirty)
+    {
+        // bind the items in view right away, not at the next visit
+        updateVirtualItems();
+    }
+}
+
 void ListView::addEventListener(const ccListViewCallback& callback)
 {
     _eventCallback = callback;
@@ -812,14 +1092,27 @@ void ListView::jumpToPercentBothDirection(const Vec2& percent)
 
 void ListView::jumpToItem(ssize_t itemIndex, const Vec2& positionRatioInView, const Vec2& itemAnchorPoint)
 {
-    Widget* item = getItem(itemIndex);
-    if (item == nullptr)
+    Vec2 destination;
+    if (_virtualized)
     {
-        return;
+        doLayout();
+        if (itemIndex < 0 || itemIndex >= static_cast<ssize_t>(_virtualItemOffsets.size()) - 1)
+        {
+            return;
+        }
+        destination = calculateVirtualItemDestination(itemIndex, positionRatioInView, itemAnchorPoint);
     }
-    doLayout();
+    else
+    {
+        Widget* item = getItem(itemIndex);
+        if (item == nullptr)
+        {
+            return;
+        }
+        doLayout();
 
-    Vec2 destination = calculateItemDestination(positionRatioInView, item, itemAnchorPoint);
+        destination = calculateItemDestination(positionRatioInView, item, itemAnchorPoint);
+    }
     if (!_bounceEnabled)
     {
         Vec2 delta         = destination - getInnerContainerPosition();
@@ -839,6 +1132,16 @@ void ListView::scrollToItem(ssize_t itemIndex,
                             const Vec2& itemAnchorPoint,
                             float timeInSec)
 {
+    if (_virtualized)
+    {
+        doLayout();
+        if (itemIndex >= 0 && itemIndex < static_cast<ssize_t>(_virtualItemOffsets.size()) - 1)
+        {
+            startAutoScrollToDestination(
+                calculateVirtualItemDestination(itemIndex, positionRatioInView, itemAnchorPoint), timeInSec, true);
+        }
+        return;
+    }
     Widget* item = getItem(itemIndex);
     if (item == nullptr)
     {
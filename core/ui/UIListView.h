@@ -27,6 +27,7 @@ THE SOFTWARE.
 #ifndef __UILISTVIEW_H__
 #define __UILISTVIEW_H__
 
+#include <map>
 #include "ui/UIScrollView.h"
 #include "ui/GUIExport.h"
 
@@ -42,9 +43,9 @@ namespace ui
 /**
  *@brief ListView is a view group that displays a list of scrollable items.
  *The list items are inserted to the list by using `addChild` or  `insertDefaultItem`.
- * @warning The list item in ListView doesn't support cell reuse at the moment, if you have a large amount of data need
- *to be displayed, use  `TableView` instead. ListView is a subclass of  `ScrollView`, so it shares many features of
- *ScrollView.
+ * @warning The list items in ListView are not reused, unless the ListView is virtualized with `setDataSource`. If you
+ *have a large amount of data to display, use a data source or `TableView` instead. ListView is a subclass of
+ *`ScrollView`, so it shares many features of ScrollView.
  */
 class AX_GUI_DLL ListView : public ScrollView
 {
@@ -95,6 +96,24 @@ public:
      */
     typedef std::function<void(Object*, EventType)> ccListViewCallback;
 
+    /**
+     * The callbacks providing the items of a virtualized ListView, see `setDataSource`.
+     */
+    struct DataSource
+    {
+        /** Returns the number of items. */
+        std::function<ssize_t()> getItemCount;
+        /** Returns the size of an item along the scroll direction. If not set, all the items have the size of the item
+         * model. */
+        std::function<float(ssize_t index)> getItemSize;
+        /** Creates a widget for the items when none can be recycled. If not set, the item model is cloned. */
+        std::function<Widget*()> createItem;
+        /** Sets up a widget, new or recycled, to show the item at index. */
+        std::function<void(Widget* item, ssize_t index)> bindItem;
+        /** Called when the item at index goes out of the bound range, before its widget is recycled. Optional. */
+        std::function<void(Widget* item, ssize_t index)> unbindItem;
+    };
+
     /**
      * Default constructor
      * @js ctor
@@ -190,6 +209,35 @@ public:
      */
     ssize_t getIndex(Widget* item) const;
 
+    /**
+     * Virtualizes the ListView with a data source, or turns the virtualization off with a data source without
+     * bindItem.
+     *
+     * A virtualized ListView only has widgets for the items in view and within the virtualization margin around it.
+     * The widgets of the items leaving this range are unbound and reused for the items entering it, and the inner
+     * container size is computed from the item sizes given by the data source, so the items may differ in size.
+     * Meanwhile items can't be added to the ListView, getItems() is empty, getItem() and getIndex() only know the items
+     * currently bound, and magnetic scroll is not supported.
+     *
+     * @param dataSource The callbacks providing the items.
+     */
+    void setDataSource(DataSource dataSource);
+    const DataSource& getDataSource() const { return _dataSource; }
+    bool isVirtualized() const { return _virtualized; }
+
+    /**
+     * Binds the items again after the data changed, as well as the number or the sizes of the items.
+     */
+    void reloadData();
+
+    /**
+     * Set the distance beyond each side of the view within which the items of a virtualized ListView are bound.
+     *
+     * @param margin A distance in float, 0 by default.
+     */
+    void setVirtualizationMargin(float margin);
+    float getVirtualizationMargin() const { return _virtualizationMargin; }
+
     /**
      * Set the gravity of ListView.
      * @see `ListViewGravity`
@@ -443,6 +491,14 @@ protected:
 
     void startMagneticScroll();
 
+    void moveInnerContainer(const Vec2& deltaMove, bool canStartBounceBack) override;
+
+    void updateVirtualItemOffsets();
+    void updateVirtualItems();
+    void layoutVirtualItem(Widget* item, ssize_t index);
+    void recycleVirtualItems();
+    Vec2 calculateVirtualItemDestination(ssize_t index, const Vec2& positionRatioInView, const Vec2& itemAnchorPoint);
+
 protected:
     Widget* _model;
 
@@ -464,6 +520,17 @@ protected:
 
     bool _innerContainerDoLayoutDirty;
     ccListViewCallback _eventCallback;
+
+    DataSource _dataSource;
+    bool _virtualized;
+    float _virtualizationMargin;
+    /** the distance of each item from the top or the left of the inner container, plus the end of the last item */
+    std::vector<float> _virtualItemOffsets;
+    /** the widgets of the bound items by index, and the hidden widgets waiting to be reused */
+    std::map<ssize_t, Widget*> _boundItems;
+    Vector<Widget*> _recycledItems;
+    Vec2 _boundItemsPosition;
+    bool _boundItemsDirty;
 };
 
 }  // namespace ui
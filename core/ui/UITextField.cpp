@@ -28,6 +28,7 @@ THE SOFTWARE.
 #include "ui/UIHelper.h"
 #include "base/UTF8.h"
 #include "2d/Camera.h"
+#include "base/EventDispatcher.h"
 
 NS_AX_BEGIN
 
@@ -337,7 +338,14 @@ void TextField::setTouchSize(const Vec2& size)
 
 void TextField::setTouchAreaEnabled(bool enable)
 {
+    if (_useTouchArea == enable)
+        return;
+
     _useTouchArea = enable;
+
+    // the touch area may reach beyond the content rect
+    if (_touchListener)
+        _eventDispatcher->setHitTestIndexed(_touchListener, isHitTestInsideContent());
 }
 
 bool TextField::hitTest(const Vec2& pt, const Camera* camera, Vec3* /*p*/) const
@@ -295,6 +295,7 @@ public:
     void setTouchAreaEnabled(bool enable);
 
     virtual bool hitTest(const Vec2& pt, const Camera* camera, Vec3* p) const override;
+    virtual bool isHitTestInsideContent() const override { return !_useTouchArea; }
 
     /**
      * @brief Set placeholder of TextField.
@@ -449,6 +449,15 @@ public:
      */
     virtual bool hitTest(const Vec2& pt, const Camera* camera, Vec3* p) const;
 
+    /**
+     * Checks whether hitTest only accepts points inside the content size of the widget.
+     * The touch listener of the widget is hit-test indexed when it does, override it if hitTest reaches further.
+     *
+     * @return true if the touch area of the widget is its content size.
+     * @see EventDispatcher::setHitTestIndexEnabled
+     */
+    virtual bool isHitTestInsideContent() const { return true; }
+
     /**
      * A callback which will be called when touch began event is issued.
      *@param touch The touch info.
@@ -44,6 +44,7 @@ MeshRendererTests::MeshRendererTests()
     ADD_TEST_CASE(MeshRendererDynamicInstancingBasicTest);
     ADD_TEST_CASE(MeshRendererPreallocatedInstancingBufferTest);
     ADD_TEST_CASE(MeshRendererInstancingStressTest);
+    ADD_TEST_CASE(MeshRendererAutoInstancingCamerasTest);
     ADD_TEST_CASE(MeshRendererHitTest);
     ADD_TEST_CASE(AsyncLoadMeshRendererTest);
     //    // 3DEffect use custom shader which is not supported on WP8/WinRT yet.
@@ -400,6 +401,65 @@ std::string MeshRendererInstancingStressTest::subtitle() const
     return "10000 instances of the same mesh";
 }
 
+//------------------------------------------------------------------
+//
+// MeshRendererAutoInstancingCamerasTest
+//
+//------------------------------------------------------------------
+
+MeshRendererAutoInstancingCamerasTest::MeshRendererAutoInstancingCamerasTest()
+{
+    auto& s = Director::getInstance()->getWinSize();
+
+    // identical meshes, merged into an instanced draw per camera
+    for (int x = 0; x < 8; ++x)
+    {
+        for (int y = 0; y < 5; ++y)
+        {
+            auto mesh = MeshRenderer::create("MeshRendererTest/boss1.obj");
+            mesh->setScale(2.f);
+            mesh->setTexture("MeshRendererTest/boss.png");
+            mesh->setPosition(s.width * (x + 0.5f) / 8, s.height * (y + 0.5f) / 5);
+            mesh->runAction(RepeatForever::create(RotateBy::create(2 + x * 0.5f, Vec3(0, 360, 0))));
+            mesh->setCameraMask((unsigned short)CameraFlag::DEFAULT | (unsigned short)CameraFlag::USER1);
+            addChild(mesh);
+        }
+    }
+
+    // a zoomed view drawn over the default camera in the same frame, it sees a different set of meshes
+    auto camera = Camera::createPerspective(30, s.width / s.height, 10, 2000);
+    camera->setCameraFlag(CameraFlag::USER1);
+    camera->setDepth(1);
+    camera->setBackgroundBrush(CameraBackgroundBrush::createDepthBrush(1.f));
+    camera->setPosition3D(Vec3(s.width / 4, s.height / 3, 500));
+    camera->lookAt(Vec3(s.width / 4, s.height / 3, 0));
+    addChild(camera);
+}
+
+void MeshRendererAutoInstancingCamerasTest::onEnter()
+{
+    MeshRendererTestDemo::onEnter();
+    auto renderer          = Director::getInstance()->getRenderer();
+    _autoInstancingEnabled = renderer->isAutoInstancingEnabled();
+    renderer->setAutoInstancingEnabled(true);
+}
+
+void MeshRendererAutoInstancingCamerasTest::onExit()
+{
+    Director::getInstance()->getRenderer()->setAutoInstancingEnabled(_autoInstancingEnabled);
+    MeshRendererTestDemo::onExit();
+}
+
+std::string MeshRendererAutoInstancingCamerasTest::title() const
+{
+    return "Auto Instancing With Two Cameras";
+}
+
+std::string MeshRendererAutoInstancingCamerasTest::subtitle() const
+{
+    return "Each camera draws its own instances";
+}
+
 //------------------------------------------------------------------
 //
 // MeshRendererUVAnimationTest
@@ -115,6 +115,20 @@ public:
     virtual std::string subtitle() const override;
 };
 
+class MeshRendererAutoInstancingCamerasTest : public MeshRendererTestDemo
+{
+public:
+    CREATE_FUNC(MeshRendererAutoInstancingCamerasTest);
+    MeshRendererAutoInstancingCamerasTest();
+    virtual void onEnter() override;
+    virtual void onExit() override;
+    virtual std::string title() const override;
+    virtual std::string subtitle() const override;
+
+protected:
+    bool _autoInstancingEnabled = false;
+};
+
 class MeshRendererUVAnimationTest : public MeshRendererTestDemo
 {
 public:
@@ -37,6 +37,7 @@ HttpClientTests::HttpClientTests()
 {
     ADD_TEST_CASE(HttpClientTest);
     ADD_TEST_CASE(HttpClientClearRequestsTest);
+    ADD_TEST_CASE(HttpClientKeepAliveTest);
 }
 
 HttpClientTest::HttpClientTest() : _labelStatusCode(nullptr)
@@ -161,6 +162,21 @@ void HttpClientTest::onMenuGetTestClicked(ax::Object* sender)
         request->release();
     }
 
+    // test 6: gzip and deflate bodies are decoded and streamed as they arrive
+    for (auto url : {"https://httpbin.org/gzip", "https://httpbin.org/deflate"})
+    {
+        HttpRequest* request = new HttpRequest();
+        request->setUrl(url);
+        request->setRequestType(HttpRequest::Type::GET);
+        request->setResponseDataCallback([](HttpResponse* response, const char* data, size_t size) {
+            ax::print("%s received %d decoded bytes", response->getHttpRequest()->getTag().data(), (int)size);
+        });
+        request->setResponseCallback(AX_CALLBACK_2(HttpClientTest::onHttpRequestCompleted, this));
+        request->setTag(url);
+        HttpClient::getInstance()->send(request);
+        request->release();
+    }
+
     // waiting
     _labelStatusCode->setString("waiting...");
 }
@@ -508,3 +524,112 @@ void HttpClientClearRequestsTest::onHttpRequestCompleted(HttpClient* sender, Htt
         // ax::print("error buffer: %s", response->getErrorBuffer());
     }
 }
+
+// Sends sequential requests to a local server, e.g. `python -m http.server 8080 --protocol HTTP/1.1`,
+// once with new connections and once with kept-alive connections.
+static const char* KEEP_ALIVE_TEST_URL = "http://127.0.0.1:8080/";
+static const int KEEP_ALIVE_TEST_REQUESTS = 200;
+
+HttpClientKeepAliveTest::HttpClientKeepAliveTest()
+    : _keepAlive(false)
+    , _running(false)
+    , _sentRequests(0)
+    , _failedRequests(0)
+    , _totalLatency(0)
+    , _labelResults(nullptr)
+{
+    auto winSize = Director::getInstance()->getWinSize();
+
+    const int MARGIN = 40;
+    const int SPACE  = 35;
+    const int CENTER = winSize.width / 2;
+
+    auto menuRequest = Menu::create();
+    menuRequest->setPosition(Vec2::ZERO);
+    addChild(menuRequest);
+
+    auto labelRun = Label::createWithTTF("Run benchmark", "fonts/arial.ttf", 22);
+    auto itemRun  = MenuItemLabel::create(labelRun, AX_CALLBACK_1(HttpClientKeepAliveTest::onMenuRunClicked, this));
+    itemRun->setPosition(CENTER, winSize.height - MARGIN - 2 * SPACE);
+    menuRequest->addChild(itemRun);
+
+    _labelResults = Label::createWithTTF("", "fonts/arial.ttf", 16);
+    _labelResults->setPosition(CENTER, winSize.height - MARGIN - 5 * SPACE);
+    addChild(_labelResults);
+}
+
+HttpClientKeepAliveTest::~HttpClientKeepAliveTest()
+{
+    HttpClient::getInstance()->setKeepAliveEnabled(true);
+    HttpClient::destroyInstance();
+}
+
+std::string HttpClientKeepAliveTest::subtitle() const
+{
+    return fmt::format("{} requests to {}", KEEP_ALIVE_TEST_REQUESTS, KEEP_ALIVE_TEST_URL);
+}
+
+void HttpClientKeepAliveTest::onMenuRunClicked(ax::Object* sender)
+{
+    if (_running)
+        return;
+
+    _labelResults->setString("running...");
+    startRound(false);
+}
+
+void HttpClientKeepAliveTest::startRound(bool keepAlive)
+{
+    _keepAlive      = keepAlive;
+    _running        = true;
+    _sentRequests   = 0;
+    _failedRequests = 0;
+    _totalLatency   = 0;
+    HttpClient::getInstance()->setKeepAliveEnabled(keepAlive);
+
+    _roundStart = std::chrono::steady_clock::now();
+    sendNext();
+}
+
+void HttpClientKeepAliveTest::sendNext()
+{
+    HttpRequest* request = new HttpRequest();
+    request->setUrl(KEEP_ALIVE_TEST_URL);
+    request->setRequestType(HttpRequest::Type::GET);
+    request->setResponseCallback(AX_CALLBACK_2(HttpClientKeepAliveTest::onHttpRequestCompleted, this));
+    _requestStart = std::chrono::steady_clock::now();
+    HttpClient::getInstance()->send(request);
+    request->release();
+    ++_sentRequests;
+}
+
+void HttpClientKeepAliveTest::onHttpRequestCompleted(HttpClient* sender, HttpResponse* response)
+{
+    auto now = std::chrono::steady_clock::now();
+    _totalLatency += std::chrono::duration<double, std::milli>(now - _requestStart).count();
+    if (response->getResponseCode() != 200)
+        ++_failedRequests;
+
+    if (_sentRequests < KEEP_ALIVE_TEST_REQUESTS)
+    {
+        sendNext();
+        return;
+    }
+
+    auto seconds = std::chrono::duration<double>(now - _roundStart).count();
+    auto result  = fmt::format("{}: {:.2f} ms/request, {:.1f} requests/s, {} failed",
+                               _keepAlive ? "keep-alive" : "new connection", _totalLatency / _sentRequests,
+                               _sentRequests / seconds, _failedRequests);
+    ax::print("%s", result.c_str());
+
+    if (!_keepAlive)
+    {
+        _labelResults->setString(result);
+        startRound(true);
+    }
+    else
+    {
+        _labelResults->setString(fmt::format("{}\n{}", _labelResults->getString(), result));
+        _running = false;
+    }
+}
@@ -82,4 +82,35 @@ private:
     ax::Label* _labelStatusCode;
 };
 
+class HttpClientKeepAliveTest : public TestCase
+{
+public:
+    CREATE_FUNC(HttpClientKeepAliveTest);
+
+    HttpClientKeepAliveTest();
+    virtual ~HttpClientKeepAliveTest();
+
+    // Menu Callbacks
+    void onMenuRunClicked(ax::Object* sender);
+
+    // Http Response Callback
+    void onHttpRequestCompleted(ax::network::HttpClient* sender, ax::network::HttpResponse* response);
+
+    virtual std::string title() const override { return "Http Keep-Alive Benchmark"; }
+    virtual std::string subtitle() const override;
+
+private:
+    void startRound(bool keepAlive);
+    void sendNext();
+
+    bool _keepAlive;
+    bool _running;
+    int _sentRequests;
+    int _failedRequests;
+    std::chrono::steady_clock::time_point _roundStart;
+    std::chrono::steady_clock::time_point _requestStart;
+    double _totalLatency;
+    ax::Label* _labelResults;
+};
+
 #endif  //__HTTPREQUESTHTTP_H
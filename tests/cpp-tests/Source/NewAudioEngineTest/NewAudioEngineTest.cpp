@@ -50,6 +50,7 @@ AudioEngineTests::AudioEngineTests()
     ADD_TEST_CASE(AudioIssue16938Test);
     ADD_TEST_CASE(AudioPlayInFinishedCB);
     ADD_TEST_CASE(AudioUncacheInFinishedCB);
+    ADD_TEST_CASE(AudioCacheBudgetTest);
 
     ADD_TEST_CASE(AudioIssue18597Test);
     ADD_TEST_CASE(AudioIssue11143Test);
@@ -818,60 +819,6 @@ std::string AudioIssue11143Test::subtitle() const
     return "2 seconds after first sound play,you should hear another sound.";
 }
 
-// Enable profiles for this file
-#undef AX_PROFILER_DISPLAY_TIMERS
-#define AX_PROFILER_DISPLAY_TIMERS() Profiler::getInstance()->displayTimers()
-#undef AX_PROFILER_PURGE_ALL
-#define AX_PROFILER_PURGE_ALL() Profiler::getInstance()->releaseAllTimers()
-
-#undef AX_PROFILER_START
-#define AX_PROFILER_START(__name__) ProfilingBeginTimingBlock(__name__)
-#undef AX_PROFILER_STOP
-#define AX_PROFILER_STOP(__name__) ProfilingEndTimingBlock(__name__)
-#undef AX_PROFILER_RESET
-#define AX_PROFILER_RESET(__name__) ProfilingResetTimingBlock(__name__)
-
-#undef AX_PROFILER_START_CATEGORY
-#define AX_PROFILER_START_CATEGORY(__cat__, __name__) \
-    do                                                \
-    {                                                 \
-        if (__cat__)                                  \
-            ProfilingBeginTimingBlock(__name__);      \
-    } while (0)
-#undef AX_PROFILER_STOP_CATEGORY
-#define AX_PROFILER_STOP_CATEGORY(__cat__, __name__) \
-    do                                               \
-    {                                                \
-        if (__cat__)                                 \
-            ProfilingEndTimingBlock(__name__);       \
-    } while (0)
-#undef AX_PROFILER_RESET_CATEGORY
-#define AX_PROFILER_RESET_CATEGORY(__cat__, __name__) \
-    do                                                \
-    {                                                 \
-        if (__cat__)                                  \
-            ProfilingResetTimingBlock(__name__);      \
-    } while (0)
-
-#undef AX_PROFILER_START_INSTANCE
-#define AX_PROFILER_START_INSTANCE(__id__, __name__)                                                      \
-    do                                                                                                    \
-    {                                                                                                     \
-        ProfilingBeginTimingBlock(String::createWithFormat("%08X - %s", __id__, __name__)->getCString()); \
-    } while (0)
-#undef AX_PROFILER_STOP_INSTANCE
-#define AX_PROFILER_STOP_INSTANCE(__id__, __name__)                                                     \
-    do                                                                                                  \
-    {                                                                                                   \
-        ProfilingEndTimingBlock(String::createWithFormat("%08X - %s", __id__, __name__)->getCString()); \
-    } while (0)
-#undef AX_PROFILER_RESET_INSTANCE
-#define AX_PROFILER_RESET_INSTANCE(__id__, __name__)                                                      \
-    do                                                                                                    \
-    {                                                                                                     \
-        ProfilingResetTimingBlock(String::createWithFormat("%08X - %s", __id__, __name__)->getCString()); \
-    } while (0)
-
 bool AudioPerformanceTest::init()
 {
     if (AudioEngineTestDemo::init())
@@ -895,12 +842,13 @@ bool AudioPerformanceTest::init()
             static_cast<TextButton*>(getChildByName("DisplayButton"))->setEnabled(true);
 
             unschedule("test");
+            TraceRecorder::clear();
+            TraceRecorder::start();
             schedule(
                 [audioFiles](float dt) {
                     int index = ax::random(0, (int)(audioFiles.size() - 1));
-                    AX_PROFILER_START("play2d");
+                    AX_TRACE_SCOPE("AudioEngine::play2d");
                     AudioEngine::play2d(audioFiles[index]);
-                    AX_PROFILER_STOP("play2d");
                 },
                 0.25f, "test");
         });
@@ -911,7 +859,10 @@ bool AudioPerformanceTest::init()
         auto displayItem = TextButton::create("Display Result", [this, playItem](TextButton* button) {
             unschedule("test");
             AudioEngine::stopAll();
-            AX_PROFILER_DISPLAY_TIMERS();
+            TraceRecorder::stop();
+            auto path = FileUtils::getInstance()->getWritablePath() + "audio_performance_trace.json";
+            if (TraceRecorder::saveChromeTrace(path))
+                ax::print("Trace saved to %s", path.c_str());
             playItem->setEnabled(true);
             button->setEnabled(false);
         });
@@ -1235,3 +1186,75 @@ std::string AudioUncacheInFinishedCB::subtitle() const
 {
     return "Should not crash";
 }
+
+/////////////////////////////////////////////////////////////////////////
+namespace
+{
+const char* const CACHE_BUDGET_FILES[] = {
+    "audio/SoundEffectsFX009/FX081.mp3", "audio/SoundEffectsFX009/FX082.mp3", "audio/SoundEffectsFX009/FX083.mp3",
+    "audio/SoundEffectsFX009/FX084.mp3", "audio/SoundEffectsFX009/FX085.mp3", "audio/SoundEffectsFX009/FX086.mp3",
+    "audio/SoundEffectsFX009/FX087.mp3", "audio/SoundEffectsFX009/FX088.mp3", "audio/SoundEffectsFX009/FX089.mp3",
+    "audio/SoundEffectsFX009/FX090.mp3"};
+const size_t CACHE_BUDGET_BYTES = 256 * 1024;
+}  // namespace
+
+bool AudioCacheBudgetTest::init()
+{
+    auto ret = AudioEngineTestDemo::init();
+
+    AudioEngine::setCacheMode(AudioEngine::CacheMode::COMPRESSED);
+    AudioEngine::setCacheBudget(CACHE_BUDGET_BYTES);
+
+    auto preloadItem = TextButton::create("preload all", [](TextButton* button) {
+        for (auto file : CACHE_BUDGET_FILES)
+            AudioEngine::preload(file);
+    });
+    preloadItem->setPositionNormalized(Vec2(0.5f, 0.7f));
+    this->addChild(preloadItem);
+
+    auto playItem = TextButton::create("play next", [this](TextButton* button) {
+        AudioEngine::play2d(CACHE_BUDGET_FILES[_fileIndex]);
+        _fileIndex = (_fileIndex + 1) % AX_ARRAYSIZE(CACHE_BUDGET_FILES);
+    });
+    playItem->setPositionNormalized(Vec2(0.5f, 0.55f));
+    this->addChild(playItem);
+
+    _cacheLabel = Label::createWithTTF("", "fonts/arial.ttf", 16);
+    _cacheLabel->setPositionNormalized(Vec2(0.5f, 0.35f));
+    this->addChild(_cacheLabel);
+
+    this->schedule(AX_CALLBACK_1(AudioCacheBudgetTest::updateCacheInfo, this), 0.5f, "cache_info_key");
+
+    return ret;
+}
+
+void AudioCacheBudgetTest::updateCacheInfo(float dt)
+{
+    size_t pcmBytes = 0, compressedBytes = 0;
+    auto infos      = AudioEngine::getCacheInfos();
+    for (auto&& info : infos)
+    {
+        pcmBytes += info.pcmBytes;
+        compressedBytes += info.compressedBytes;
+    }
+    _cacheLabel->setString(fmt::format("files: {}\npcm: {} KB (budget {} KB)\ncompressed: {} KB", infos.size(),
+                                       pcmBytes / 1024, CACHE_BUDGET_BYTES / 1024, compressedBytes / 1024));
+}
+
+void AudioCacheBudgetTest::onExit()
+{
+    AudioEngineTestDemo::onExit();
+
+    AudioEngine::setCacheMode(AudioEngine::CacheMode::PCM);
+    AudioEngine::setCacheBudget(0);
+}
+
+std::string AudioCacheBudgetTest::title() const
+{
+    return "Audio cache budget";
+}
+
+std::string AudioCacheBudgetTest::subtitle() const
+{
+    return "PCM data should stay under the budget while playing";
+}
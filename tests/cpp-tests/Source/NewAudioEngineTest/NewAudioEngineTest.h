@@ -340,4 +340,22 @@ public:
 private:
 };
 
+class AudioCacheBudgetTest : public AudioEngineTestDemo
+{
+public:
+    CREATE_FUNC(AudioCacheBudgetTest);
+
+    virtual bool init() override;
+    virtual void onExit() override;
+
+    virtual std::string title() const override;
+    virtual std::string subtitle() const override;
+
+private:
+    void updateCacheInfo(float dt);
+
+    int _fileIndex = 0;
+    ax::Label* _cacheLabel = nullptr;
+};
+
 #endif /* defined(__NEWAUDIOENGINE_TEST_H_) */
@@ -65,6 +65,7 @@ Physics3DTests::Physics3DTests()
     ADD_TEST_CASE(Physics3DCollisionCallbackDemo);
     ADD_TEST_CASE(Physics3DColliderDemo);
     ADD_TEST_CASE(Physics3DTerrainDemo);
+    ADD_TEST_CASE(Physics3DMultiThreadDemo);
 #endif
 };
 
@@ -97,7 +98,7 @@ bool Physics3DTestDemo::init()
     if (!TestCase::init())
         return false;
 
-    if (initWithPhysics())
+    if (initWithPhysics(&_worldDes))
     {
         getPhysics3DWorld()->setDebugDrawEnable(false);
 
@@ -882,4 +883,94 @@ bool Physics3DColliderDemo::init()
     return true;
 }
 
+Physics3DMultiThreadDemo::Physics3DMultiThreadDemo()
+{
+    _worldDes.isMultiThreadingEnabled = true;
+}
+
+std::string Physics3DMultiThreadDemo::subtitle() const
+{
+    return "Multithreaded world, 1000 boxes";
+}
+
+bool Physics3DMultiThreadDemo::init()
+{
+    if (!Physics3DTestDemo::init())
+        return false;
+
+    Physics3DRigidBodyDes rbDes;
+    rbDes.mass = 0.0f;
+    rbDes.shape = Physics3DShape::createBox(Vec3(60.0f, 1.0f, 60.0f));
+
+    auto floor = PhysicsMeshRenderer::create("MeshRendererTest/box.c3t", &rbDes);
+    floor->setTexture("MeshRendererTest/plane.png");
+    floor->setScaleX(60);
+    floor->setScaleZ(60);
+    this->addChild(floor);
+    floor->setCameraMask((unsigned short)CameraFlag::USER1);
+    floor->syncNodeToPhysics();
+    floor->setSyncFlag(Physics3DComponent::PhysicsSyncFlag::NONE);
+
+    rbDes.mass = 1.f;
+    rbDes.shape = Physics3DShape::createBox(Vec3(0.8f, 0.8f, 0.8f));
+    for (int k = 0; k < 10; k++)
+    {
+        for (int i = 0; i < 10; i++)
+        {
+            for (int j = 0; j < 10; j++)
+            {
+                auto mesh = PhysicsMeshRenderer::create("MeshRendererTest/box.c3t", &rbDes);
+                mesh->setTexture("Images/CyanSquare.png");
+                mesh->setPosition3D(Vec3(1.0f * i - 5.0f, 5.0f + 1.0f * k, 1.0f * j - 5.0f));
+                mesh->syncNodeToPhysics();
+                mesh->setSyncFlag(Physics3DComponent::PhysicsSyncFlag::PHYSICS_TO_NODE);
+                mesh->setCameraMask((unsigned short)CameraFlag::USER1);
+                mesh->setScale(0.8f);
+                this->addChild(mesh);
+            }
+        }
+    }
+
+    TTFConfig ttfConfig("fonts/arial.ttf", 10);
+    auto label    = Label::createWithTTF(ttfConfig, "Async step OFF");
+    auto menuItem = MenuItemLabel::create(label, [=](Object* /*ref*/) {
+        auto world = getPhysics3DWorld();
+        world->setAsyncStepEnabled(!world->isAsyncStepEnabled());
+        label->setString(world->isAsyncStepEnabled() ? "Async step ON" : "Async step OFF");
+    });
+    auto menu = Menu::create(menuItem, nullptr);
+    menu->setPosition(Vec2::ZERO);
+    menuItem->setAnchorPoint(Vec2::ANCHOR_TOP_LEFT);
+    menuItem->setPosition(Vec2(VisibleRect::left().x, VisibleRect::top().y - 70));
+    this->addChild(menu);
+
+    _statsLabel = Label::createWithTTF(ttfConfig, "");
+    _statsLabel->setAnchorPoint(Vec2::ANCHOR_TOP_LEFT);
+    _statsLabel->setPosition(Vec2(VisibleRect::left().x, VisibleRect::top().y - 90));
+    this->addChild(_statsLabel);
+    schedule(AX_SCHEDULE_SELECTOR(Physics3DMultiThreadDemo::updateStats));
+
+    physicsScene->setPhysics3DDebugCamera(_camera);
+    return true;
+}
+
+void Physics3DMultiThreadDemo::onExit()
+{
+    getPhysics3DWorld()->setAsyncStepEnabled(false);
+    Physics3DTestDemo::onExit();
+}
+
+void Physics3DMultiThreadDemo::updateStats(float dt)
+{
+    _frameTime += dt;
+    if (++_frameCount == 60)
+    {
+        _statsLabel->setString(StringUtils::format("multithreaded: %s, frame: %.3f ms",
+                                                   getPhysics3DWorld()->isMultiThreadingEnabled() ? "yes" : "no",
+                                                   _frameTime * 1000.0f / _frameCount));
+        _frameTime  = 0.0f;
+        _frameCount = 0;
+    }
+}
+
 #endif
@@ -27,6 +27,7 @@
 #define _PHYSICS3D_TEST_H_
 
 #include "../BaseTest.h"
+#include "physics3d/Physics3DWorld.h"
 #include <string>
 
 NS_AX_BEGIN
@@ -69,6 +70,7 @@ protected:
 
 protected:
     std::string _title;
+    ax::Physics3DWorldDes _worldDes;
     ax::Camera* _camera = nullptr;
     float _angle             = 0.f;
     bool _needShootBox       = false;
@@ -158,6 +160,26 @@ public:
 private:
 };
 
+class Physics3DMultiThreadDemo : public Physics3DTestDemo
+{
+public:
+    CREATE_FUNC(Physics3DMultiThreadDemo);
+    Physics3DMultiThreadDemo();
+    virtual ~Physics3DMultiThreadDemo(){};
+
+    virtual std::string subtitle() const override;
+
+    virtual bool init() override;
+    virtual void onExit() override;
+
+private:
+    void updateStats(float dt);
+
+    ax::Label* _statsLabel = nullptr;
+    float _frameTime       = 0.0f;
+    int _frameCount        = 0;
+};
+
 #endif
 
 #endif
@@ -54,6 +54,8 @@ PhysicsTests::PhysicsTests()
     ADD_TEST_CASE(PhysicsIssue9959);
     ADD_TEST_CASE(PhysicsIssue15932);
     ADD_TEST_CASE(PhysicsDemoPyramidStackFixedUpdate);
+    ADD_TEST_CASE(PhysicsContactBatchTest);
+    ADD_TEST_CASE(PhysicsSolverThreadsTest);
 }
 
 namespace
@@ -2022,4 +2024,187 @@ void PhysicsDemoPyramidStackFixedUpdate::fixedUpdate(float delta)
     }
 }
 
+void PhysicsContactBatchTest::onEnter()
+{
+    PhysicsDemo::onEnter();
+
+    auto wall = Node::create();
+    wall->addComponent(
+        PhysicsBody::createEdgeBox(VisibleRect::getVisibleRect().size, PhysicsMaterial(0.1f, 1.0f, 0.0f)));
+    wall->setPosition(VisibleRect::center());
+    addChild(wall);
+
+    // lots of bouncing balls which all report their contacts
+    auto size = VisibleRect::getVisibleRect().size;
+    for (int i = 0; i < 1000; ++i)
+    {
+        auto pos  = VisibleRect::leftBottom() + Vec2(20 + AXRANDOM_0_1() * (size.width - 40),
+                                                     20 + AXRANDOM_0_1() * (size.height - 40));
+        auto ball = makeBall(pos, 1.0f, PhysicsMaterial(0.1f, 1.0f, 0.0f));
+        auto body = ball->getPhysicsBody();
+        body->setVelocity(Vec2(AXRANDOM_MINUS1_1() * 200, AXRANDOM_MINUS1_1() * 200));
+        body->setContactTestBitmask(0xFFFFFFFF);
+        addChild(ball);
+    }
+
+    _contactListener                 = EventListenerPhysicsContact::create();
+    _contactListener->onContactBegin = [this](PhysicsContact& contact) {
+        ++_contactCount;
+        return true;
+    };
+    _contactListener->retain();
+
+    MenuItemFont::setFontSize(18);
+    auto item =
+        MenuItemFont::create("Toggle batched contacts", AX_CALLBACK_1(PhysicsContactBatchTest::toggleBatchCallback, this));
+    auto menu = Menu::create(item, nullptr);
+    menu->setPosition(Vec2(VisibleRect::left().x + 120, VisibleRect::top().y - 40));
+    addChild(menu);
+
+    _statsLabel = Label::createWithTTF("", "fonts/arial.ttf", 16);
+    _statsLabel->setPosition(VisibleRect::center());
+    addChild(_statsLabel, 10);
+
+    _physicsWorld->setGravity(Vec2::ZERO);
+    setBatched(true);
+    scheduleUpdate();
+}
+
+void PhysicsContactBatchTest::onExit()
+{
+    _physicsWorld->removeContactBatchHandler(_batchHandlerId);
+    _physicsWorld->setContactEventDispatchEnabled(true);
+    _eventDispatcher->removeEventListener(_contactListener);
+    AX_SAFE_RELEASE_NULL(_contactListener);
+    PhysicsDemo::onExit();
+}
+
+void PhysicsContactBatchTest::setBatched(bool batched)
+{
+    _batched = batched;
+    if (batched)
+    {
+        _eventDispatcher->removeEventListener(_contactListener);
+        _physicsWorld->setContactEventDispatchEnabled(false);
+        _batchHandlerId = _physicsWorld->addContactBatchHandler(
+            [this](PhysicsWorld& world, const PhysicsContactRecord* records, size_t count) {
+            _contactCount += static_cast<int>(count);
+        },
+            PhysicsWorld::CONTACT_EVENT_BEGIN);
+    }
+    else
+    {
+        _physicsWorld->removeContactBatchHandler(_batchHandlerId);
+        _physicsWorld->setContactEventDispatchEnabled(true);
+        _eventDispatcher->addEventListenerWithSceneGraphPriority(_contactListener, this);
+    }
+}
+
+void PhysicsContactBatchTest::toggleBatchCallback(Object* sender)
+{
+    setBatched(!_batched);
+}
+
+void PhysicsContactBatchTest::update(float delta)
+{
+    _statsLabel->setString(
+        StringUtils::format("%s: %d contacts", _batched ? "batched" : "event listener", _contactCount));
+    _contactCount = 0;
+}
+
+std::string PhysicsContactBatchTest::title() const
+{
+    return "Batched contacts";
+}
+
+std::string PhysicsContactBatchTest::subtitle() const
+{
+    return "Compare the frame time of batched contacts and the event listener";
+}
+
+void PhysicsSolverThreadsTest::onEnter()
+{
+    PhysicsDemo::onEnter();
+
+    auto wall = Node::create();
+    wall->addComponent(PhysicsBody::createEdgeBox(VisibleRect::getVisibleRect().size));
+    wall->setPosition(VisibleRect::center());
+    addChild(wall);
+
+    for (int i = 0; i < 40; ++i)
+    {
+        for (int j = 0; j < 30; ++j)
+        {
+            auto box = makeBox(VisibleRect::leftBottom() + Vec2(60 + i * 9.0f + (j % 2) * 4.0f, 20 + j * 9.0f),
+                               Size(8, 8));
+            addChild(box);
+        }
+    }
+
+    // a fixed rate below the frame rate makes the interpolation visible
+    _physicsWorld->setFixedUpdateRate(30);
+    _physicsWorld->setPreUpdateCallback([this]() { _stepStart = std::chrono::steady_clock::now(); });
+    _physicsWorld->setPostUpdateCallback([this]() {
+        _stepTime += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - _stepStart).count();
+        if (++_stepCount == 60)
+            updateStats();
+    });
+
+    MenuItemFont::setFontSize(18);
+    auto threadsItem = MenuItemFont::create("Solver threads", [this](Object* sender) {
+        static const int threadCounts[] = {0, 1, 2, 4};
+        int index                       = 0;
+        while (threadCounts[index] != _physicsWorld->getSolverThreads())
+            ++index;
+        _physicsWorld->setSolverThreads(threadCounts[(index + 1) % AX_ARRAYSIZE(threadCounts)]);
+    });
+    auto interpolationItem = MenuItemFont::create("Interpolation", [this](Object* sender) {
+        _physicsWorld->setInterpolationEnabled(!_physicsWorld->isInterpolationEnabled());
+    });
+    auto deterministicItem = MenuItemFont::create("Deterministic", [this](Object* sender) {
+        _physicsWorld->setDeterministic(!_physicsWorld->isDeterministic());
+    });
+    auto menu = Menu::create(threadsItem, interpolationItem, deterministicItem, nullptr);
+    menu->alignItemsVertically();
+    menu->setPosition(Vec2(VisibleRect::left().x + 100, VisibleRect::top().y - 80));
+    addChild(menu);
+
+    _statsLabel = Label::createWithTTF("", "fonts/arial.ttf", 16);
+    _statsLabel->setPosition(VisibleRect::center() + Vec2(0.0f, 100.0f));
+    addChild(_statsLabel, 10);
+}
+
+void PhysicsSolverThreadsTest::onExit()
+{
+    _physicsWorld->setPreUpdateCallback(nullptr);
+    _physicsWorld->setPostUpdateCallback(nullptr);
+    _physicsWorld->setDeterministic(false);
+    _physicsWorld->setInterpolationEnabled(false);
+    _physicsWorld->setSolverThreads(0);
+    _physicsWorld->setFixedUpdateRate(0);
+    PhysicsDemo::onExit();
+}
+
+void PhysicsSolverThreadsTest::updateStats()
+{
+    auto threads = _physicsWorld->getSolverThreads();
+    _statsLabel->setString(StringUtils::format(
+        "threads: %s, interpolation: %s, deterministic: %s\nupdate: %.3f ms",
+        _physicsWorld->isDeterministic() ? "1" : (threads == 0 ? "auto" : std::to_string(threads).c_str()),
+        _physicsWorld->isInterpolationEnabled() ? "on" : "off", _physicsWorld->isDeterministic() ? "on" : "off",
+        _stepTime / _stepCount));
+    _stepTime  = 0.0;
+    _stepCount = 0;
+}
+
+std::string PhysicsSolverThreadsTest::title() const
+{
+    return "Solver threads";
+}
+
+std::string PhysicsSolverThreadsTest::subtitle() const
+{
+    return "1200 boxes, fixed rate 30, average physics update time";
+}
+
 #endif
@@ -324,4 +324,46 @@ private:
     float _delayTime;
 };
 
+class PhysicsContactBatchTest : public PhysicsDemo
+{
+public:
+    CREATE_FUNC(PhysicsContactBatchTest);
+
+    void onEnter() override;
+    void onExit() override;
+    void update(float delta) override;
+    virtual std::string title() const override;
+    virtual std::string subtitle() const override;
+
+    void toggleBatchCallback(ax::Object* sender);
+
+private:
+    void setBatched(bool batched);
+
+    ax::Label* _statsLabel = nullptr;
+    ax::EventListenerPhysicsContact* _contactListener = nullptr;
+    int _batchHandlerId = 0;
+    int _contactCount   = 0;
+    bool _batched       = false;
+};
+
+class PhysicsSolverThreadsTest : public PhysicsDemo
+{
+public:
+    CREATE_FUNC(PhysicsSolverThreadsTest);
+
+    void onEnter() override;
+    void onExit() override;
+    virtual std::string title() const override;
+    virtual std::string subtitle() const override;
+
+private:
+    void updateStats();
+
+    ax::Label* _statsLabel = nullptr;
+    std::chrono::steady_clock::time_point _stepStart;
+    double _stepTime = 0.0;
+    int _stepCount   = 0;
+};
+
 #endif  // #if defined(AX_ENABLE_PHYSICS)
@@ -62,6 +62,7 @@ SchedulerTests::SchedulerTests()
     ADD_TEST_CASE(SchedulerIssue17149);
     ADD_TEST_CASE(SchedulerRemoveEntryWhileUpdate);
     ADD_TEST_CASE(SchedulerRemoveSelectorDuringCall);
+    ADD_TEST_CASE(SchedulerIdleTimersBenchmark);
 };
 
 //------------------------------------------------------------------
@@ -1455,3 +1456,78 @@ void SchedulerRemoveSelectorDuringCall::callback(float)
     Scheduler* const scheduler(Director::getInstance()->getScheduler());
     scheduler->unschedule(SEL_SCHEDULE(&SchedulerRemoveSelectorDuringCall::callback), this);
 }
+
+//------------------------------------------------------------------
+//
+// SchedulerIdleTimersBenchmark
+//
+//------------------------------------------------------------------
+
+std::string SchedulerIdleTimersBenchmark::title() const
+{
+    return "100k idle timers";
+}
+
+std::string SchedulerIdleTimersBenchmark::subtitle() const
+{
+    return "Compare Scheduler::update time with the timer queue on and off";
+}
+
+void SchedulerIdleTimersBenchmark::onEnter()
+{
+    SchedulerTestLayer::onEnter();
+
+    auto director  = Director::getInstance();
+    auto scheduler = director->getScheduler();
+
+    // cooldowns of 10 to 60 seconds, none of them triggers while the test runs
+    _targets.resize(100000);
+    for (size_t i = 0; i < _targets.size(); ++i)
+        scheduler->schedule([](float) {}, &_targets[i], 10.0f + (i % 500) * 0.1f, false, "idle");
+
+    auto eventDispatcher  = director->getEventDispatcher();
+    _beforeUpdateListener = eventDispatcher->addCustomEventListener(
+        Director::EVENT_BEFORE_UPDATE, [this](EventCustom*) { _updateStart = std::chrono::steady_clock::now(); });
+    _afterUpdateListener = eventDispatcher->addCustomEventListener(Director::EVENT_AFTER_UPDATE, [this](EventCustom*) {
+        _updateTime +=
+            std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - _updateStart).count();
+        if (++_updateCount == 60)
+            updateStats();
+    });
+
+    MenuItemFont::setFontSize(18);
+    auto item = MenuItemFont::create("Toggle timer queue", [scheduler](Object*) {
+        scheduler->setTimerQueueEnabled(!scheduler->isTimerQueueEnabled());
+    });
+    auto menu = Menu::create(item, nullptr);
+    menu->setPosition(VisibleRect::center() + Vec2(0.0f, -60.0f));
+    addChild(menu);
+
+    _statsLabel = Label::createWithTTF("", "fonts/arial.ttf", 16);
+    _statsLabel->setPosition(VisibleRect::center() + Vec2(0.0f, 20.0f));
+    addChild(_statsLabel);
+}
+
+void SchedulerIdleTimersBenchmark::onExit()
+{
+    auto director  = Director::getInstance();
+    auto scheduler = director->getScheduler();
+    director->getEventDispatcher()->removeEventListener(_beforeUpdateListener);
+    director->getEventDispatcher()->removeEventListener(_afterUpdateListener);
+    for (auto& target : _targets)
+        scheduler->unschedule("idle", &target);
+    _targets.clear();
+    scheduler->setTimerQueueEnabled(false);
+
+    SchedulerTestLayer::onExit();
+}
+
+void SchedulerIdleTimersBenchmark::updateStats()
+{
+    _statsLabel->setString(
+        StringUtils::format("timer queue: %s\nScheduler::update: %.3f ms",
+                            Director::getInstance()->getScheduler()->isTimerQueueEnabled() ? "on" : "off",
+                            _updateTime / _updateCount));
+    _updateTime  = 0.0;
+    _updateCount = 0;
+}
@@ -461,4 +461,26 @@ private:
     bool _scheduled;
 };
 
+class SchedulerIdleTimersBenchmark : public SchedulerTestLayer
+{
+public:
+    CREATE_FUNC(SchedulerIdleTimersBenchmark);
+
+    virtual std::string title() const override;
+    virtual std::string subtitle() const override;
+    virtual void onEnter() override;
+    virtual void onExit() override;
+
+private:
+    void updateStats();
+
+    std::vector<char> _targets;
+    ax::Label* _statsLabel                         = nullptr;
+    ax::EventListenerCustom* _beforeUpdateListener = nullptr;
+    ax::EventListenerCustom* _afterUpdateListener  = nullptr;
+    std::chrono::steady_clock::time_point _updateStart;
+    double _updateTime = 0.0;
+    int _updateCount   = 0;
+};
+
 #endif
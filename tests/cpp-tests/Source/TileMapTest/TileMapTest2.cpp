@@ -68,6 +68,7 @@ FastTileMapTests::FastTileMapTests()
     ADD_TEST_CASE(TMXGIDObjectsTestNew);
     ADD_TEST_CASE(TileAnimTestNew);
     ADD_TEST_CASE(TileAnimTestNew2);
+    ADD_TEST_CASE(TMXChunkedTestNew);
 }
 
 TileDemoNew::TileDemoNew()
@@ -1431,3 +1432,42 @@ void TileAnimTestNew2::onTouchBegan(const std::vector<ax::Touch*>& touches, ax::
     _animStarted = !_animStarted;
     map->setTileAnimEnabled(_animStarted);
 }
+
+//------------------------------------------------------------------
+//
+// TMXChunkedTestNew
+//
+//------------------------------------------------------------------
+TMXChunkedTestNew::TMXChunkedTestNew()
+{
+    // the test may be left before the map is loaded
+    retain();
+    FastTMXTiledMap::createAsync(
+        "TileMaps/orthogonal-test2.tmx",
+        [this](FastTMXTiledMap* map) {
+            if (map && isRunning())
+            {
+                addChild(map, 0, kTagTileMap);
+                for (auto&& layer : map->getLayers())
+                    layer->setMaxResidentChunks(16);
+
+                auto scale  = ScaleBy::create(10, 0.1f);
+                auto back   = scale->reverse();
+                auto seq    = Sequence::create(scale, back, nullptr);
+                auto repeat = RepeatForever::create(seq);
+                map->runAction(repeat);
+            }
+            release();
+        },
+        8);
+}
+
+std::string TMXChunkedTestNew::title() const
+{
+    return "TMX chunked layers";
+}
+
+std::string TMXChunkedTestNew::subtitle() const
+{
+    return "Loaded in the background, 8x8 tiles chunks are built when they get close";
+}
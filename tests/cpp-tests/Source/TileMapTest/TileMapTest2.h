@@ -363,4 +363,13 @@ public:
     void onTouchBegan(const std::vector<ax::Touch*>& touches, ax::Event* event);
 };
 
+class TMXChunkedTestNew : public TileDemoNew
+{
+public:
+    CREATE_FUNC(TMXChunkedTestNew);
+    TMXChunkedTestNew();
+    virtual std::string title() const override;
+    virtual std::string subtitle() const override;
+};
+
 #endif
@@ -41,6 +41,7 @@ UIListViewTests::UIListViewTests()
     ADD_TEST_CASE(UIListViewTest_PaddingHorizontal);
     ADD_TEST_CASE(Issue12692);
     ADD_TEST_CASE(Issue8316);
+    ADD_TEST_CASE(UIListViewTest_Virtualized);
 }
 
 // UIListViewTest_Vertical
@@ -1058,3 +1059,92 @@ void UIListViewTest_Padding::sliderEvent(Object* pSender, Slider::EventType type
         }
     }
 }
+
+// UIListViewTest_Virtualized
+
+bool UIListViewTest_Virtualized::init()
+{
+    if (!UIScene::init())
+    {
+        return false;
+    }
+
+    Size layerSize = _uiLayer->getContentSize();
+
+    auto title = Text::create("10000 items of varying heights", "fonts/Marker Felt.ttf", 24);
+    title->setAnchorPoint(Vec2::ANCHOR_MIDDLE);
+    title->setPosition(Vec2(layerSize / 2) + Vec2(0.0f, title->getContentSize().height * 4.0f));
+    _uiLayer->addChild(title, 3);
+
+    _statusLabel = Text::create(" ", "fonts/Marker Felt.ttf", 14);
+    _statusLabel->setAnchorPoint(Vec2::ANCHOR_MIDDLE);
+    _statusLabel->setPosition(Vec2(layerSize.width / 2, layerSize.height / 2 - 90.0f));
+    _uiLayer->addChild(_statusLabel, 3);
+
+    _listView = ListView::create();
+    _listView->setDirection(ScrollView::Direction::VERTICAL);
+    _listView->setBounceEnabled(true);
+    _listView->setBackGroundImage("cocosui/green_edit.png");
+    _listView->setBackGroundImageScale9Enabled(true);
+    _listView->setContentSize(Size(240.0f, 130.0f));
+    _listView->setScrollBarPositionFromCorner(Vec2(7, 7));
+    _listView->setItemsMargin(2.0f);
+    _listView->setPadding(4.0f, 4.0f, 4.0f, 4.0f);
+    _listView->setGravity(ListView::Gravity::CENTER_HORIZONTAL);
+    _listView->setAnchorPoint(Vec2::ANCHOR_MIDDLE);
+    _listView->setPosition(layerSize / 2);
+    _uiLayer->addChild(_listView);
+
+    auto itemSize = [](ssize_t index) { return 24.0f + (index % 5) * 8.0f; };
+
+    ListView::DataSource dataSource;
+    dataSource.getItemCount = []() { return ssize_t(10000); };
+    dataSource.getItemSize  = itemSize;
+    dataSource.createItem   = [this]() {
+        ++_createdCount;
+        auto button = Button::create("cocosui/backtotopnormal.png", "cocosui/backtotoppressed.png");
+        button->setScale9Enabled(true);
+        return button;
+    };
+    dataSource.bindItem = [this, itemSize](Widget* item, ssize_t index) {
+        ++_boundCount;
+        auto button = static_cast<Button*>(item);
+        button->setContentSize(Size(200.0f, itemSize(index)));
+        button->setTitleText(StringUtils::format("Item %d", static_cast<int>(index)));
+    };
+    _listView->setDataSource(std::move(dataSource));
+
+    _listView->ScrollView::addEventListener([this](Object*, ScrollView::EventType eventType) {
+        if (eventType == ScrollView::EventType::CONTAINER_MOVED)
+            updateStatus();
+    });
+
+    auto jumpButton = Button::create("cocosui/button.png", "cocosui/buttonHighlighted.png");
+    jumpButton->setTitleText("Jump to 5000");
+    jumpButton->setPosition(Vec2(layerSize.width / 2 + 180.0f, layerSize.height / 2 + 30.0f));
+    jumpButton->addClickEventListener([this](Object*) {
+        _listView->jumpToItem(5000, Vec2::ANCHOR_MIDDLE_TOP, Vec2::ANCHOR_MIDDLE_TOP);
+        updateStatus();
+    });
+    _uiLayer->addChild(jumpButton);
+
+    auto reloadButton = Button::create("cocosui/button.png", "cocosui/buttonHighlighted.png");
+    reloadButton->setTitleText("Reload");
+    reloadButton->setPosition(Vec2(layerSize.width / 2 + 180.0f, layerSize.height / 2 - 30.0f));
+    reloadButton->addClickEventListener([this](Object*) {
+        _listView->reloadData();
+        updateStatus();
+    });
+    _uiLayer->addChild(reloadButton);
+
+    _listView->doLayout();
+    updateStatus();
+
+    return true;
+}
+
+void UIListViewTest_Virtualized::updateStatus()
+{
+    // the created widgets stay few however far the list is scrolled
+    _statusLabel->setString(StringUtils::format("widgets created: %d, items bound: %d", _createdCount, _boundCount));
+}
@@ -219,4 +219,21 @@ public:
     }
 };
 
+// Test for a ListView driven by a data source, only the visible items get widgets
+class UIListViewTest_Virtualized : public UIScene
+{
+public:
+    CREATE_FUNC(UIListViewTest_Virtualized);
+
+    virtual bool init() override;
+
+protected:
+    void updateStatus();
+
+    ax::ui::ListView* _listView = nullptr;
+    ax::ui::Text* _statusLabel  = nullptr;
+    int _createdCount           = 0;
+    int _boundCount             = 0;
+};
+
 #endif /* defined(__TestCpp__UIListViewTest__) */
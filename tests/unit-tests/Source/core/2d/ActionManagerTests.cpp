@@ -0,0 +1,119 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+
+
+#include <doctest.h>
+#include "2d/ActionEase.h"
+#include "2d/ActionInterval.h"
+#include "2d/ActionManager.h"
+#include "2d/Node.h"
+
+USING_NS_AX;
+
+static bool sameVec3(const Vec3& a, const Vec3& b)
+{
+    return a.distance(b) < 0.001f;
+}
+
+static bool sameState(const Node* a, const Node* b)
+{
+    return sameVec3(a->getPosition3D(), b->getPosition3D()) &&
+           sameVec3(Vec3(a->getScaleX(), a->getScaleY(), a->getScaleZ()),
+                    Vec3(b->getScaleX(), b->getScaleY(), b->getScaleZ())) &&
+           sameVec3(a->getRotation3D(), b->getRotation3D()) &&
+           std::abs(a->getRotationSkewX() - b->getRotationSkewX()) < 0.001f &&
+           std::abs(a->getRotationSkewY() - b->getRotationSkewY()) < 0.001f && a->getOpacity() == b->getOpacity() &&
+           a->getColor() == b->getColor();
+}
+
+TEST_SUITE("2d/ActionManager") {
+    TEST_CASE("tween_batching") {
+        auto stepped = new ActionManager();
+        auto batched = new ActionManager();
+        batched->setTweenBatchingEnabled(true);
+
+        auto a = Node::create();
+        auto b = Node::create();
+
+        auto run = [&](Action* action) {
+            stepped->addAction(action, a, false);
+            batched->addAction(action->clone(), b, false);
+        };
+        run(MoveBy::create(1.0f, Vec2(100, 0)));
+        run(EaseBounceOut::create(MoveBy::create(0.5f, Vec2(0, 50))));
+        run(EaseSineInOut::create(ScaleTo::create(0.75f, 2.0f, 3.0f)));
+        run(FadeOut::create(0.6f));
+        run(EaseBackOut::create(RotateTo::create(0.8f, 90.0f, 45.0f)));
+        // not batched, still stepped alongside the batched tweens
+        run(TintTo::create(0.4f, Color3B::RED));
+
+        SUBCASE("same_as_step") {
+            for (int frame = 0; frame < 70; ++frame)
+            {
+                stepped->update(1.0f / 60);
+                batched->update(1.0f / 60);
+                REQUIRE(sameState(a, b));
+                REQUIRE(stepped->getNumberOfRunningActions() == batched->getNumberOfRunningActions());
+            }
+            CHECK(batched->getNumberOfRunningActions() == 0);
+            CHECK(sameVec3(b->getPosition3D(), Vec3(100, 50, 0)));
+            CHECK(b->getOpacity() == 0);
+        }
+
+        SUBCASE("pause_and_remove") {
+            stepped->update(1.0f / 60);
+            batched->update(1.0f / 60);
+
+            stepped->pauseTarget(a);
+            batched->pauseTarget(b);
+            batched->update(1.0f / 60);
+            CHECK(sameState(a, b));
+
+            stepped->resumeTarget(a);
+            batched->resumeTarget(b);
+            stepped->removeAction(stepped->getActionByTag(Action::INVALID_TAG, a));
+            batched->removeAction(batched->getActionByTag(Action::INVALID_TAG, b));
+            for (int frame = 0; frame < 20; ++frame)
+            {
+                stepped->update(1.0f / 60);
+                batched->update(1.0f / 60);
+            }
+            CHECK(sameState(a, b));
+
+            // the remaining tweens carry on with Action::step
+            batched->setTweenBatchingEnabled(false);
+            for (int frame = 0; frame < 50; ++frame)
+            {
+                stepped->update(1.0f / 60);
+                batched->update(1.0f / 60);
+                REQUIRE(sameState(a, b));
+            }
+            CHECK(batched->getNumberOfRunningActions() == 0);
+        }
+
+        stepped->release();
+        batched->release();
+    }
+}
@@ -0,0 +1,135 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+
+#include <doctest.h>
+#include "2d/Node.h"
+#include "base/Director.h"
+
+USING_NS_AX;
+
+static bool sameRect(const Rect& a, const Rect& b)
+{
+    return a.origin.fuzzyEquals(b.origin, 0.001f) && a.size.fuzzyEquals(b.size, 0.001f);
+}
+
+namespace {
+    class DrawnTransformNode : public Node {
+    public:
+        static DrawnTransformNode* create() {
+            auto node = new DrawnTransformNode();
+            node->autorelease();
+            return node;
+        }
+
+        void draw(Renderer*, const Mat4& transform, uint32_t) override {
+            drawnTransform = transform;
+        }
+
+        Mat4 drawnTransform;
+    };
+}
+
+TEST_SUITE("2d/Node") {
+    TEST_CASE("subtree_bounds") {
+        auto root = Node::create();
+        root->setContentSize(Vec2(10, 10));
+        root->setSubtreeCullingEnabled(true);
+        CHECK(sameRect(root->getSubtreeBounds(), Rect(0, 0, 10, 10)));
+
+        auto child = Node::create();
+        child->setContentSize(Vec2(20, 20));
+        child->setPosition(100, 50);
+        root->addChild(child);
+        CHECK(sameRect(root->getSubtreeBounds(), Rect(0, 0, 120, 70)));
+
+        SUBCASE("descendant_changes") {
+            child->setPosition(-10, 0);
+            CHECK(sameRect(root->getSubtreeBounds(), Rect(-10, 0, 20, 20)));
+
+            auto grandChild = Node::create();
+            grandChild->setContentSize(Vec2(1, 1));
+            grandChild->setPosition(0, 100);
+            child->addChild(grandChild);
+            CHECK(sameRect(root->getSubtreeBounds(), Rect(-10, 0, 20, 101)));
+
+            child->setScale(2);
+            CHECK(sameRect(root->getSubtreeBounds(), Rect(-10, 0, 40, 202)));
+
+            grandChild->removeFromParent();
+            CHECK(sameRect(root->getSubtreeBounds(), Rect(-10, 0, 40, 40)));
+        }
+
+        SUBCASE("own_transform") {
+            root->setPosition(500, 500);
+            root->setRotation(45);
+            CHECK(sameRect(root->getSubtreeBounds(), Rect(0, 0, 120, 70)));
+        }
+
+        SUBCASE("nested") {
+            child->setSubtreeCullingEnabled(true);
+            auto grandChild = Node::create();
+            grandChild->setContentSize(Vec2(5, 5));
+            grandChild->setPosition(20, 20);
+            child->addChild(grandChild);
+            CHECK(sameRect(child->getSubtreeBounds(), Rect(0, 0, 25, 25)));
+            CHECK(sameRect(root->getSubtreeBounds(), Rect(0, 0, 125, 75)));
+
+            grandChild->setPosition(30, 20);
+            CHECK(sameRect(root->getSubtreeBounds(), Rect(0, 0, 135, 75)));
+        }
+    }
+
+    TEST_CASE("transform_pass") {
+        auto renderer = Director::getInstance()->getRenderer();
+        Mat4 rootTransform;
+
+        auto parent = Node::create();
+        auto child = DrawnTransformNode::create();
+        child->setPosition(10, 0);
+        parent->addChild(child);
+
+        // nothing is dirty when the pass runs
+        parent->visit(renderer, rootTransform, 0);
+        parent->prepareTransforms(rootTransform, 0);
+
+        SUBCASE("prepared") {
+            parent->visit(renderer, rootTransform, 0);
+            CHECK(child->drawnTransform.m[12] == doctest::Approx(10));
+        }
+
+        SUBCASE("parent_moved_after_pass") {
+            parent->setPosition(100, 0);
+            parent->visit(renderer, rootTransform, 0);
+            CHECK(child->drawnTransform.m[12] == doctest::Approx(110));
+        }
+
+        SUBCASE("dirtied_by_visit") {
+            rootTransform.translate(0, 50, 0);
+            parent->visit(renderer, rootTransform, Node::FLAGS_TRANSFORM_DIRTY);
+            CHECK(child->drawnTransform.m[12] == doctest::Approx(10));
+            CHECK(child->drawnTransform.m[13] == doctest::Approx(50));
+        }
+    }
+}
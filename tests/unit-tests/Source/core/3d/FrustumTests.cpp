@@ -0,0 +1,76 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include <doctest.h>
+#include <memory>
+#include <random>
+#include <vector>
+#include "2d/Camera.h"
+#include "3d/Frustum.h"
+
+USING_NS_AX;
+
+
+TEST_SUITE("3d/Frustum") {
+    TEST_CASE("batched_test") {
+        auto camera = Camera::createPerspective(60, 1.5f, 1, 1000);
+        camera->setPosition3D(Vec3(0, 0, 100));
+        camera->lookAt(Vec3::ZERO);
+
+        Frustum frustum;
+        REQUIRE(frustum.initFrustum(camera));
+
+        std::mt19937 rng(3);
+        std::uniform_real_distribution<float> posDist(-600, 600);
+        std::uniform_real_distribution<float> extentDist(0.1f, 50);
+
+        // around the groups of four boxes tested together
+        for (size_t count : {1, 3, 4, 5, 17, 1000})
+        {
+            std::vector<Vec3> centers, extents;
+            for (size_t i = 0; i < count; ++i)
+            {
+                centers.emplace_back(posDist(rng), posDist(rng), posDist(rng) - 400);
+                extents.emplace_back(extentDist(rng), extentDist(rng), extentDist(rng));
+            }
+
+            std::unique_ptr<bool[]> outside(new bool[count]);
+            frustum.isOutOfFrustum(centers.data(), extents.data(), count, outside.get());
+
+            size_t mismatches = 0, outsideCount = 0;
+            for (size_t i = 0; i < count; ++i)
+            {
+                AABB aabb(centers[i] - extents[i], centers[i] + extents[i]);
+                mismatches += outside[i] != frustum.isOutOfFrustum(aabb);
+                outsideCount += outside[i];
+            }
+            CHECK(mismatches == 0);
+            if (count == 1000)
+            {
+                CHECK(outsideCount > 0);
+                CHECK(outsideCount < count);
+            }
+        }
+    }
+}
@@ -0,0 +1,309 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+
+#include <doctest.h>
+#include "base/EventDispatcher.h"
+#include "base/EventListenerTouch.h"
+#include "base/Director.h"
+#include "2d/Camera.h"
+#include "2d/ProtectedNode.h"
+
+USING_NS_AX;
+
+
+namespace {
+    // Exposes the two ways the dispatcher orders the scene graph listeners.
+    struct OrderChecker : public EventDispatcher {
+        // Compares the incremental order of every pair of nodes with the one of the full scene visit.
+        void check(Node* root, const std::vector<Node*>& nodes) {
+            for (auto&& node : nodes)
+                _nodeListenersMap.emplace(node, nullptr);
+            visitTarget(root, true);
+            _nodeListenersMap.clear();
+
+            for (auto&& a : nodes) {
+                for (auto&& b : nodes) {
+                    auto priorityA = _nodePriorityMap.find(a) != _nodePriorityMap.end() ? _nodePriorityMap[a] : 0;
+                    auto priorityB = _nodePriorityMap.find(b) != _nodePriorityMap.end() ? _nodePriorityMap[b] : 0;
+                    CAPTURE(priorityA);
+                    CAPTURE(priorityB);
+                    CHECK(isDispatchedBefore(a, b, root) == (priorityA > priorityB));
+                }
+            }
+        }
+    };
+
+    Node* addNode(Node* parent, int localZOrder) {
+        auto node = Node::create();
+        parent->addChild(node, localZOrder);
+        return node;
+    }
+
+    const Size winSize(1024, 768);
+
+    // Exposes the touch listeners offered a touch that begins, with or without the hit-test index.
+    struct TouchChecker : public EventDispatcher {
+        void sort(Node* root) {
+            sortEventListenersOfSceneGraphPriority(EventListenerTouchOneByOne::LISTENER_ID, root);
+        }
+
+        std::vector<EventListener*> getSceneGraphListeners() {
+            return *getListeners(EventListenerTouchOneByOne::LISTENER_ID)->getSceneGraphPriorityListeners();
+        }
+
+        // Same as dispatchTouchEventToListeners, nothing is paused when the index isn't used
+        std::vector<EventListener*> getOffered(const Camera* camera, const Vec2& point, bool indexed = true) {
+            std::vector<EventListener*> listeners;
+            if (indexed) {
+                getHitTestCandidates(camera, winSize, point, listeners);
+            } else {
+                for (auto&& l : getSceneGraphListeners()) {
+                    if (l->isEnabled())
+                        listeners.emplace_back(l);
+                }
+            }
+            return listeners;
+        }
+
+        // The listener claiming the touch
+        EventListener* getTarget(const Camera* camera, const Vec2& point, bool indexed = true) {
+            for (auto&& l : getOffered(camera, point, indexed)) {
+                if (static_cast<EventListenerTouchOneByOne*>(l)->onTouchBegan(nullptr, nullptr))
+                    return l;
+            }
+            return nullptr;
+        }
+    };
+}
+
+
+TEST_SUITE("base/EventDispatcher") {
+    TEST_CASE("dispatch_order") {
+        auto root = Node::create();
+        auto checker = new OrderChecker();
+
+        auto back       = addNode(root, -1);
+        auto backChild  = addNode(back, 0);
+        auto backBehind = addNode(back, -2);
+
+        auto panel = ProtectedNode::create();
+        root->addChild(panel, 0);
+        auto panelFront  = addNode(panel, 1);
+        auto panelBehind = addNode(panel, -1);
+        auto skinBehind  = Node::create();
+        auto skinFront   = Node::create();
+        panel->addProtectedChild(skinBehind, -1);
+        panel->addProtectedChild(skinFront, 0);
+
+        auto front      = addNode(root, 0);
+        auto frontChild = addNode(front, 3);
+        auto outside    = Node::create();
+
+        std::vector<Node*> nodes = {root, back, backChild, backBehind, panel, panelFront, panelBehind, skinBehind,
+                                    skinFront, front, frontChild, outside};
+
+        SUBCASE("local_z_order") {
+            checker->check(root, nodes);
+        }
+
+        SUBCASE("reordered") {
+            back->setLocalZOrder(2);
+            panelBehind->setLocalZOrder(5);
+            skinFront->setLocalZOrder(-3);
+            checker->check(root, nodes);
+        }
+
+        SUBCASE("global_z_order") {
+            backBehind->setGlobalZOrder(1);
+            frontChild->setGlobalZOrder(-1);
+            checker->check(root, nodes);
+        }
+
+        checker->release();
+    }
+
+    TEST_CASE("hit_test_index") {
+        auto checker = new TouchChecker();
+        auto camera = Camera::createOrthographic(winSize.width, winSize.height, -1024, 1024);
+        camera->setPosition(winSize.width / 2, winSize.height / 2);
+
+        auto root = Node::create();
+        root->setEventDispatcher(checker);
+
+        // the listeners claim the touches in their node, as their index declares
+        Vec2 location;
+        std::map<EventListener*, Node*> nodes;
+        auto addTouchNode = [&](const Rect& rect, int localZOrder, bool indexed) {
+            auto node = Node::create();
+            node->setEventDispatcher(checker);
+            node->setPosition(rect.origin);
+            node->setContentSize(rect.size);
+            root->addChild(node, localZOrder);
+
+            auto listener = EventListenerTouchOneByOne::create();
+            listener->setHitTestIndexed(indexed);
+            listener->onTouchBegan = [node, &location](Touch*, Event*) {
+                return node->getBoundingBox().containsPoint(location);
+            };
+            checker->addEventListenerWithSceneGraphPriority(listener, node);
+            checker->resumeEventListenersForTarget(node);
+            nodes[listener] = node;
+            return listener;
+        };
+
+        auto back      = addTouchNode(Rect(100, 100, 400, 300), 0, true);
+        auto front     = addTouchNode(Rect(300, 200, 200, 200), 1, true);
+        auto unindexed = addTouchNode(Rect(600, 100, 100, 100), 0, false);
+        auto distant   = addTouchNode(Rect(800, 500, 100, 100), 0, true);
+
+        checker->setHitTestIndexEnabled(true);
+        checker->sort(root);
+        REQUIRE(checker->isHitTestIndexEnabled());
+
+        // the listeners among the given ones, in dispatch order
+        auto inOrder = [&](const std::vector<EventListener*>& listeners) {
+            std::vector<EventListener*> ordered;
+            for (auto&& l : checker->getSceneGraphListeners()) {
+                if (std::find(listeners.begin(), listeners.end(), l) != listeners.end())
+                    ordered.emplace_back(l);
+            }
+            return ordered;
+        };
+
+        SUBCASE("candidates") {
+            REQUIRE(checker->getSceneGraphListeners().front() == front);
+            CHECK(checker->getOffered(camera, Vec2(350, 250)) == inOrder({back, front, unindexed}));
+            CHECK(checker->getOffered(camera, Vec2(150, 150)) == inOrder({back, unindexed}));
+            CHECK(checker->getOffered(camera, Vec2(850, 550)) == inOrder({distant, unindexed}));
+
+            // the unindexed listeners are offered every touch
+            CHECK(checker->getOffered(camera, Vec2(50, 700)) == std::vector<EventListener*>{unindexed});
+            CHECK(checker->getOffered(camera, Vec2(650, 150)) == std::vector<EventListener*>{unindexed});
+        }
+
+        SUBCASE("reordered") {
+            nodes[front]->setLocalZOrder(-1);
+            checker->sort(root);
+            REQUIRE(checker->getSceneGraphListeners().back() == front);
+            CHECK(checker->getOffered(camera, Vec2(350, 250)) == inOrder({back, front, unindexed}));
+            location = Vec2(350, 250);
+            CHECK(checker->getTarget(camera, location) == back);
+        }
+
+        SUBCASE("paused_or_disabled") {
+            checker->pauseEventListenersForTarget(nodes[back]);
+            CHECK(checker->getOffered(camera, Vec2(350, 250)) == inOrder({front, unindexed}));
+            front->setEnabled(false);
+            CHECK(checker->getOffered(camera, Vec2(350, 250)) == std::vector<EventListener*>{unindexed});
+            checker->pauseEventListenersForTarget(nodes[unindexed]);
+            CHECK(checker->getOffered(camera, Vec2(350, 250)).empty());
+
+            checker->resumeEventListenersForTarget(nodes[back]);
+            front->setEnabled(true);
+            CHECK(checker->getOffered(camera, Vec2(350, 250)) == inOrder({back, front}));
+        }
+
+        SUBCASE("toggled") {
+            checker->setHitTestIndexEnabled(false);
+            CHECK_FALSE(checker->isHitTestIndexEnabled());
+            CHECK(checker->getOffered(camera, Vec2(150, 150)).empty());
+
+            // added while the index is off
+            auto late = addTouchNode(Rect(0, 600, 100, 100), 2, true);
+            checker->sort(root);
+
+            checker->setHitTestIndexEnabled(true);
+            CHECK(checker->getOffered(camera, Vec2(350, 250)) == inOrder({back, front, unindexed}));
+            CHECK(checker->getOffered(camera, Vec2(50, 650)) == inOrder({late, unindexed}));
+
+            // removed while the index is on
+            checker->removeEventListener(front);
+            CHECK(checker->getOffered(camera, Vec2(350, 250)) == inOrder({back, unindexed}));
+
+            checker->setHitTestIndexEnabled(false);
+            checker->setHitTestIndexEnabled(true);
+            CHECK(checker->getOffered(camera, Vec2(350, 250)) == inOrder({back, unindexed}));
+            CHECK(checker->getOffered(camera, Vec2(850, 550)) == inOrder({distant, unindexed}));
+        }
+
+        SUBCASE("reindexed") {
+            checker->setHitTestIndexed(back, false);
+            CHECK_FALSE(back->isHitTestIndexed());
+            CHECK(checker->getOffered(camera, Vec2(50, 700)) == inOrder({back, unindexed}));
+            checker->setHitTestIndexed(unindexed, true);
+            CHECK(checker->getOffered(camera, Vec2(50, 700)) == std::vector<EventListener*>{back});
+            CHECK(checker->getOffered(camera, Vec2(650, 150)) == inOrder({back, unindexed}));
+
+            checker->setHitTestIndexed(back, true);
+            CHECK(checker->getOffered(camera, Vec2(50, 700)).empty());
+            CHECK(checker->getOffered(camera, Vec2(350, 250)) == inOrder({back, front}));
+
+            // applied once the index is enabled
+            checker->setHitTestIndexEnabled(false);
+            checker->setHitTestIndexed(front, false);
+            checker->setHitTestIndexEnabled(true);
+            CHECK(checker->getOffered(camera, Vec2(50, 700)) == std::vector<EventListener*>{front});
+        }
+
+        SUBCASE("same_target") {
+            auto renderer = Director::getInstance()->getRenderer();
+            auto checkTargets = [&]() {
+                for (float x = 0; x <= winSize.width; x += 25) {
+                    for (float y = 0; y <= winSize.height; y += 25) {
+                        location = Vec2(x, y);
+                        CAPTURE(location);
+                        CHECK(checker->getTarget(camera, location) == checker->getTarget(camera, location, false));
+                    }
+                }
+            };
+
+            root->visit(renderer, Mat4::IDENTITY, 0);
+            checkTargets();
+
+            location = Vec2(350, 250);
+            CHECK(checker->getTarget(camera, location) == front);
+            location = Vec2(150, 150);
+            CHECK(checker->getTarget(camera, location) == back);
+            location = Vec2(650, 150);
+            CHECK(checker->getTarget(camera, location) == unindexed);
+
+            // the touch area follows the node once it's drawn
+            nodes[front]->setPosition(50, 50);
+            nodes[distant]->setContentSize(Size(200, 200));
+            root->visit(renderer, Mat4::IDENTITY, 0);
+            checkTargets();
+
+            location = Vec2(350, 250);
+            CHECK(checker->getTarget(camera, location) == back);
+            location = Vec2(150, 150);
+            CHECK(checker->getTarget(camera, location) == front);
+            location = Vec2(950, 650);
+            CHECK(checker->getTarget(camera, location) == distant);
+        }
+
+        checker->removeEventListenersForTarget(root, true);
+        checker->release();
+    }
+}
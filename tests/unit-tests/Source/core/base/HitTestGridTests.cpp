@@ -0,0 +1,154 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include <doctest.h>
+#include "base/HitTestGrid.h"
+#include "2d/Camera.h"
+
+USING_NS_AX;
+
+
+namespace {
+    const Size winSize(1024, 768);
+
+    // Sees the world as it's placed on the window, a point of the scene is at the same location on screen.
+    Camera* createScreenCamera() {
+        auto camera = Camera::createOrthographic(winSize.width, winSize.height, -1024, 1024);
+        camera->setPosition(winSize.width / 2, winSize.height / 2);
+        return camera;
+    }
+
+    Node* createNode(const Vec2& position, const Size& size) {
+        auto node = Node::create();
+        node->setPosition(position);
+        node->setContentSize(size);
+        return node;
+    }
+
+    std::vector<int> query(HitTestGrid& grid, const Camera* camera, const Vec2& point, const Size& size = winSize) {
+        std::vector<int> slots;
+        grid.query(camera, size, point, slots);
+        std::sort(slots.begin(), slots.end());
+        return slots;
+    }
+}
+
+
+TEST_SUITE("base/HitTestGrid") {
+    TEST_CASE("query") {
+        HitTestGrid grid;
+        auto camera = createScreenCamera();
+
+        auto a = createNode(Vec2(100, 100), Size(200, 100));
+        auto b = createNode(Vec2(250, 150), Size(200, 200));
+        auto c = createNode(Vec2(900, 700), Size(50, 50));
+        int slotA = grid.add(a);
+        int slotB = grid.add(b);
+        int slotC = grid.add(c);
+        REQUIRE(slotA < slotB);
+
+        SUBCASE("place") {
+            CHECK(query(grid, camera, Vec2(150, 150)) == std::vector<int>{slotA});
+            CHECK(query(grid, camera, Vec2(260, 160)) == std::vector<int>{slotA, slotB});
+            CHECK(query(grid, camera, Vec2(925, 725)) == std::vector<int>{slotC});
+            CHECK(query(grid, camera, Vec2(500, 500)).empty());
+
+            // the edges belong to the rect, and a bit beyond
+            CHECK(query(grid, camera, Vec2(300, 120)) == std::vector<int>{slotA});
+            CHECK(query(grid, camera, Vec2(100.5f, 99.5f)) == std::vector<int>{slotA});
+            CHECK(query(grid, camera, Vec2(303, 120)).empty());
+
+            // out of the window, the clamped cell is only a shortcut
+            CHECK(query(grid, camera, Vec2(-500, 150)).empty());
+        }
+
+        SUBCASE("invalidate") {
+            a->setPosition(600, 400);
+            CHECK(query(grid, camera, Vec2(150, 150)) == std::vector<int>{slotA});
+            CHECK(query(grid, camera, Vec2(650, 450)).empty());
+
+            grid.invalidate(slotA);
+            CHECK(query(grid, camera, Vec2(150, 150)).empty());
+            CHECK(query(grid, camera, Vec2(650, 450)) == std::vector<int>{slotA});
+            CHECK(query(grid, camera, Vec2(260, 160)) == std::vector<int>{slotB});
+
+            a->setScale(2);
+            grid.invalidate(slotA);
+            grid.invalidate(slotA);
+            CHECK(query(grid, camera, Vec2(950, 550)) == std::vector<int>{slotA});
+            CHECK(query(grid, camera, Vec2(925, 725)) == std::vector<int>{slotC});
+        }
+
+        SUBCASE("remove") {
+            grid.remove(slotA);
+            CHECK(query(grid, camera, Vec2(150, 150)).empty());
+            CHECK(query(grid, camera, Vec2(260, 160)) == std::vector<int>{slotB});
+
+            auto d = createNode(Vec2(500, 500), Size(10, 10));
+            CHECK(grid.add(d) == slotA);
+            CHECK(query(grid, camera, Vec2(505, 505)) == std::vector<int>{slotA});
+            CHECK(query(grid, camera, Vec2(150, 150)).empty());
+
+            grid.clear();
+            CHECK(query(grid, camera, Vec2(505, 505)).empty());
+            CHECK(query(grid, camera, Vec2(925, 725)).empty());
+        }
+
+        SUBCASE("camera_moved") {
+            CHECK(query(grid, camera, Vec2(150, 120)) == std::vector<int>{slotA});
+
+            // everything is reprojected, nothing was invalidated
+            camera->setPosition(winSize.width / 2 + 200, winSize.height / 2);
+            CHECK(query(grid, camera, Vec2(150, 120)).empty());
+            CHECK(query(grid, camera, Vec2(50, 120)) == std::vector<int>{slotA});
+
+            // each camera has its own view
+            auto other = createScreenCamera();
+            CHECK(query(grid, other, Vec2(150, 120)) == std::vector<int>{slotA});
+            CHECK(query(grid, camera, Vec2(50, 120)) == std::vector<int>{slotA});
+        }
+
+        SUBCASE("window_resized") {
+            CHECK(query(grid, camera, Vec2(300, 300), winSize * 2) == std::vector<int>{slotA});
+            CHECK(query(grid, camera, Vec2(150, 150), winSize * 2).empty());
+        }
+
+        SUBCASE("unbounded") {
+            // a rect crossing the near plane is returned wherever the touch is
+            auto perspective = Camera::createPerspective(60, winSize.width / winSize.height, 1, 2000);
+            perspective->setPosition3D(Vec3(winSize.width / 2, winSize.height / 2, 500));
+            auto wall = createNode(Vec2(winSize.width / 2, winSize.height / 2), Size(100, 2000));
+            wall->setAnchorPoint(Vec2(0, 0.5f));
+            wall->setRotation3D(Vec3(90, 0, 0));
+            int slotWall = grid.add(wall);
+
+            CHECK(query(grid, perspective, Vec2(0, 400)) == std::vector<int>{slotWall});
+            CHECK(query(grid, perspective, Vec2(1000, 400)) == std::vector<int>{slotWall});
+            CHECK(query(grid, camera, Vec2(0, 0)).empty());
+
+            grid.remove(slotWall);
+            CHECK(query(grid, perspective, Vec2(0, 400)).empty());
+        }
+    }
+}
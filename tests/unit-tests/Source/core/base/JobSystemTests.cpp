@@ -0,0 +1,205 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include <doctest.h>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "base/JobSystem.h"
+
+USING_NS_AX;
+
+namespace {
+    // spin until the condition holds, or give up after a second
+    template <typename Pred>
+    bool waitFor(Pred pred) {
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(1);
+        while (!pred()) {
+            if (std::chrono::steady_clock::now() > deadline)
+                return false;
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        return true;
+    }
+}
+
+
+TEST_SUITE("base/JobSystem") {
+    TEST_CASE("dependencies") {
+        JobSystem jobSystem(4);
+        std::atomic<int> step{0};
+        int firstStep = -1, secondStep = -1, thirdStep = -1;
+
+        auto first = jobSystem.schedule([&] {
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            firstStep = step++;
+        });
+        auto second = jobSystem.schedule([&] { secondStep = step++; }, JobPriority::High, {first});
+        auto third = jobSystem.schedule([&] { thirdStep = step++; }, JobPriority::Background, {first, second});
+        third.wait();
+
+        CHECK(first.isDone());
+        CHECK(second.isDone());
+        CHECK(firstStep == 0);
+        CHECK(secondStep == 1);
+        CHECK(thirdStep == 2);
+        CHECK(JobHandle().isDone());
+    }
+
+    TEST_CASE("background_order") {
+        JobSystem jobSystem(1);
+        std::atomic<bool> release{false};
+        std::mutex mutex;
+        std::vector<int> order;
+
+        auto blocker = jobSystem.schedule([&] { waitFor([&] { return release.load(); }); }, JobPriority::Background);
+        std::vector<JobHandle> loads;
+        for (int i = 0; i < 8; ++i) {
+            loads.push_back(jobSystem.schedule([&, i] {
+                std::lock_guard<std::mutex> lock(mutex);
+                order.push_back(i);
+            }, JobPriority::Background));
+        }
+        release = true;
+
+        // not waited, which would run the loads inline
+        CHECK(waitFor([&] {
+            for (auto& load : loads)
+                if (!load.isDone())
+                    return false;
+            return true;
+        }));
+        CHECK(blocker.isDone());
+        CHECK(order == std::vector<int>{0, 1, 2, 3, 4, 5, 6, 7});
+    }
+
+    TEST_CASE("background_limit") {
+        // a single background slot with two workers
+        JobSystem jobSystem(2);
+        std::atomic<int> running{0};
+        std::atomic<int> maxRunning{0};
+        std::atomic<bool> release{false};
+
+        std::vector<JobHandle> loads;
+        for (int i = 0; i < 4; ++i) {
+            loads.push_back(jobSystem.schedule([&] {
+                int count = ++running;
+                int expected = maxRunning.load();
+                while (count > expected && !maxRunning.compare_exchange_weak(expected, count)) {}
+                waitFor([&] { return release.load(); });
+                --running;
+            }, JobPriority::Background));
+        }
+
+        // high priority jobs still run on the other worker
+        std::atomic<bool> ran{false};
+        auto frameJob = jobSystem.schedule([&] { ran = true; });
+        CHECK(waitFor([&] { return ran.load(); }));
+        CHECK(frameJob.isDone());
+
+        release = true;
+        CHECK(waitFor([&] { return loads.back().isDone() && loads.front().isDone(); }));
+        for (auto& load : loads)
+            load.wait();
+        CHECK(maxRunning == 1);
+    }
+
+    TEST_CASE("wait") {
+        JobSystem jobSystem(2);
+
+        SUBCASE("background_from_background") {
+            // the only background slot is taken by the waiting job, the awaited one runs inline
+            std::atomic<bool> loaded{false};
+            auto outer = jobSystem.schedule([&] {
+                auto inner = jobSystem.schedule([&] { loaded = true; }, JobPriority::Background);
+                inner.wait();
+            }, JobPriority::Background);
+            outer.wait();
+            CHECK(loaded);
+        }
+
+        SUBCASE("queued_job_runs_inline") {
+            // keep both workers busy
+            std::atomic<int> started{0};
+            std::atomic<bool> release{false};
+            std::vector<JobHandle> blockers;
+            for (int i = 0; i < 2; ++i) {
+                blockers.push_back(jobSystem.schedule([&] {
+                    ++started;
+                    waitFor([&] { return release.load(); });
+                }));
+            }
+            REQUIRE(waitFor([&] { return started == 2; }));
+
+            auto caller = std::this_thread::get_id();
+            std::thread::id runner;
+            auto job = jobSystem.schedule([&] { runner = std::this_thread::get_id(); });
+            job.wait();
+            CHECK(runner == caller);
+
+            release = true;
+            for (auto& blocker : blockers)
+                blocker.wait();
+        }
+    }
+
+    TEST_CASE("parallel_for") {
+        JobSystem jobSystem(4);
+
+        for (size_t grain : {1, 7, 64, 5000}) {
+            std::vector<std::atomic<int>> visits(1000);
+            std::atomic<bool> emptyChunk{false};
+            jobSystem.parallel_for(0, visits.size(), grain, [&](size_t first, size_t last) {
+                emptyChunk = emptyChunk || first >= last;
+                for (; first != last; ++first)
+                    ++visits[first];
+            });
+
+            CHECK_FALSE(emptyChunk);
+            bool once = true;
+            for (auto& visit : visits)
+                once &= visit == 1;
+            CHECK(once);
+        }
+
+        SUBCASE("nested") {
+            std::atomic<size_t> sum{0};
+            jobSystem.parallel_for(0, 8, 1, [&](size_t first, size_t last) {
+                for (; first != last; ++first)
+                    jobSystem.parallel_for(0, 100, 10, [&](size_t b, size_t e) { sum += e - b; });
+            });
+            CHECK(sum == 800);
+        }
+
+        SUBCASE("without_workers") {
+            std::vector<std::shared_ptr<JobThreadData>> noThreads;
+            JobSystem inlineJobs(noThreads);
+            size_t count = 0;
+            inlineJobs.parallel_for(10, 20, 3, [&](size_t first, size_t last) { count += last - first; });
+            CHECK(count == 10);
+        }
+    }
+}
@@ -0,0 +1,117 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+
+
+#include <doctest.h>
+#include "base/Scheduler.h"
+
+USING_NS_AX;
+
+
+namespace {
+    // Counts the triggers of timers scheduled on a fresh scheduler.
+    struct TimerCounter {
+        Scheduler* scheduler = new Scheduler();
+        int targets[4]       = {};
+        int counts[4]        = {};
+
+        ~TimerCounter() { scheduler->release(); }
+
+        void schedule(int index, float interval, unsigned int repeat, float delay) {
+            scheduler->schedule([this, index](float) { ++counts[index]; }, &targets[index], interval, repeat, delay,
+                                false, "counter");
+        }
+
+        void run(int frames) {
+            for (int i = 0; i < frames; ++i)
+                scheduler->update(0.1f);
+        }
+    };
+}
+
+
+TEST_SUITE("base/Scheduler") {
+    TEST_CASE("timer_queue_matches_tick") {
+        TimerCounter tick, queue;
+        queue.scheduler->setTimerQueueEnabled(true);
+        for (auto counter : {&tick, &queue}) {
+            counter->schedule(0, 0.0f, AX_REPEAT_FOREVER, 0.0f);
+            counter->schedule(1, 0.25f, AX_REPEAT_FOREVER, 0.0f);
+            counter->schedule(2, 0.3f, 2, 0.5f);
+            counter->schedule(3, 100.0f, AX_REPEAT_FOREVER, 0.0f);
+            counter->run(20);
+        }
+
+        for (int i = 0; i < 4; ++i)
+            CHECK(tick.counts[i] == queue.counts[i]);
+        CHECK(queue.counts[2] == 3);
+        CHECK(queue.counts[3] == 0);
+        CHECK_FALSE(queue.scheduler->isScheduled("counter", &queue.targets[2]));
+    }
+
+    TEST_CASE("timer_queue_pause") {
+        TimerCounter counter;
+        counter.scheduler->setTimerQueueEnabled(true);
+        counter.schedule(0, 1.0f, AX_REPEAT_FOREVER, 0.0f);
+        counter.run(6);
+        counter.scheduler->pauseTarget(&counter.targets[0]);
+        counter.run(20);
+        CHECK(counter.counts[0] == 0);
+
+        // the time left is kept while paused
+        counter.scheduler->resumeTarget(&counter.targets[0]);
+        counter.run(4);
+        CHECK(counter.counts[0] == 0);
+        counter.run(2);
+        CHECK(counter.counts[0] == 1);
+    }
+
+    TEST_CASE("timer_queue_unschedule") {
+        TimerCounter counter;
+        counter.scheduler->setTimerQueueEnabled(true);
+        counter.scheduler->schedule([&](float) {
+            ++counter.counts[0];
+            counter.scheduler->unschedule("counter", &counter.targets[1]);
+            counter.scheduler->unschedule("self", &counter.targets[0]);
+        }, &counter.targets[0], 0.1f, false, "self");
+        counter.schedule(1, 0.1f, AX_REPEAT_FOREVER, 0.0f);
+        counter.run(10);
+        CHECK(counter.counts[0] == 1);
+        CHECK(counter.counts[1] <= 1);
+        CHECK_FALSE(counter.scheduler->isScheduled("self", &counter.targets[0]));
+    }
+
+    TEST_CASE("timer_queue_switch") {
+        TimerCounter counter;
+        counter.schedule(0, 1.0f, AX_REPEAT_FOREVER, 0.0f);
+        counter.run(6);
+        counter.scheduler->setTimerQueueEnabled(true);
+        counter.run(5);
+        CHECK(counter.counts[0] == 1);
+        counter.scheduler->setTimerQueueEnabled(false);
+        counter.run(10);
+        CHECK(counter.counts[0] == 2);
+    }
+}
@@ -24,7 +24,12 @@
  ****************************************************************************/
 
 #include <doctest.h>
+#include <chrono>
+#include <vector>
 #include "base/Config.h"
+#include "base/Types.h"
+#include "math/Mat4.h"
+#include "math/MathUtil.h"
 
 #if (AX_TARGET_PLATFORM == AX_PLATFORM_IOS)
     #if defined(__arm64__)
@@ -328,3 +333,71 @@ TEST_SUITE("math/MathUtil" * SKIP_SIMD_TEST) {
         memset(outVec4Opt, 0, sizeof(outVec4Opt));
     }
 }
+
+
+TEST_SUITE("math/MathUtil") {
+    TEST_CASE("transformVertices") {
+        using namespace UnitTest::ax;
+
+        Mat4 transform;
+        Mat4::createRotationZ(0.6f, &transform);
+        transform.scale(1.5f, 0.5f, 2.0f);
+        transform.translate(12.0f, -34.0f, 5.0f);
+
+        // a batch of quads, like the renderer fills for 20k sprites
+        const size_t count = 4 * 20000;
+        std::vector<V3F_C4B_T2F> src(count), dstC(count), dstOpt(count);
+        for (size_t i = 0; i < count; ++i)
+        {
+            src[i].vertices  = Vec3(i * 0.25f, i * 0.5f - 100.0f, (i % 7) * 1.0f);
+            src[i].colors    = Color4B(i & 0xff, (i >> 8) & 0xff, 0x7f, 0xff);
+            src[i].texCoords = Tex2F((i % 4) * 0.25f, (i % 3) * 0.5f);
+        }
+
+        auto start = std::chrono::steady_clock::now();
+        MathUtilC::transformVertices(dstC.data(), src.data(), count, transform.m);
+        auto scalarTime = std::chrono::steady_clock::now() - start;
+
+        start = std::chrono::steady_clock::now();
+        ax::MathUtil::transformVertices(dstOpt.data(), src.data(), count, transform);
+        auto simdTime = std::chrono::steady_clock::now() - start;
+
+        MESSAGE("transformVertices x", count, ": scalar ",
+                std::chrono::duration_cast<std::chrono::microseconds>(scalarTime).count(), "us, simd ",
+                std::chrono::duration_cast<std::chrono::microseconds>(simdTime).count(), "us");
+
+        for (size_t i = 0; i < count; ++i)
+        {
+            CHECK(dstOpt[i].vertices.x == doctest::Approx(dstC[i].vertices.x).epsilon(0.0001));
+            CHECK(dstOpt[i].vertices.y == doctest::Approx(dstC[i].vertices.y).epsilon(0.0001));
+            CHECK(dstOpt[i].vertices.z == doctest::Approx(dstC[i].vertices.z).epsilon(0.0001));
+            CHECK(dstOpt[i].colors == src[i].colors);
+            CHECK(dstOpt[i].texCoords.u == src[i].texCoords.u);
+            CHECK(dstOpt[i].texCoords.v == src[i].texCoords.v);
+        }
+    }
+
+    TEST_CASE("transformIndices") {
+        using namespace UnitTest::ax;
+
+        // odd count to cover the non vectorized tail
+        const size_t count = 6 * 20000 + 5;
+        std::vector<uint16_t> src(count), dstC(count), dstOpt(count);
+        for (size_t i = 0; i < count; ++i)
+            src[i] = static_cast<uint16_t>(i % 4);
+
+        auto start = std::chrono::steady_clock::now();
+        MathUtilC::transformIndices(dstC.data(), src.data(), count, 1234);
+        auto scalarTime = std::chrono::steady_clock::now() - start;
+
+        start = std::chrono::steady_clock::now();
+        ax::MathUtil::transformIndices(dstOpt.data(), src.data(), count, 1234);
+        auto simdTime = std::chrono::steady_clock::now() - start;
+
+        MESSAGE("transformIndices x", count, ": scalar ",
+                std::chrono::duration_cast<std::chrono::microseconds>(scalarTime).count(), "us, simd ",
+                std::chrono::duration_cast<std::chrono::microseconds>(simdTime).count(), "us");
+
+        CHECK(dstOpt == dstC);
+    }
+}
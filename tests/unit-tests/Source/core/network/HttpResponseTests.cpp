@@ -0,0 +1,124 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include <doctest.h>
+#include <string>
+#include "network/HttpResponse.h"
+#include "zlib.h"
+
+USING_NS_AX;
+using namespace ax::network;
+
+
+namespace {
+    // Feeds raw server bytes to a response, the way HttpClient does.
+    struct ResponseProbe : public HttpResponse {
+        explicit ResponseProbe(HttpRequest* request) : HttpResponse(request) {
+            setLocation("http://localhost/", false);
+            _decodeContent = true;
+        }
+
+        void feed(const std::string& data) { handleInput(data.data(), data.size()); }
+
+        using HttpResponse::isFinished;
+    };
+
+    // windowBits as for deflateInit2: 15 + 16 gzip, 15 zlib, -15 raw deflate
+    std::string compress(const std::string& data, int windowBits) {
+        z_stream stream{};
+        REQUIRE(deflateInit2(&stream, Z_BEST_COMPRESSION, Z_DEFLATED, windowBits, 8, Z_DEFAULT_STRATEGY) == Z_OK);
+        std::string out(deflateBound(&stream, static_cast<uLong>(data.size())), '\0');
+        stream.next_in   = (Bytef*)data.data();
+        stream.avail_in  = static_cast<uInt>(data.size());
+        stream.next_out  = (Bytef*)out.data();
+        stream.avail_out = static_cast<uInt>(out.size());
+        REQUIRE(deflate(&stream, Z_FINISH) == Z_STREAM_END);
+        out.resize(stream.total_out);
+        deflateEnd(&stream);
+        return out;
+    }
+}
+
+
+TEST_SUITE("network/HttpResponse") {
+    TEST_CASE("decode_body") {
+        // ends with a run, so that the last few input bytes decode to much more than the 16KB inflate buffer
+        std::string body;
+        for (int i = 0; body.size() < 100000; ++i)
+            body += "line " + std::to_string(i) + " of the decoded body\n";
+        body.append(100000, 'x');
+        body += "end\n";
+
+        const char* encoding = nullptr;
+        int windowBits = 0;
+        SUBCASE("gzip") {
+            encoding = "gzip";
+            windowBits = 15 + 16;
+        }
+        SUBCASE("zlib") {
+            encoding = "deflate";
+            windowBits = 15;
+        }
+        SUBCASE("raw_deflate") {
+            encoding = "deflate";
+            windowBits = -15;
+        }
+        CAPTURE(windowBits);
+
+        auto encoded = compress(body, windowBits);
+        std::string message = "HTTP/1.1 200 OK\r\nContent-Encoding: ";
+        message += encoding;
+        message += "\r\nContent-Length: " + std::to_string(encoded.size()) + "\r\n\r\n";
+        const size_t headerSize = message.size();
+        message += encoded;
+
+        auto request = new HttpRequest();
+        for (size_t chunkSize : {message.size(), size_t(1), size_t(7), size_t(1000), size_t(4096)}) {
+            for (size_t tailSize : {1, 2, 5, 64}) {
+                CAPTURE(chunkSize);
+                CAPTURE(tailSize);
+                auto response = new ResponseProbe(request);
+
+                // the header comes alone, then the body in chunks and its last bytes in a chunk of their own
+                response->feed(message.substr(0, headerSize));
+                size_t offset     = headerSize;
+                const size_t tail = message.size() - tailSize;
+                while (offset < tail) {
+                    auto size = std::min(chunkSize, tail - offset);
+                    response->feed(message.substr(offset, size));
+                    offset += size;
+                }
+                response->feed(message.substr(offset));
+
+                CHECK(response->isFinished());
+                CHECK(response->getResponseCode() == 200);
+                auto data = response->getResponseData();
+                REQUIRE(data->size() == body.size());
+                CHECK(std::string(data->data(), data->size()) == body);
+                response->release();
+            }
+        }
+        request->release();
+    }
+}
@@ -0,0 +1,90 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+
+#include <doctest.h>
+#include <string>
+#include "renderer/FrameAllocator.h"
+
+USING_NS_AX;
+
+
+TEST_SUITE("renderer/FrameAllocator") {
+    TEST_CASE("allocate") {
+        FrameAllocator allocator(256);
+
+        auto a = allocator.allocate(3, 1);
+        auto b = allocator.allocateArray<double>(4);
+        CHECK(a != nullptr);
+        CHECK(reinterpret_cast<uintptr_t>(b) % alignof(double) == 0);
+        CHECK(allocator.getStats().allocations == 2);
+        CHECK(allocator.getStats().bytes == 3 + 4 * sizeof(double));
+
+        // larger than a block
+        auto c = allocator.allocate(1000, 16);
+        CHECK(reinterpret_cast<uintptr_t>(c) % 16 == 0);
+        CHECK(allocator.getStats().systemAllocations == 2);
+
+        allocator.reset();
+        CHECK(allocator.getFrameStats().allocations == 3);
+        CHECK(allocator.getStats().allocations == 0);
+    }
+
+    TEST_CASE("steady_state") {
+        FrameAllocator allocator(256);
+
+        // the blocks of the first frame are merged by reset, the next frames don't allocate anymore
+        for (int frame = 0; frame < 4; ++frame)
+        {
+            for (int i = 0; i < 100; ++i)
+                allocator.allocateArray<float>(16);
+            allocator.reset();
+            if (frame > 0)
+                CHECK(allocator.getFrameStats().systemAllocations == 0);
+        }
+        CHECK(allocator.getCapacity() >= 100 * 16 * sizeof(float));
+    }
+
+    TEST_CASE("construct") {
+        FrameAllocator allocator;
+        int destroyed = 0;
+
+        struct Tracked
+        {
+            int* counter;
+            std::string name;
+            ~Tracked() { ++*counter; }
+        };
+
+        auto a = allocator.construct<Tracked>(Tracked{&destroyed, "a long enough string to be on the heap"});
+        auto b = allocator.construct<int>(42);
+        CHECK(a->name == "a long enough string to be on the heap");
+        CHECK(*b == 42);
+
+        // one for the moved from temporary
+        CHECK(destroyed == 1);
+        allocator.reset();
+        CHECK(destroyed == 2);
+    }
+}
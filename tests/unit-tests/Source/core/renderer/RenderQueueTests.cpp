@@ -0,0 +1,216 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include <doctest.h>
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <random>
+#include <unordered_map>
+#include <vector>
+#include "renderer/CustomCommand.h"
+#include "renderer/Renderer.h"
+#include "renderer/TrianglesCommand.h"
+
+USING_NS_AX;
+
+namespace {
+    // a 2D quad at global Z 0, the material is set directly so that no GPU object is needed
+    class QuadCommand : public TrianglesCommand {
+    public:
+        void init(uint32_t materialID, const Rect& rect) {
+            verts[0].vertices = Vec3(rect.getMinX(), rect.getMinY(), 0);
+            verts[1].vertices = Vec3(rect.getMaxX(), rect.getMinY(), 0);
+            verts[2].vertices = Vec3(rect.getMinX(), rect.getMaxY(), 0);
+            verts[3].vertices = Vec3(rect.getMaxX(), rect.getMaxY(), 0);
+
+            RenderCommand::init(0, Mat4::IDENTITY, 0);
+            _triangles = Triangles(verts, indices, 4, 6);
+            _materialID = materialID;
+        }
+
+        V3F_C4B_T2F verts[4];
+        unsigned short indices[6] = {0, 1, 2, 3, 2, 1};
+    };
+
+    class QuadQueue {
+    public:
+        void add(uint32_t material, const Rect& rect) {
+            auto& quad = quads.emplace_back(std::make_unique<QuadCommand>());
+            quad->init(material, rect);
+            queue.emplace_back(quad.get());
+        }
+
+        // the submit order of the reordered commands
+        std::vector<size_t> reorder(unsigned int window = RenderQueue::REORDER_WINDOW) {
+            queue.reorderByMaterial(window);
+            std::vector<size_t> order;
+            for (auto command : queue.getSubQueue(RenderQueue::QUEUE_GROUP::GLOBALZ_ZERO)) {
+                auto iter = std::find_if(quads.begin(), quads.end(),
+                                         [command](auto& quad) { return quad.get() == command; });
+                order.push_back(iter - quads.begin());
+            }
+            return order;
+        }
+
+        RenderQueue queue;
+        std::vector<std::unique_ptr<QuadCommand>> quads;
+    };
+
+    Rect cell(int i) {
+        return Rect(i * 10.0f, 0, 8, 8);
+    }
+}
+
+
+TEST_SUITE("renderer/RenderQueue") {
+    TEST_CASE("sort") {
+        // below and above RenderQueue::RADIX_SORT_THRESHOLD
+        for (size_t count : {100, 1000, 10000, 100000})
+        {
+            // few distinct global Z values, so that stability matters
+            std::mt19937 rng(static_cast<unsigned int>(count));
+            std::uniform_int_distribution<int> zDist(-64, 64);
+            std::vector<CustomCommand> commands(count);
+            for (auto& command : commands)
+                command.init(zDist(rng) * 0.5f);
+
+            RenderQueue queue;
+            std::unordered_map<RenderCommand*, size_t> submitOrder;
+            for (size_t i = 0; i < count; ++i)
+            {
+                queue.emplace_back(&commands[i]);
+                submitOrder[&commands[i]] = i;
+            }
+
+            // the previous std::stable_sort by global Z, as reference
+            auto expected = queue.getSubQueue(RenderQueue::QUEUE_GROUP::GLOBALZ_POS);
+            auto start    = std::chrono::steady_clock::now();
+            std::stable_sort(expected.begin(), expected.end(), [](RenderCommand* a, RenderCommand* b) {
+                return a->getGlobalOrder() < b->getGlobalOrder();
+            });
+            auto stableSortTime = std::chrono::steady_clock::now() - start;
+
+            start = std::chrono::steady_clock::now();
+            queue.sort();
+            auto sortTime = std::chrono::steady_clock::now() - start;
+
+            MESSAGE("RenderQueue::sort x", count, ": stable_sort ",
+                    std::chrono::duration_cast<std::chrono::microseconds>(stableSortTime).count(), "us, sort key ",
+                    std::chrono::duration_cast<std::chrono::microseconds>(sortTime).count(), "us");
+
+            CHECK(queue.getSubQueue(RenderQueue::QUEUE_GROUP::GLOBALZ_POS) == expected);
+
+            auto& negative = queue.getSubQueue(RenderQueue::QUEUE_GROUP::GLOBALZ_NEG);
+            for (size_t i = 1; i < negative.size(); ++i)
+            {
+                auto prev = negative[i - 1];
+                auto cur  = negative[i];
+                REQUIRE(prev->getGlobalOrder() <= cur->getGlobalOrder());
+                if (prev->getGlobalOrder() == cur->getGlobalOrder())
+                    REQUIRE(submitOrder[prev] < submitOrder[cur]);
+            }
+        }
+    }
+
+    TEST_CASE("reorder_by_material") {
+        QuadQueue quads;
+
+        SUBCASE("groups_materials") {
+            quads.add(0, cell(0));
+            quads.add(1, cell(1));
+            quads.add(0, cell(2));
+            quads.add(1, cell(3));
+            CHECK(quads.reorder() == std::vector<size_t>{0, 2, 1, 3});
+        }
+
+        SUBCASE("window_limit") {
+            quads.add(0, cell(0));
+            quads.add(1, cell(1));
+            quads.add(1, cell(2));
+            quads.add(0, cell(3));
+
+            SUBCASE("out_of_window") {
+                CHECK(quads.reorder(3) == std::vector<size_t>{0, 1, 2, 3});
+            }
+            SUBCASE("in_window") {
+                CHECK(quads.reorder(4) == std::vector<size_t>{0, 3, 1, 2});
+            }
+        }
+
+        SUBCASE("overlapping_keep_order") {
+            quads.add(0, cell(0));
+            quads.add(1, Rect(10, 0, 8, 8));
+            quads.add(0, Rect(14, 4, 8, 8));
+            quads.add(1, cell(3));
+            CHECK(quads.reorder() == std::vector<size_t>{0, 1, 3, 2});
+        }
+
+        SUBCASE("equal_materials_keep_order") {
+            // the third quad is held back by the second one, the fourth one mustn't jump over it
+            quads.add(0, cell(0));
+            quads.add(1, Rect(10, 0, 8, 8));
+            quads.add(0, Rect(14, 4, 8, 8));
+            quads.add(0, cell(5));
+            CHECK(quads.reorder() == std::vector<size_t>{0, 1, 2, 3});
+        }
+
+        SUBCASE("single_material") {
+            for (int i = 0; i < 8; ++i)
+                quads.add(0, Rect(i * 2.0f, 0, 8, 8));
+            CHECK(quads.reorder() == std::vector<size_t>{0, 1, 2, 3, 4, 5, 6, 7});
+        }
+
+        SUBCASE("random") {
+            std::mt19937 rng(7);
+            std::uniform_int_distribution<int> materialDist(0, 3);
+            std::uniform_real_distribution<float> posDist(0, 200);
+            for (int i = 0; i < 500; ++i)
+                quads.add(materialDist(rng), Rect(posDist(rng), posDist(rng), 16, 16));
+
+            auto order = quads.reorder(16);
+            REQUIRE(order.size() == quads.quads.size());
+
+            std::vector<size_t> position(order.size());
+            for (size_t i = 0; i < order.size(); ++i)
+                position[order[i]] = i;
+
+            auto bounds = [&](size_t i) {
+                auto verts = quads.quads[i]->verts;
+                return Rect(verts[0].vertices.x, verts[0].vertices.y, 16, 16);
+            };
+            bool keptOrder = true;
+            for (size_t a = 0; a < order.size() && keptOrder; ++a)
+            {
+                for (size_t b = a + 1; b < order.size() && keptOrder; ++b)
+                {
+                    bool sameMaterial = quads.quads[a]->getMaterialID() == quads.quads[b]->getMaterialID();
+                    if (sameMaterial || bounds(a).intersectsRect(bounds(b)))
+                        keptOrder = position[a] < position[b];
+                }
+            }
+            CHECK(keptOrder);
+        }
+    }
+}
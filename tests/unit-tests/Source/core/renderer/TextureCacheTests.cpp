@@ -0,0 +1,130 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+
+#include <doctest.h>
+#include <vector>
+#include "base/Director.h"
+#include "base/JobSystem.h"
+#include "platform/FileUtils.h"
+#include "platform/Image.h"
+#include "renderer/TextureCache.h"
+
+USING_NS_AX;
+
+
+namespace {
+    // Drives the preload queue by hand, the textures are never uploaded.
+    struct PreloadProbe : public TextureCache {
+        void dispatch() { dispatchPreloads(); }
+
+        void waitForDecodes() {
+            std::unique_lock<std::mutex> lck(_preloadMutex);
+            _preloadCondition.wait(lck, [this] { return 0 == _preloadDecoding; });
+        }
+
+        size_t queued() const { return _preloadQueue.size(); }
+        size_t decoded() const { return _preloadResponses.size(); }
+        size_t decodedBytes() const { return _preloadDecodedBytes; }
+    };
+}
+
+
+TEST_SUITE("renderer/TextureCache") {
+    TEST_CASE("preload_budget") {
+        auto fu = FileUtils::getInstance();
+
+        std::vector<uint8_t> pixels(16 * 16 * 4, 0x80);
+        Image source;
+        REQUIRE(source.initWithRawData(pixels.data(), pixels.size(), 16, 16, 8));
+
+        const size_t count = 6;
+        std::vector<std::string> paths;
+        for (size_t i = 0; i < count; ++i) {
+            paths.emplace_back(fu->getWritablePath() + "__preload" + std::to_string(i) + ".png");
+            REQUIRE(source.saveToFile(paths.back(), false));
+        }
+
+        Image decodedImage;
+        REQUIRE(decodedImage.initWithImageFile(paths.front()));
+        const size_t imageBytes = decodedImage.getDataLen();
+
+        auto cache = new PreloadProbe();
+        const size_t decoders = std::max(Director::getInstance()->getJobSystem()->getWorkerCount(), 1);
+
+        // a missing file is reported right away
+        int failed = 0;
+        auto requests = paths;
+        requests.emplace_back(fu->getWritablePath() + "__preload_missing.png");
+        auto preload = [&]() {
+            cache->preloadImagesAsync(requests, [&](Texture2D* texture, size_t loaded, size_t total) {
+                CHECK(texture == nullptr);
+                CHECK(loaded == 1);
+                CHECK(total == count + 1);
+                ++failed;
+            });
+            CHECK(failed == 1);
+        };
+
+        SUBCASE("stops_at_budget") {
+            cache->setMaxPreloadDecodedBytes(1);
+            preload();
+            cache->waitForDecodes();
+
+            // the decoders started before the first image was done, no more once it is
+            CHECK(cache->decoded() >= 1);
+            CHECK(cache->decoded() <= decoders);
+            CHECK(cache->queued() == count - cache->decoded());
+            CHECK(cache->decodedBytes() == cache->decoded() * imageBytes);
+
+            const size_t decoded = cache->decoded();
+            cache->dispatch();
+            cache->waitForDecodes();
+            CHECK(cache->decoded() == decoded);
+        }
+
+        SUBCASE("decodes_all") {
+            cache->setMaxPreloadDecodedBytes(count * imageBytes);
+            preload();
+            while (cache->queued() > 0) {
+                cache->waitForDecodes();
+                cache->dispatch();
+            }
+            cache->waitForDecodes();
+
+            CHECK(cache->decoded() == count);
+            CHECK(cache->decodedBytes() == count * imageBytes);
+        }
+
+        // drops the decoded images, the preload callback would upload them
+        Director::getInstance()->getScheduler()->unscheduleAllForTarget(cache);
+        cache->waitForQuit();
+        CHECK(cache->queued() == 0);
+        CHECK(cache->decoded() == 0);
+        cache->release();
+
+        for (auto&& path : paths)
+            fu->removeFile(path);
+    }
+}
@@ -0,0 +1,184 @@
+/****************************************************************************
+ Copyright (c) 2019-present Axmol Engine contributors (see AUTHORS.md).
+
+ https://axmol.dev/
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include <doctest.h>
+#include "ui/UIListView.h"
+
+USING_NS_AX;
+using ax::ui::ListView;
+using ax::ui::Widget;
+
+
+namespace {
+    // No stencil or scroll bar, they need a renderer
+    struct VirtualListView : public ListView {
+        static VirtualListView* create() {
+            auto listView = new VirtualListView();
+            listView->init();
+            listView->autorelease();
+            return listView;
+        }
+
+        VirtualListView() {
+            _clippingType = ClippingType::SCISSOR;
+            _scrollBarEnabled = false;
+        }
+
+        const std::vector<float>& offsets() const { return _virtualItemOffsets; }
+        ssize_t firstBound() const { return _boundItems.empty() ? -1 : _boundItems.begin()->first; }
+        ssize_t lastBound() const { return _boundItems.empty() ? -1 : _boundItems.rbegin()->first; }
+        size_t boundCount() const { return _boundItems.size(); }
+        int recycledCount() const { return static_cast<int>(_recycledItems.size()); }
+    };
+}
+
+
+TEST_SUITE("ui/ListView") {
+    TEST_CASE("data_source") {
+        const ssize_t count = 5000;
+        auto itemSize = [](ssize_t index) { return 20.0f + (index % 7) * 5.0f; };
+
+        int created = 0;
+        int bound = 0;
+        int unbound = 0;
+        std::map<Widget*, ssize_t> itemIndices;
+
+        auto listView = VirtualListView::create();
+        listView->setContentSize(Vec2(100, 200));
+        listView->setItemsMargin(2);
+        listView->setPadding(3, 4, 3, 5);
+
+        ListView::DataSource dataSource;
+        dataSource.getItemCount = [=]() { return count; };
+        dataSource.getItemSize = itemSize;
+        dataSource.createItem = [&]() {
+            ++created;
+            auto item = Widget::create();
+            item->ignoreContentAdaptWithSize(false);
+            return item;
+        };
+        dataSource.bindItem = [&](Widget* item, ssize_t index) {
+            ++bound;
+            CHECK(itemIndices.count(item) == 0);
+            itemIndices[item] = index;
+            item->setContentSize(Vec2(50, itemSize(index)));
+        };
+        dataSource.unbindItem = [&](Widget* item, ssize_t index) {
+            ++unbound;
+            CHECK(itemIndices[item] == index);
+            itemIndices.erase(item);
+        };
+        listView->setDataSource(std::move(dataSource));
+        REQUIRE(listView->isVirtualized());
+
+        listView->doLayout();
+
+        float length = 4 + 5 - 2;
+        for (ssize_t i = 0; i < count; ++i)
+            length += itemSize(i) + 2;
+        CHECK(listView->getInnerContainerSize().height == doctest::Approx(length));
+        CHECK(listView->getItems().empty());
+
+        // the items overlapping the view, from the distance of the view top to the inner container top
+        auto checkBoundRange = [&]() {
+            const auto& offsets = listView->offsets();
+            float top = listView->getInnerContainerPosition().y + length - 200;
+            ssize_t first = listView->firstBound();
+            ssize_t last = listView->lastBound();
+            REQUIRE(first >= 0);
+            CHECK(listView->boundCount() == static_cast<size_t>(last - first + 1));
+            CHECK((first == 0 || offsets[first] <= top + 0.01f));
+            CHECK(offsets[first + 1] > top - 0.01f);
+            CHECK(offsets[last] < top + 200 + 0.01f);
+            CHECK((last == count - 1 || offsets[last + 1] >= top + 200 - 0.01f));
+            CHECK(bound - unbound == static_cast<int>(listView->boundCount()));
+            // every widget created is either bound or waiting to be reused
+            CHECK(created == static_cast<int>(listView->boundCount()) + listView->recycledCount());
+        };
+
+        SUBCASE("item_offsets") {
+            const auto& offsets = listView->offsets();
+            REQUIRE(offsets.size() == static_cast<size_t>(count + 1));
+            CHECK(offsets[0] == doctest::Approx(4));
+            for (ssize_t i = 0; i < count; ++i)
+                CHECK(offsets[i + 1] - offsets[i] == doctest::Approx(itemSize(i) + 2));
+            CHECK(offsets[count] - 2 + 5 == doctest::Approx(length));
+        }
+
+        SUBCASE("binds_visible_items") {
+            CHECK(created > 0);
+            CHECK(created <= 10);
+            CHECK(listView->firstBound() == 0);
+            checkBoundRange();
+            CHECK(listView->getItem(0) != nullptr);
+            CHECK(listView->getIndex(listView->getItem(0)) == 0);
+            CHECK(listView->getItem(0)->getPosition().y == doctest::Approx(length - 4 - 10));
+            CHECK(listView->getItem(100) == nullptr);
+        }
+
+        SUBCASE("recycles_items") {
+            listView->jumpToItem(2500, Vec2::ANCHOR_MIDDLE_TOP, Vec2::ANCHOR_MIDDLE_TOP);
+            listView->doLayout();
+            CHECK(listView->getItem(0) == nullptr);
+            REQUIRE(listView->getItem(2500) != nullptr);
+            float itemTop = listView->getItem(2500)->getPosition().y + itemSize(2500) / 2;
+            CHECK(listView->getInnerContainerPosition().y + itemTop == doctest::Approx(200));
+            checkBoundRange();
+
+            listView->jumpToBottom();
+            listView->doLayout();
+            CHECK(listView->getItem(count - 1) != nullptr);
+            CHECK(listView->lastBound() == count - 1);
+            checkBoundRange();
+            CHECK(created <= 20);
+            CHECK(bound - unbound == static_cast<int>(itemIndices.size()));
+        }
+
+        SUBCASE("jumps_to_unbound_items") {
+            REQUIRE(listView->getItem(4000) == nullptr);
+            listView->jumpToItem(4000, Vec2::ANCHOR_MIDDLE_TOP, Vec2::ANCHOR_MIDDLE_TOP);
+            REQUIRE(listView->getItem(4000) != nullptr);
+            CHECK(listView->getIndex(listView->getItem(4000)) == 4000);
+            CHECK(itemIndices[listView->getItem(4000)] == 4000);
+            checkBoundRange();
+
+            // out of range, nothing moves
+            Vec2 position = listView->getInnerContainerPosition();
+            listView->jumpToItem(count, Vec2::ANCHOR_MIDDLE_TOP, Vec2::ANCHOR_MIDDLE_TOP);
+            listView->jumpToItem(-1, Vec2::ANCHOR_MIDDLE_TOP, Vec2::ANCHOR_MIDDLE_TOP);
+            CHECK(listView->getInnerContainerPosition() == position);
+            CHECK(listView->getItem(4000) != nullptr);
+        }
+
+        SUBCASE("reload_data") {
+            int boundBefore = bound;
+            listView->reloadData();
+            listView->doLayout();
+            CHECK(unbound == boundBefore);
+            CHECK(bound == boundBefore * 2);
+            CHECK(listView->recycledCount() == 0);
+            checkBoundRange();
+        }
+    }
+}